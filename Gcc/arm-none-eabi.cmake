@@ -0,0 +1,28 @@
+# GNU Arm Embedded toolchain for the STM32F100RB (Cortex-M3)
+#   cmake -S . -B build-arm -DCMAKE_TOOLCHAIN_FILE=Gcc/arm-none-eabi.cmake
+#         -DSHT85_CMSIS_DIR=<directory of stm32f10x.h and core_cm3.h>
+# the compiler is searched in PATH or in ARM_TOOLCHAIN_DIR/bin
+set(CMAKE_SYSTEM_NAME Generic)
+set(CMAKE_SYSTEM_PROCESSOR arm)
+
+set(ARM_TOOLCHAIN_DIR "" CACHE PATH "Installation directory of arm-none-eabi-gcc")
+if(ARM_TOOLCHAIN_DIR)
+  set(ARM_TOOLCHAIN_PREFIX "${ARM_TOOLCHAIN_DIR}/bin/arm-none-eabi-")
+else()
+  set(ARM_TOOLCHAIN_PREFIX "arm-none-eabi-")
+endif()
+
+set(CMAKE_C_COMPILER   "${ARM_TOOLCHAIN_PREFIX}gcc")
+set(CMAKE_ASM_COMPILER "${ARM_TOOLCHAIN_PREFIX}gcc")
+
+# no startup code and linker script for the compiler checks
+set(CMAKE_TRY_COMPILE_TARGET_TYPE STATIC_LIBRARY)
+
+set(CMAKE_C_FLAGS_INIT   "-mcpu=cortex-m3 -mthumb -ffunction-sections -fdata-sections")
+set(CMAKE_ASM_FLAGS_INIT "-mcpu=cortex-m3 -mthumb")
+set(CMAKE_EXE_LINKER_FLAGS_INIT
+    "-mcpu=cortex-m3 -mthumb --specs=nano.specs --specs=nosys.specs -Wl,--gc-sections")
+
+set(CMAKE_FIND_ROOT_PATH_MODE_PROGRAM NEVER)
+set(CMAKE_FIND_ROOT_PATH_MODE_LIBRARY ONLY)
+set(CMAKE_FIND_ROOT_PATH_MODE_INCLUDE ONLY)
@@ -0,0 +1,234 @@
+/* Startup of the STM32F100RB (medium density value line) for the GNU Arm
+ * toolchain, equivalent to Source/startup_stm32f10x_md_vl.s of the uVision
+ * project: vector table, data initialization, System_Init() and main().
+ * All handlers not defined by the application are weak aliases of
+ * Default_Handler, an endless loop. */
+
+  .syntax unified
+  .cpu cortex-m3
+  .thumb
+
+  .global __Vectors
+  .global Default_Handler
+
+/*----------------------------------------------------------------------------*/
+  .section .text.Reset_Handler,"ax",%progbits
+  .weak   Reset_Handler
+  .type   Reset_Handler, %function
+Reset_Handler:
+  /* copy the initialized data from flash to RAM */
+  ldr   r0, =_sdata
+  ldr   r1, =_edata
+  ldr   r2, =_sidata
+  b     2f
+1:
+  ldr   r3, [r2], #4
+  str   r3, [r0], #4
+2:
+  cmp   r0, r1
+  bcc   1b
+
+  /* clear the uninitialized data */
+  ldr   r0, =_sbss
+  ldr   r1, =_ebss
+  movs  r3, #0
+  b     4f
+3:
+  str   r3, [r0], #4
+4:
+  cmp   r0, r1
+  bcc   3b
+
+  /* system time base, then the application */
+  bl    System_Init
+  bl    main
+  b     .
+  .size Reset_Handler, .-Reset_Handler
+
+/*----------------------------------------------------------------------------*/
+  .section .text.Default_Handler,"ax",%progbits
+  .type   Default_Handler, %function
+Default_Handler:
+  b     .
+  .size Default_Handler, .-Default_Handler
+
+/*----------------------------------------------------------------------------*/
+/* vector table, mapped to address 0 at reset */
+  .section .isr_vector,"a",%progbits
+  .type   __Vectors, %object
+__Vectors:
+  .word _estack                         /* Top of Stack */
+  .word Reset_Handler                   /* Reset Handler */
+  .word NMI_Handler                     /* NMI Handler */
+  .word HardFault_Handler               /* Hard Fault Handler */
+  .word MemManage_Handler               /* MPU Fault Handler */
+  .word BusFault_Handler                /* Bus Fault Handler */
+  .word UsageFault_Handler              /* Usage Fault Handler */
+  .word 0                               /* Reserved */
+  .word 0                               /* Reserved */
+  .word 0                               /* Reserved */
+  .word 0                               /* Reserved */
+  .word SVC_Handler                     /* SVCall Handler */
+  .word DebugMon_Handler                /* Debug Monitor Handler */
+  .word 0                               /* Reserved */
+  .word PendSV_Handler                  /* PendSV Handler */
+  .word SysTick_Handler                 /* SysTick Handler */
+  .word WWDG_IRQHandler                 /* Window Watchdog */
+  .word PVD_IRQHandler                  /* PVD through EXTI Line detect */
+  .word TAMPER_IRQHandler               /* Tamper */
+  .word RTC_IRQHandler                  /* RTC */
+  .word FLASH_IRQHandler                /* Flash */
+  .word RCC_IRQHandler                  /* RCC */
+  .word EXTI0_IRQHandler                /* EXTI Line 0 */
+  .word EXTI1_IRQHandler                /* EXTI Line 1 */
+  .word EXTI2_IRQHandler                /* EXTI Line 2 */
+  .word EXTI3_IRQHandler                /* EXTI Line 3 */
+  .word EXTI4_IRQHandler                /* EXTI Line 4 */
+  .word DMA1_Channel1_IRQHandler        /* DMA1 Channel 1 */
+  .word DMA1_Channel2_IRQHandler        /* DMA1 Channel 2 */
+  .word DMA1_Channel3_IRQHandler        /* DMA1 Channel 3 */
+  .word DMA1_Channel4_IRQHandler        /* DMA1 Channel 4 */
+  .word DMA1_Channel5_IRQHandler        /* DMA1 Channel 5 */
+  .word DMA1_Channel6_IRQHandler        /* DMA1 Channel 6 */
+  .word DMA1_Channel7_IRQHandler        /* DMA1 Channel 7 */
+  .word ADC1_IRQHandler                 /* ADC1 */
+  .word 0                               /* Reserved */
+  .word 0                               /* Reserved */
+  .word 0                               /* Reserved */
+  .word 0                               /* Reserved */
+  .word EXTI9_5_IRQHandler              /* EXTI Line 9..5 */
+  .word TIM1_BRK_TIM15_IRQHandler       /* TIM1 Break and TIM15 */
+  .word TIM1_UP_TIM16_IRQHandler        /* TIM1 Update and TIM16 */
+  .word TIM1_TRG_COM_TIM17_IRQHandler   /* TIM1 Trigger and Commutation and TIM17 */
+  .word TIM1_CC_IRQHandler              /* TIM1 Capture Compare */
+  .word TIM2_IRQHandler                 /* TIM2 */
+  .word TIM3_IRQHandler                 /* TIM3 */
+  .word TIM4_IRQHandler                 /* TIM4 */
+  .word I2C1_EV_IRQHandler              /* I2C1 Event */
+  .word I2C1_ER_IRQHandler              /* I2C1 Error */
+  .word I2C2_EV_IRQHandler              /* I2C2 Event */
+  .word I2C2_ER_IRQHandler              /* I2C2 Error */
+  .word SPI1_IRQHandler                 /* SPI1 */
+  .word SPI2_IRQHandler                 /* SPI2 */
+  .word USART1_IRQHandler               /* USART1 */
+  .word USART2_IRQHandler               /* USART2 */
+  .word USART3_IRQHandler               /* USART3 */
+  .word EXTI15_10_IRQHandler            /* EXTI Line 15..10 */
+  .word RTCAlarm_IRQHandler             /* RTC Alarm through EXTI Line */
+  .word CEC_IRQHandler                  /* HDMI-CEC */
+  .word 0                               /* Reserved */
+  .word 0                               /* Reserved */
+  .word 0                               /* Reserved */
+  .word 0                               /* Reserved  */
+  .word 0                               /* Reserved */
+  .word 0                               /* Reserved */
+  .word 0                               /* Reserved */
+  .word 0                               /* Reserved  */
+  .word 0                               /* Reserved */
+  .word 0                               /* Reserved */
+  .word 0                               /* Reserved */
+  .word TIM6_DAC_IRQHandler             /* TIM6 and DAC underrun */
+  .word TIM7_IRQHandler                 /* TIM7 */
+  .size __Vectors, .-__Vectors
+
+/* weak handlers, replaced by the functions of the application */
+  .weak      NMI_Handler
+  .thumb_set NMI_Handler, Default_Handler
+  .weak      HardFault_Handler
+  .thumb_set HardFault_Handler, Default_Handler
+  .weak      MemManage_Handler
+  .thumb_set MemManage_Handler, Default_Handler
+  .weak      BusFault_Handler
+  .thumb_set BusFault_Handler, Default_Handler
+  .weak      UsageFault_Handler
+  .thumb_set UsageFault_Handler, Default_Handler
+  .weak      SVC_Handler
+  .thumb_set SVC_Handler, Default_Handler
+  .weak      DebugMon_Handler
+  .thumb_set DebugMon_Handler, Default_Handler
+  .weak      PendSV_Handler
+  .thumb_set PendSV_Handler, Default_Handler
+  .weak      SysTick_Handler
+  .thumb_set SysTick_Handler, Default_Handler
+  .weak      WWDG_IRQHandler
+  .thumb_set WWDG_IRQHandler, Default_Handler
+  .weak      PVD_IRQHandler
+  .thumb_set PVD_IRQHandler, Default_Handler
+  .weak      TAMPER_IRQHandler
+  .thumb_set TAMPER_IRQHandler, Default_Handler
+  .weak      RTC_IRQHandler
+  .thumb_set RTC_IRQHandler, Default_Handler
+  .weak      FLASH_IRQHandler
+  .thumb_set FLASH_IRQHandler, Default_Handler
+  .weak      RCC_IRQHandler
+  .thumb_set RCC_IRQHandler, Default_Handler
+  .weak      EXTI0_IRQHandler
+  .thumb_set EXTI0_IRQHandler, Default_Handler
+  .weak      EXTI1_IRQHandler
+  .thumb_set EXTI1_IRQHandler, Default_Handler
+  .weak      EXTI2_IRQHandler
+  .thumb_set EXTI2_IRQHandler, Default_Handler
+  .weak      EXTI3_IRQHandler
+  .thumb_set EXTI3_IRQHandler, Default_Handler
+  .weak      EXTI4_IRQHandler
+  .thumb_set EXTI4_IRQHandler, Default_Handler
+  .weak      DMA1_Channel1_IRQHandler
+  .thumb_set DMA1_Channel1_IRQHandler, Default_Handler
+  .weak      DMA1_Channel2_IRQHandler
+  .thumb_set DMA1_Channel2_IRQHandler, Default_Handler
+  .weak      DMA1_Channel3_IRQHandler
+  .thumb_set DMA1_Channel3_IRQHandler, Default_Handler
+  .weak      DMA1_Channel4_IRQHandler
+  .thumb_set DMA1_Channel4_IRQHandler, Default_Handler
+  .weak      DMA1_Channel5_IRQHandler
+  .thumb_set DMA1_Channel5_IRQHandler, Default_Handler
+  .weak      DMA1_Channel6_IRQHandler
+  .thumb_set DMA1_Channel6_IRQHandler, Default_Handler
+  .weak      DMA1_Channel7_IRQHandler
+  .thumb_set DMA1_Channel7_IRQHandler, Default_Handler
+  .weak      ADC1_IRQHandler
+  .thumb_set ADC1_IRQHandler, Default_Handler
+  .weak      EXTI9_5_IRQHandler
+  .thumb_set EXTI9_5_IRQHandler, Default_Handler
+  .weak      TIM1_BRK_TIM15_IRQHandler
+  .thumb_set TIM1_BRK_TIM15_IRQHandler, Default_Handler
+  .weak      TIM1_UP_TIM16_IRQHandler
+  .thumb_set TIM1_UP_TIM16_IRQHandler, Default_Handler
+  .weak      TIM1_TRG_COM_TIM17_IRQHandler
+  .thumb_set TIM1_TRG_COM_TIM17_IRQHandler, Default_Handler
+  .weak      TIM1_CC_IRQHandler
+  .thumb_set TIM1_CC_IRQHandler, Default_Handler
+  .weak      TIM2_IRQHandler
+  .thumb_set TIM2_IRQHandler, Default_Handler
+  .weak      TIM3_IRQHandler
+  .thumb_set TIM3_IRQHandler, Default_Handler
+  .weak      TIM4_IRQHandler
+  .thumb_set TIM4_IRQHandler, Default_Handler
+  .weak      I2C1_EV_IRQHandler
+  .thumb_set I2C1_EV_IRQHandler, Default_Handler
+  .weak      I2C1_ER_IRQHandler
+  .thumb_set I2C1_ER_IRQHandler, Default_Handler
+  .weak      I2C2_EV_IRQHandler
+  .thumb_set I2C2_EV_IRQHandler, Default_Handler
+  .weak      I2C2_ER_IRQHandler
+  .thumb_set I2C2_ER_IRQHandler, Default_Handler
+  .weak      SPI1_IRQHandler
+  .thumb_set SPI1_IRQHandler, Default_Handler
+  .weak      SPI2_IRQHandler
+  .thumb_set SPI2_IRQHandler, Default_Handler
+  .weak      USART1_IRQHandler
+  .thumb_set USART1_IRQHandler, Default_Handler
+  .weak      USART2_IRQHandler
+  .thumb_set USART2_IRQHandler, Default_Handler
+  .weak      USART3_IRQHandler
+  .thumb_set USART3_IRQHandler, Default_Handler
+  .weak      EXTI15_10_IRQHandler
+  .thumb_set EXTI15_10_IRQHandler, Default_Handler
+  .weak      RTCAlarm_IRQHandler
+  .thumb_set RTCAlarm_IRQHandler, Default_Handler
+  .weak      CEC_IRQHandler
+  .thumb_set CEC_IRQHandler, Default_Handler
+  .weak      TIM6_DAC_IRQHandler
+  .thumb_set TIM6_DAC_IRQHandler, Default_Handler
+  .weak      TIM7_IRQHandler
+  .thumb_set TIM7_IRQHandler, Default_Handler
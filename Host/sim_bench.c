@@ -0,0 +1,494 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  sim_bench.c
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  Host (Linux)
+// Compiler  :  GCC
+// Brief     :  Benchmarks of the driver hot paths against the simulated SHT85:
+//              single shot latency per repeatability, periodic fetch, CRC,
+//              conversion and multi-sensor scaling. Reports per iteration the
+//              simulated bus, CPU and elapsed time, which are deterministic,
+//              and the host time, which depends on the machine.
+//
+//              sht85_bench [-b baseline.json] [result.json]
+//              writes the results as JSON. With a baseline, e.g. the result
+//              of the last release, the exit code is 1 if a simulated bus or
+//              CPU time grew by more than BASELINE_TOLERANCE.
+//
+//              Built with BENCH_CRC_ONLY, sht85_bench_crc<size> runs only the
+//              CRC benchmark of the implementation of CRC_TABLE_SIZE.
+//==============================================================================
+
+#include "sht85.h"
+#include "sht85_stream.h"
+#include "sht85_derived.h"
+#include "sht85_alarm.h"
+#include "sim_bus.h"
+#include "sim_sht85.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define MAX_SENSORS         8        // SDA on port A bit 0..7, SCL on bit 8
+#define MAX_RESULTS         32
+#define NAME_SIZE           40
+#define SINGLE_SHOT_RUNS    100
+#define FETCH_RUNS          200
+#define STREAM_SECONDS      10
+#define CRC_WORDS           256      // words of the CRC input block
+#define CRC_RUNS            20000    // passes over the CRC input block
+#define CONVERSION_RUNS     100      // passes over all raw values
+#define BASELINE_TOLERANCE  0.01     // allowed relative increase
+#define BASELINE_MIN_US     0.001    // increase below is rounding
+
+// CRC benchmark of the implementation of CRC_TABLE_SIZE only
+#ifdef BENCH_CRC_ONLY
+  #define CRC_ONLY          true
+  #define CRC_ONLY_NAME     "crc_word_table" STRINGIFY(CRC_TABLE_SIZE)
+#else
+  #define CRC_ONLY          false
+  #define CRC_ONLY_NAME     "crc_word"
+#endif
+#define STRINGIFY(x)        STRINGIFY_(x)
+#define STRINGIFY_(x)       #x
+
+// Result of one benchmark, times per iteration
+typedef struct{
+  char     name[NAME_SIZE]; // benchmark name
+  uint32_t iterations;      // number of iterations
+  double   busUs;           // simulated time with a bus transfer [us]
+  double   cpuUs;           // simulated CPU busy time [us]
+  double   latencyUs;       // simulated time, without the pauses [us]
+  double   hostNs;          // host time incl. the simulation [ns]
+}tBenchResult;
+
+static tSimSht85    model[MAX_SENSORS];  // simulated sensors
+static tSht85       sensor[MAX_SENSORS]; // sensor instances
+static tI2cBus      bus[MAX_SENSORS];    // buses on port A
+static tSht85*      sensors[MAX_SENSORS];
+static tSht85Stream stream;              // 10Hz sample stream
+
+static tBenchResult results[MAX_RESULTS];
+static uint8_t      nbrOfResults;
+static uint64_t     startNs;             // simulated time at start [ns]
+static uint64_t     pausedNs;            // idle time of the pauses [ns]
+static clock_t      startClock;          // host time at start
+static volatile uint32_t sink;           // keeps the computation loops
+
+static void AllBenchmarks(void);
+static void SetUp(uint8_t nbrOfSensors, const tI2cTiming* timing);
+static void Pause(uint64_t ns);
+static void BenchBegin(void);
+static void BenchEnd(const char* name, uint32_t iterations);
+static void SingleShot(etSingleMeasureModes measureMode, bool async,
+                       const char* name);
+static void PeriodicFetch(const tI2cTiming* timing, const char* name);
+static void PeriodicStream(const char* name);
+static void Crc(const char* name);
+static void Conversion(const char* name);
+static void DewPoint(const char* name);
+static void Alarm(const char* name);
+static void Scaling(uint8_t nbrOfSensors, bool lockstep);
+static bool WriteJson(const char* fileName);
+static bool CompareBaseline(const char* fileName);
+
+//------------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  const char* baselineName = 0; // baseline to compare with
+  const char* resultName = 0;   // JSON output
+  bool        passed = true;    // no regression against the baseline
+  int         i;                // argument index
+
+  for(i = 1; i < argc; i++) {
+    if(strcmp(argv[i], "-b") == 0 && i + 1 < argc) {
+      baselineName = argv[++i];
+    } else {
+      resultName = argv[i];
+    }
+  }
+
+  printf("%-28s %10s %10s %10s %12s %10s\n", "benchmark", "iterations",
+         "bus [us]", "cpu [us]", "latency [us]", "host [ns]");
+
+  if(CRC_ONLY) {
+    Crc(CRC_ONLY_NAME);
+  } else {
+    AllBenchmarks();
+  }
+
+  if(resultName) {
+    passed = WriteJson(resultName);
+  }
+  if(baselineName) {
+    passed = CompareBaseline(baselineName) && passed;
+  }
+
+  return passed ? 0 : 1;
+}
+
+//------------------------------------------------------------------------------
+static void AllBenchmarks(void)
+{
+  uint8_t nbrOfSensors; // sensors of the scaling benchmark
+
+  // blocking single shot with clock stretching disabled (NACK polling) and
+  // the asynchronous single shot, which sleeps during the conversion
+  SingleShot(SINGLE_MEAS_HIGH,   false, "single_shot_high");
+  SingleShot(SINGLE_MEAS_MEDIUM, false, "single_shot_medium");
+  SingleShot(SINGLE_MEAS_LOW,    false, "single_shot_low");
+  SingleShot(SINGLE_MEAS_HIGH,   true,  "single_shot_async_high");
+  SingleShot(SINGLE_MEAS_MEDIUM, true,  "single_shot_async_medium");
+  SingleShot(SINGLE_MEAS_LOW,    true,  "single_shot_async_low");
+
+  // fetch of the periodic mode, blocking and by the stream interrupt
+  PeriodicFetch(&I2c_TimingStandard, "periodic_fetch_std");
+  PeriodicFetch(&I2c_TimingFast,     "periodic_fetch_fast");
+  PeriodicStream("periodic_stream_10hz");
+
+  // computation only, no bus access
+  Crc("crc_word");
+  Conversion("conversion_centi");
+  DewPoint("conversion_dew_point");
+  Alarm("alarm_check");
+
+  // one fetch of all sensors, one after the other and in lockstep
+  for(nbrOfSensors = 1; nbrOfSensors <= MAX_SENSORS; nbrOfSensors *= 2) {
+    Scaling(nbrOfSensors, false);
+  }
+  for(nbrOfSensors = 1; nbrOfSensors <= MAX_SENSORS; nbrOfSensors *= 2) {
+    Scaling(nbrOfSensors, true);
+  }
+}
+
+//------------------------------------------------------------------------------
+static void SetUp(uint8_t nbrOfSensors, const tI2cTiming* timing)
+{
+  uint8_t i; // sensor index
+
+  // sensors on port A, SDA on bit 0..7, common SCL on bit 8
+  Sim_Reset();
+  for(i = 0; i < nbrOfSensors; i++) {
+    bus[i].port   = GPIOA;
+    bus[i].sdaPin = (uint16_t)(1U << i);
+    bus[i].sclPin = 0x0100;
+    SimSht85_Init(&model[i], GPIOA, bus[i].sdaPin, bus[i].sclPin);
+    SimSht85_SetEnvironment(&model[i], 20.0f + i, 40.0f + i);
+    SHT85_Init(&sensor[i], &bus[i], SHT85_I2C_ADDR);
+    sensors[i] = &sensor[i];
+  }
+  I2c_SetTiming(timing);
+
+  // power-up time
+  Sim_IdleNs(50000000);
+}
+
+//------------------------------------------------------------------------------
+static void Pause(uint64_t ns)
+{
+  uint64_t idleNs = Sim_GetStats().idleNs; // idle time before the pause
+
+  // interrupts during the pause count as busy time
+  Sim_IdleNs(ns);
+  pausedNs += Sim_GetStats().idleNs - idleNs;
+}
+
+//------------------------------------------------------------------------------
+static void BenchBegin(void)
+{
+  Sim_ResetStats();
+  startNs    = Sim_GetTimeNs();
+  pausedNs   = 0;
+  startClock = clock();
+}
+
+//------------------------------------------------------------------------------
+static void BenchEnd(const char* name, uint32_t iterations)
+{
+  clock_t       endClock = clock();       // host time at the end
+  tSimStats     stats    = Sim_GetStats(); // simulator statistics
+  tBenchResult* result;                   // result of the benchmark
+
+  if(nbrOfResults >= MAX_RESULTS) return;
+  result = &results[nbrOfResults++];
+
+  snprintf(result->name, sizeof(result->name), "%s", name);
+  result->iterations = iterations;
+  result->busUs      = stats.busNs / 1000.0 / iterations;
+  result->cpuUs      = stats.cpuNs / 1000.0 / iterations;
+  result->latencyUs  = (stats.timeNs - startNs - pausedNs) / 1000.0 /
+                       iterations;
+  result->hostNs     = (double)(endClock - startClock) * 1e9 /
+                       CLOCKS_PER_SEC / iterations;
+
+  printf("%-28s %10u %10.1f %10.1f %12.1f %10.1f\n", result->name,
+         (unsigned)iterations, result->busUs, result->cpuUs,
+         result->latencyUs, result->hostNs);
+}
+
+//------------------------------------------------------------------------------
+static void SingleShot(etSingleMeasureModes measureMode, bool async,
+                       const char* name)
+{
+  float   temperature; // temperature [°C]
+  float   humidity;    // relative humidity [%RH]
+  uint8_t i;           // iteration
+
+  SetUp(1, &I2c_TimingStandard);
+
+  BenchBegin();
+  for(i = 0; i < SINGLE_SHOT_RUNS; i++) {
+    if(async) {
+      SHT85_StartMeasurementAsync(&sensor[0], measureMode, 0);
+      while(SHT85_ProcessAsync(&sensor[0])) {
+        Sim_IdleNs(1000000);
+      }
+    } else {
+      SHT85_SingleMeasurment(&sensor[0], &temperature, &humidity,
+                             measureMode, 50);
+    }
+  }
+  BenchEnd(name, SINGLE_SHOT_RUNS);
+}
+
+//------------------------------------------------------------------------------
+static void PeriodicFetch(const tI2cTiming* timing, const char* name)
+{
+  float   temperature; // temperature [°C]
+  float   humidity;    // relative humidity [%RH]
+  uint8_t i;           // iteration
+
+  SetUp(1, timing);
+  SHT85_StartPeriodicMeasurment(&sensor[0], PERI_MEAS_HIGH_10_HZ);
+
+  BenchBegin();
+  for(i = 0; i < FETCH_RUNS; i++) {
+    Pause(100000000);
+    SHT85_ReadMeasurementBuffer(&sensor[0], &temperature, &humidity);
+  }
+  BenchEnd(name, FETCH_RUNS);
+}
+
+//------------------------------------------------------------------------------
+static void PeriodicStream(const char* name)
+{
+  tSht85Sample samples[SHT85_STREAM_SIZE]; // samples read from the stream
+  uint32_t     nbrOfSamples = 0;           // samples of all reads
+  uint8_t      nbrOfRead;                  // samples of one read
+  uint8_t      i;                          // second
+
+  SetUp(1, &I2c_TimingStandard);
+  SHT85_StreamInit(&stream, &sensor[0]);
+
+  // the fetches run in the timer interrupt during the pauses
+  BenchBegin();
+  SHT85_StreamStart(&stream, PERI_MEAS_HIGH_10_HZ);
+  for(i = 0; i < STREAM_SECONDS; i++) {
+    Pause(1000000000);
+    SHT85_StreamRead(&stream, samples, SHT85_STREAM_SIZE, &nbrOfRead);
+    nbrOfSamples += nbrOfRead;
+  }
+  SHT85_StreamStop(&stream);
+  BenchEnd(name, nbrOfSamples ? nbrOfSamples : 1);
+}
+
+//------------------------------------------------------------------------------
+static void Crc(const char* name)
+{
+  static uint8_t data[CRC_WORDS][2]; // CRC input block
+  uint32_t       seed = 1;           // pseudo random data
+  uint32_t       run;                // pass over the block
+  uint16_t       i;                  // word index
+
+  for(i = 0; i < CRC_WORDS; i++) {
+    seed = seed * 1103515245 + 12345;
+    data[i][0] = (uint8_t)(seed >> 16);
+    data[i][1] = (uint8_t)(seed >> 24);
+  }
+
+  // one word as in a frame of the sensor
+  BenchBegin();
+  for(run = 0; run < CRC_RUNS; run++) {
+    for(i = 0; i < CRC_WORDS; i++) {
+      sink += SHT85_CalcCrc(data[i], 2);
+    }
+  }
+  BenchEnd(name, CRC_RUNS * CRC_WORDS);
+}
+
+//------------------------------------------------------------------------------
+static void Conversion(const char* name)
+{
+  uint32_t rawValue; // raw value
+  uint32_t run;      // pass over all raw values
+
+  // temperature and humidity of one sample
+  BenchBegin();
+  for(run = 0; run < CONVERSION_RUNS; run++) {
+    for(rawValue = 0; rawValue <= 0xFFFF; rawValue++) {
+      sink += (uint32_t)SHT85_CalcTemperatureCenti((uint16_t)rawValue) +
+              SHT85_CalcHumidityCenti((uint16_t)(rawValue ^ 0x5555));
+    }
+  }
+  BenchEnd(name, CONVERSION_RUNS * 0x10000);
+}
+
+//------------------------------------------------------------------------------
+static void DewPoint(const char* name)
+{
+  uint32_t rawValue; // raw value
+  uint32_t run;      // pass over all raw values
+
+  // temperature -45..65°C, humidity from 1.6%RH
+  BenchBegin();
+  for(run = 0; run < CONVERSION_RUNS / 10; run++) {
+    for(rawValue = 0; rawValue <= 0xFFFF; rawValue++) {
+      sink += (uint32_t)SHT85_CalcDewPointCenti((uint16_t)(rawValue >> 1),
+                                                (uint16_t)(rawValue | 0x0400));
+    }
+  }
+  BenchEnd(name, CONVERSION_RUNS / 10 * 0x10000);
+}
+
+//------------------------------------------------------------------------------
+static void Alarm(const char* name)
+{
+  static tSht85Alarm alarm; // alarms of one sensor
+  tSht85Sample sample;      // checked sample
+  uint32_t     rawValue;    // raw value
+  uint32_t     run;         // pass over all raw values
+
+  // all limits with hysteresis, rate limits on both quantities; the
+  // humidity sweeps across its limits, the temperature stays in range
+  SHT85_AlarmInit(&alarm, 0, 0);
+  SHT85_AlarmSetLimits(&alarm, false, SHT85_TEMPERATURE_TO_RAW(0),
+                       SHT85_TEMPERATURE_TO_RAW(40),
+                       SHT85_TEMPERATURE_DIFF_TO_RAW(0.5),
+                       SHT85_TEMPERATURE_DIFF_TO_RAW(1));
+  SHT85_AlarmSetLimits(&alarm, true, SHT85_HUMIDITY_TO_RAW(20),
+                       SHT85_HUMIDITY_TO_RAW(80), SHT85_HUMIDITY_TO_RAW(1),
+                       SHT85_HUMIDITY_TO_RAW(5));
+  sample.timeMs  = 0;
+  sample.rawTemp = SHT85_TEMPERATURE_TO_RAW(23);
+
+  BenchBegin();
+  for(run = 0; run < CONVERSION_RUNS; run++) {
+    for(rawValue = 0; rawValue <= 0xFFFF; rawValue++) {
+      sample.rawHumi = (uint16_t)rawValue;
+      sink += SHT85_AlarmCheck(&alarm, &sample);
+    }
+  }
+  BenchEnd(name, CONVERSION_RUNS * 0x10000);
+}
+
+//------------------------------------------------------------------------------
+static void Scaling(uint8_t nbrOfSensors, bool lockstep)
+{
+  float   temperatures[MAX_SENSORS]; // temperatures [°C]
+  float   humidities[MAX_SENSORS];   // relative humidities [%RH]
+  etError errors[MAX_SENSORS];       // error codes
+  char    name[NAME_SIZE];           // benchmark name
+  uint8_t i;                         // iteration
+  uint8_t j;                         // sensor index
+
+  SetUp(nbrOfSensors, &I2c_TimingStandard);
+  for(j = 0; j < nbrOfSensors; j++) {
+    SHT85_StartPeriodicMeasurment(&sensor[j], PERI_MEAS_HIGH_10_HZ);
+  }
+
+  BenchBegin();
+  for(i = 0; i < FETCH_RUNS; i++) {
+    Pause(100000000);
+    if(lockstep) {
+      SHT85_ReadMeasurementBuffers(sensors, nbrOfSensors, temperatures,
+                                   humidities, errors);
+    } else {
+      for(j = 0; j < nbrOfSensors; j++) {
+        SHT85_ReadMeasurementBuffer(&sensor[j], &temperatures[j],
+                                    &humidities[j]);
+      }
+    }
+  }
+  snprintf(name, sizeof(name), "scaling_%s_%u",
+           lockstep ? "lockstep" : "sequential", nbrOfSensors);
+  BenchEnd(name, FETCH_RUNS);
+}
+
+//------------------------------------------------------------------------------
+static bool WriteJson(const char* fileName)
+{
+  FILE*         file = fopen(fileName, "w"); // JSON output
+  tBenchResult* result;                     // result of a benchmark
+  uint8_t       i;                          // result index
+
+  if(file == 0) {
+    fprintf(stderr, "cannot write %s\n", fileName);
+    return false;
+  }
+
+  // one benchmark per line, read back by CompareBaseline()
+  fprintf(file, "{\n  \"benchmarks\": [\n");
+  for(i = 0; i < nbrOfResults; i++) {
+    result = &results[i];
+    fprintf(file, "    {\"name\": \"%s\", \"iterations\": %u, "
+            "\"bus_us\": %.3f, \"cpu_us\": %.3f, \"latency_us\": %.3f, "
+            "\"host_ns\": %.3f}%s\n", result->name,
+            (unsigned)result->iterations, result->busUs, result->cpuUs,
+            result->latencyUs, result->hostNs,
+            (i + 1 < nbrOfResults) ? "," : "");
+  }
+  fprintf(file, "  ]\n}\n");
+  fclose(file);
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+static bool CompareBaseline(const char* fileName)
+{
+  FILE*         file = fopen(fileName, "r"); // baseline JSON
+  char          line[256];                  // line of the baseline
+  char          name[NAME_SIZE];            // benchmark name
+  unsigned      iterations;                 // baseline iterations
+  double        busUs;                      // baseline bus time [us]
+  double        cpuUs;                      // baseline CPU time [us]
+  tBenchResult* result;                     // result of the benchmark
+  uint32_t      compared = 0;               // compared benchmarks
+  uint32_t      regressions = 0;            // benchmarks above the baseline
+  uint8_t       i;                          // result index
+
+  if(file == 0) {
+    fprintf(stderr, "cannot read %s\n", fileName);
+    return false;
+  }
+
+  // only the simulated times, the host time differs between machines
+  while(fgets(line, sizeof(line), file)) {
+    if(sscanf(line, " {\"name\": \"%39[^\"]\", \"iterations\": %u, "
+              "\"bus_us\": %lf, \"cpu_us\": %lf", name, &iterations, &busUs,
+              &cpuUs) != 4) {
+      continue;
+    }
+    for(i = 0; i < nbrOfResults; i++) {
+      result = &results[i];
+      if(strcmp(result->name, name) != 0) continue;
+
+      compared++;
+      if(result->busUs > busUs * (1 + BASELINE_TOLERANCE) + BASELINE_MIN_US ||
+         result->cpuUs > cpuUs * (1 + BASELINE_TOLERANCE) + BASELINE_MIN_US) {
+        printf("regression %s: bus %.3f -> %.3f us, cpu %.3f -> %.3f us\n",
+               name, busUs, result->busUs, cpuUs, result->cpuUs);
+        regressions++;
+      }
+    }
+  }
+  fclose(file);
+
+  printf("\nbaseline %s: %u benchmarks compared, %u regressions\n", fileName,
+         (unsigned)compared, (unsigned)regressions);
+
+  return regressions == 0;
+}
@@ -0,0 +1,443 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  sim_bus.c
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  Host (Linux)
+// Compiler  :  GCC
+// Brief     :  Simulator core
+//==============================================================================
+
+#include "sim_bus.h"
+#include <string.h>
+
+#define NBR_OF_PORTS  5
+
+// default cost model: 8MHz core, delays timed by the DWT cycle counter
+#define DEFAULT_PORT_ACCESS_NS   250 // 2 cycles
+#define DEFAULT_DELAY_CALL_NS   1000 // call overhead of System_DelayUs()
+#define DEFAULT_DELAY_US_NS     1000 // one requested microsecond
+#define SYSTICK_NS           1000000 // SysTick interrupt period
+#define DELAY_NS_LOOP_NS         375 // polling loop of inline System_DelayNs()
+#define TIMER_WRAP           0x10000 // timer counter range
+#define TIMER_STOPPED     UINT64_MAX // no update event, auto-reload value 0
+
+GPIO_TypeDef SimGpio[NBR_OF_PORTS];
+RCC_TypeDef  SimRcc;
+
+static tSimDevice* devices[SIM_MAX_DEVICES]; // attached devices
+static uint8_t     nbrOfDevices;             // number of attached devices
+static uint8_t     transfers;                // devices within a transfer
+static uint64_t    timeNs;                   // simulated time
+static tSimStats   stats;                    // statistics
+static uint32_t    portAccessNs = DEFAULT_PORT_ACCESS_NS;
+static uint32_t    delayCallNs  = DEFAULT_DELAY_CALL_NS;
+static uint32_t    delayPerUsNs = DEFAULT_DELAY_US_NS;
+static void      (*timerHandler)(void);      // timer interrupt handler
+static uint32_t    timerTickNs;              // timer counter tick
+static uint16_t    timerReload;              // timer auto-reload value
+static uint16_t    timerFrozen;              // counter stopped at reload 0
+static uint64_t    timerStartNs;             // time of the counter value 0
+static uint64_t    timerNextNs;              // time of the next interrupt
+static bool        inInterrupt;              // interrupt handler is running
+static void      (*uartHandler)(void);       // UART transfer complete handler
+static uint64_t    uartDoneNs;               // end of the UART transfer
+static uint64_t    uartByteNs;               // UART time per byte
+static FILE*       uartOutput;               // UART output file
+
+static void     Advance(uint64_t ns);
+static void     TimerSchedule(void);
+static uint64_t RunInterrupts(uint64_t ns, uint64_t* accountNs);
+static uint32_t LineLevels(GPIO_TypeDef* port);
+
+//------------------------------------------------------------------------------
+void Sim_Reset(void)
+{
+  uint8_t i;
+
+  memset(SimGpio, 0, sizeof(SimGpio));
+  memset(&SimRcc, 0, sizeof(SimRcc));
+
+  // released lines are pulled up
+  for(i = 0; i < NBR_OF_PORTS; i++) {
+    SimGpio[i].ODR = 0xFFFF;
+    SimGpio[i].IDR = 0xFFFF;
+  }
+
+  nbrOfDevices = 0;
+  transfers    = 0;
+  timeNs       = 0;
+  portAccessNs = DEFAULT_PORT_ACCESS_NS;
+  delayCallNs  = DEFAULT_DELAY_CALL_NS;
+  delayPerUsNs = DEFAULT_DELAY_US_NS;
+  timerHandler = 0;
+  inInterrupt  = false;
+  uartHandler  = 0;
+  uartOutput   = 0;
+  Sim_ResetStats();
+}
+
+//------------------------------------------------------------------------------
+void Sim_Attach(tSimDevice* device)
+{
+  uint32_t levels = LineLevels(device->port);
+
+  if(nbrOfDevices >= SIM_MAX_DEVICES) return;
+
+  device->sda        = (levels & device->sdaPin) != 0;
+  device->scl        = (levels & device->sclPin) != 0;
+  device->inTransfer = false;
+  devices[nbrOfDevices++] = device;
+}
+
+//------------------------------------------------------------------------------
+void Sim_Update(GPIO_TypeDef* port)
+{
+  uint32_t    levels;  // line levels of the port
+  bool        changed; // a device changed its outputs
+  bool        sda;     // SDA level seen by a device
+  bool        scl;     // SCL level seen by a device
+  uint8_t     i;       // device index
+  uint8_t     loops;   // propagation loop counter
+  tSimDevice* dev;     // device
+
+  // propagate until no device reacts on a change anymore
+  for(loops = 0; loops < 16; loops++) {
+    changed = false;
+    levels  = LineLevels(port);
+    port->IDR = levels;
+
+    for(i = 0; i < nbrOfDevices; i++) {
+      dev = devices[i];
+      if(dev->port != port) continue;
+
+      sda = (levels & dev->sdaPin) != 0;
+      scl = (levels & dev->sclPin) != 0;
+      if(sda == dev->sda && scl == dev->scl) continue;
+
+      changed = true;
+      if(scl == dev->scl) {
+        // SDA change while SCL is high: start or stop condition
+        dev->sda = sda;
+        if(!scl) continue;
+        if(!sda) {
+          stats.starts++;
+          if(!dev->inTransfer) transfers++;
+          dev->inTransfer = true;
+          dev->event(dev, SIM_START, sda);
+        } else {
+          stats.stops++;
+          if(dev->inTransfer) transfers--;
+          dev->inTransfer = false;
+          dev->event(dev, SIM_STOP, sda);
+        }
+      } else {
+        dev->sda = sda;
+        dev->scl = scl;
+        dev->event(dev, scl ? SIM_SCL_RISE : SIM_SCL_FALL, sda);
+      }
+    }
+
+    if(!changed) break;
+  }
+}
+
+//------------------------------------------------------------------------------
+void SimGpio_WriteBsrr(GPIO_TypeDef* port, uint32_t value)
+{
+  Advance(portAccessNs);
+  stats.cpuNs += portAccessNs;
+  stats.portWrites++;
+
+  port->ODR |=  (value & 0xFFFF);
+  port->ODR &= ~(value >> 16);
+  port->BSRR = value;
+
+  Sim_Update(port);
+}
+
+//------------------------------------------------------------------------------
+uint32_t SimGpio_ReadIdr(GPIO_TypeDef* port)
+{
+  Advance(portAccessNs);
+  stats.cpuNs += portAccessNs;
+  stats.portReads++;
+
+  port->IDR = LineLevels(port);
+
+  return port->IDR;
+}
+
+//------------------------------------------------------------------------------
+void Sim_CpuNs(uint64_t ns)
+{
+  ns = RunInterrupts(ns, &stats.cpuNs);
+  Advance(ns);
+  stats.cpuNs += ns;
+}
+
+//------------------------------------------------------------------------------
+void Sim_IdleNs(uint64_t ns)
+{
+  ns = RunInterrupts(ns, &stats.idleNs);
+  Advance(ns);
+  stats.idleNs += ns;
+}
+
+//------------------------------------------------------------------------------
+void Sim_StopNs(uint64_t ns)
+{
+  // timer and DMA are frozen, their next interrupt moves by the stop time
+  timerStartNs += ns;
+  if(timerNextNs != TIMER_STOPPED) {
+    timerNextNs += ns;
+  }
+  uartDoneNs   += ns;
+  Advance(ns);
+  stats.stopNs += ns;
+}
+
+//------------------------------------------------------------------------------
+void Sim_StartTimer(uint32_t tickNs, uint16_t reload, void (*handler)(void))
+{
+  timerTickNs  = tickNs;
+  timerReload  = reload;
+  timerFrozen  = 0;
+  timerStartNs = timeNs;
+  timerHandler = handler;
+  TimerSchedule();
+}
+
+//------------------------------------------------------------------------------
+void Sim_SetTimerReload(uint16_t reload)
+{
+  uint64_t wrapNs = (uint64_t)TIMER_WRAP * timerTickNs; // counter range [ns]
+  uint16_t count  = Sim_GetTimerCount();                // counter value
+
+  // a pending update event starts the next cycle with the new value
+  if(timerNextNs != TIMER_STOPPED && timeNs >= timerNextNs) {
+    timerReload = reload;
+    return;
+  }
+
+  // a stopped counter continues at its value, a wrapped one from 0
+  if(timerReload == 0) {
+    timerStartNs = timeNs - (uint64_t)count * timerTickNs;
+  } else {
+    timerStartNs += (timeNs - timerStartNs) / wrapNs * wrapNs;
+  }
+
+  timerReload = reload;
+  timerFrozen = count;
+  TimerSchedule();
+}
+
+//------------------------------------------------------------------------------
+uint16_t Sim_GetTimerCount(void)
+{
+  uint64_t startNs = timerStartNs; // time of the counter value 0
+
+  if(timerReload == 0) {
+    return timerFrozen;
+  }
+
+  // the counter restarts at a pending update event
+  if(timerNextNs != TIMER_STOPPED && timeNs >= timerNextNs) {
+    startNs = timerNextNs;
+  }
+
+  return (uint16_t)((timeNs - startNs) / timerTickNs);
+}
+
+//------------------------------------------------------------------------------
+void Sim_TimerUpdate(void)
+{
+  timerStartNs = timeNs;
+  timerNextNs  = timeNs;
+}
+
+//------------------------------------------------------------------------------
+void Sim_StopTimer(void)
+{
+  timerHandler = 0;
+}
+
+//------------------------------------------------------------------------------
+void Sim_InitUart(uint64_t byteNs)
+{
+  uartByteNs  = byteNs;
+  uartHandler = 0;
+}
+
+//------------------------------------------------------------------------------
+void Sim_SetUartOutput(FILE* file)
+{
+  uartOutput = file;
+}
+
+//------------------------------------------------------------------------------
+void Sim_UartSend(const uint8_t data[], uint16_t size, void (*handler)(void))
+{
+  // the block is written out at once, the DMA interrupt follows after the
+  // transmission time
+  if(uartOutput) {
+    fwrite(data, 1, size, uartOutput);
+  }
+
+  stats.uartBytes += size;
+  uartDoneNs  = timeNs + size * uartByteNs;
+  uartHandler = handler;
+}
+
+//------------------------------------------------------------------------------
+void Sim_WaitForInterrupt(void)
+{
+  uint64_t wakeNs = (timeNs / SYSTICK_NS + 1) * SYSTICK_NS; // next SysTick
+
+  if(timerHandler && timerNextNs < wakeNs) {
+    wakeNs = timerNextNs;
+  }
+
+  if(uartHandler && uartDoneNs < wakeNs) {
+    wakeNs = uartDoneNs;
+  }
+
+  // a pending interrupt does not let the controller sleep
+  if(wakeNs > timeNs) {
+    Sim_IdleNs(wakeNs - timeNs);
+  }
+}
+
+//------------------------------------------------------------------------------
+uint64_t Sim_GetTimeNs(void)
+{
+  return timeNs;
+}
+
+//------------------------------------------------------------------------------
+void Sim_SetCostModel(uint32_t portAccess, uint32_t delayCall,
+                      uint32_t delayPerUs)
+{
+  portAccessNs = portAccess;
+  delayCallNs  = delayCall;
+  delayPerUsNs = delayPerUs;
+}
+
+//------------------------------------------------------------------------------
+void Sim_DelayUs(uint32_t nbrOfUs)
+{
+  Sim_CpuNs(delayCallNs + (uint64_t)nbrOfUs * delayPerUsNs);
+}
+
+//------------------------------------------------------------------------------
+void Sim_DelayNs(uint32_t nbrOfNs)
+{
+  Sim_CpuNs(DELAY_NS_LOOP_NS + ((uint64_t)nbrOfNs * delayPerUsNs + 999) / 1000);
+}
+
+//------------------------------------------------------------------------------
+void Sim_ResetStats(void)
+{
+  memset(&stats, 0, sizeof(stats));
+}
+
+//------------------------------------------------------------------------------
+tSimStats Sim_GetStats(void)
+{
+  tSimStats result = stats;
+
+  result.timeNs = timeNs;
+
+  return result;
+}
+
+//------------------------------------------------------------------------------
+static void Advance(uint64_t ns)
+{
+  timeNs += ns;
+
+  if(transfers > 0) {
+    stats.busNs += ns;
+  }
+}
+
+//------------------------------------------------------------------------------
+static void TimerSchedule(void)
+{
+  uint64_t count; // counter value
+
+  // the counter is blocked at an auto-reload value of 0
+  if(timerReload == 0) {
+    timerNextNs = TIMER_STOPPED;
+    return;
+  }
+
+  // the update event follows the tick at the auto-reload value, a counter
+  // beyond it counts up to 65535 and wraps around first
+  count       = (timeNs - timerStartNs) / timerTickNs;
+  timerNextNs = timerStartNs + ((count > timerReload ? TIMER_WRAP : 0) +
+                                timerReload + 1) * (uint64_t)timerTickNs;
+}
+
+//------------------------------------------------------------------------------
+static uint64_t RunInterrupts(uint64_t ns, uint64_t* accountNs)
+{
+  uint64_t endNs = timeNs + ns; // end of the time step
+  uint64_t stepNs;              // time up to the interrupt
+  uint64_t eventNs;             // time of the next interrupt
+  bool     uart;                // next interrupt is the UART one
+  void   (*handler)(void);      // handler of the next interrupt
+
+  // the timer interrupts the time step at every period boundary, the UART at
+  // the end of a transfer; the handler time is accounted by the handler
+  while(!inInterrupt && (timerHandler || uartHandler)) {
+    uart    = uartHandler && (!timerHandler || uartDoneNs < timerNextNs);
+    eventNs = uart ? uartDoneNs : timerNextNs;
+    if(eventNs > endNs) break;
+
+    // a handler running longer than the period leaves the next one pending
+    if(eventNs > timeNs) {
+      stepNs = eventNs - timeNs;
+      Advance(stepNs);
+      *accountNs += stepNs;
+    }
+
+    // the UART handler may start the next transfer
+    if(uart) {
+      handler     = uartHandler;
+      uartHandler = 0;
+    } else {
+      handler      = timerHandler;
+      timerStartNs = timerNextNs;
+      timerFrozen  = 0;
+      timerNextNs  = (timerReload == 0) ? TIMER_STOPPED : timerStartNs +
+                     (timerReload + 1) * (uint64_t)timerTickNs;
+    }
+    stats.interrupts++;
+    inInterrupt = true;
+    handler();
+    inInterrupt = false;
+    if(timeNs >= endNs) return 0;
+  }
+
+  // remaining time of the step
+  return endNs - timeNs;
+}
+
+//------------------------------------------------------------------------------
+static uint32_t LineLevels(GPIO_TypeDef* port)
+{
+  uint32_t levels = port->ODR & 0xFFFF; // released pins are pulled up
+  uint8_t  i;                           // device index
+
+  // open-drain: every device can pull a line low
+  for(i = 0; i < nbrOfDevices; i++) {
+    if(devices[i]->port != port) continue;
+    if(devices[i]->sdaLow) levels &= ~(uint32_t)devices[i]->sdaPin;
+    if(devices[i]->sclLow) levels &= ~(uint32_t)devices[i]->sclPin;
+  }
+
+  return levels;
+}
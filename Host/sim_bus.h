@@ -0,0 +1,213 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  sim_bus.h
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  Host (Linux)
+// Compiler  :  GCC
+// Brief     :  Simulator core: simulated time with CPU/bus time accounting and
+//              a bit-level model of open-drain I2C lines on the GPIO ports.
+//==============================================================================
+
+#ifndef SIM_BUS_H
+#define SIM_BUS_H
+
+#include "stm32f10x.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#define SIM_MAX_DEVICES  32 // max. number of devices on all buses
+
+// Bus events seen by a device
+typedef enum{
+  SIM_START,    // start condition (also repeated start)
+  SIM_STOP,     // stop condition
+  SIM_SCL_RISE, // rising edge on SCL, sda = level of SDA
+  SIM_SCL_FALL, // falling edge on SCL
+}etSimEvent;
+
+typedef struct sSimDevice tSimDevice;
+
+// Device on a simulated bus
+struct sSimDevice{
+  GPIO_TypeDef* port;       // port of SDA and SCL
+  uint16_t      sdaPin;     // SDA pin mask
+  uint16_t      sclPin;     // SCL pin mask
+  bool          sdaLow;     // device pulls SDA low
+  bool          sclLow;     // device pulls SCL low (clock stretching)
+  void        (*event)(tSimDevice* device, etSimEvent event, bool sda);
+  // maintained by the simulator core
+  bool          sda;        // last seen SDA level
+  bool          scl;        // last seen SCL level
+  bool          inTransfer; // between start and stop condition
+};
+
+// Simulator statistics
+typedef struct{
+  uint64_t timeNs;     // simulated time
+  uint64_t cpuNs;      // CPU busy time: port accesses and delays
+  uint64_t idleNs;     // CPU idle time: Sim_IdleNs()
+  uint64_t stopNs;     // controller in Stop mode: Sim_StopNs()
+  uint64_t busNs;      // time with a transfer in progress on any bus
+  uint32_t portWrites; // number of SDA/SCL port writes
+  uint32_t portReads;  // number of SDA/SCL port reads
+  uint32_t starts;     // number of start conditions seen by devices
+  uint32_t stops;      // number of stop conditions seen by devices
+  uint32_t interrupts; // number of timer and UART interrupts
+  uint32_t uartBytes;  // number of bytes sent by the UART
+}tSimStats;
+
+//==============================================================================
+void Sim_Reset(void);
+//==============================================================================
+// Resets time, statistics and ports and detaches all devices.
+//------------------------------------------------------------------------------
+
+//==============================================================================
+void Sim_Attach(tSimDevice* device);
+//==============================================================================
+// Attaches a device to the lines given in its descriptor.
+//------------------------------------------------------------------------------
+
+//==============================================================================
+void Sim_Update(GPIO_TypeDef* port);
+//==============================================================================
+// Propagates the line levels of a port to its devices, call after a device
+// changed its outputs outside of an event.
+//------------------------------------------------------------------------------
+
+//==============================================================================
+void Sim_CpuNs(uint64_t ns);
+//==============================================================================
+// Advances the simulated time by CPU busy time.
+//------------------------------------------------------------------------------
+
+//==============================================================================
+void Sim_IdleNs(uint64_t ns);
+//==============================================================================
+// Advances the simulated time by CPU idle (sleep) time.
+//------------------------------------------------------------------------------
+
+//==============================================================================
+void Sim_StopNs(uint64_t ns);
+//==============================================================================
+// Advances the simulated time in Stop mode: all clocks are stopped, the timer
+// interrupt does not count during this time.
+//------------------------------------------------------------------------------
+
+//==============================================================================
+void Sim_StartTimer(uint32_t tickNs, uint16_t reload, void (*handler)(void));
+//==============================================================================
+// Starts the simulated periodic timer interrupt. The timer is an up-counter
+// as TIM2: it counts from 0 to the auto-reload value, the update event at the
+// overflow calls the handler when the time advances past it in Sim_CpuNs() or
+// Sim_IdleNs(). At an auto-reload value of 0 the counter stops.
+//------------------------------------------------------------------------------
+// input:  tickNs    counter tick [ns]
+//         reload    auto-reload value, the period is reload + 1 ticks
+//         handler   interrupt handler
+
+//==============================================================================
+void Sim_SetTimerReload(uint16_t reload);
+//==============================================================================
+// Changes the auto-reload value of the running cycle. A counter beyond the new
+// value counts up to 65535 and wraps around before the next update event.
+//------------------------------------------------------------------------------
+// input:  reload    auto-reload value
+
+//==============================================================================
+uint16_t Sim_GetTimerCount(void);
+//==============================================================================
+// Gets the timer counter.
+//------------------------------------------------------------------------------
+// return: counter value
+
+//==============================================================================
+void Sim_TimerUpdate(void);
+//==============================================================================
+// Generates an update event (UG): the counter restarts at 0 and the interrupt
+// is pending at once.
+//------------------------------------------------------------------------------
+
+//==============================================================================
+void Sim_StopTimer(void);
+//==============================================================================
+// Stops the simulated periodic timer interrupt.
+//------------------------------------------------------------------------------
+
+//==============================================================================
+void Sim_InitUart(uint64_t byteNs);
+//==============================================================================
+// Initializes the simulated UART, its output is discarded until an output
+// file is set.
+//------------------------------------------------------------------------------
+// input:  byteNs    transmission time of one byte [ns]
+
+//==============================================================================
+void Sim_SetUartOutput(FILE* file);
+//==============================================================================
+// Sets the file the UART output is written to, 0 discards the output.
+//------------------------------------------------------------------------------
+
+//==============================================================================
+void Sim_UartSend(const uint8_t data[], uint16_t size, void (*handler)(void));
+//==============================================================================
+// Sends a block as DMA transfer: the handler is called as interrupt when the
+// transmission time of the block has passed in Sim_CpuNs() or Sim_IdleNs().
+//------------------------------------------------------------------------------
+// input:  data      bytes to send
+//         size      number of bytes
+//         handler   transfer complete interrupt handler
+
+//==============================================================================
+void Sim_WaitForInterrupt(void);
+//==============================================================================
+// Sleeps (CPU idle time) until the next interrupt: the timer interrupt, the
+// UART interrupt or the 1ms SysTick, which is not simulated otherwise.
+// Replaces __WFI().
+//------------------------------------------------------------------------------
+
+//==============================================================================
+uint64_t Sim_GetTimeNs(void);
+//==============================================================================
+// Gets the simulated time [ns].
+//------------------------------------------------------------------------------
+
+//==============================================================================
+void Sim_SetCostModel(uint32_t portAccessNs, uint32_t delayCallNs,
+                      uint32_t delayPerUsNs);
+//==============================================================================
+// Sets the CPU cost of port accesses and of System_DelayUs().
+//------------------------------------------------------------------------------
+// input:  portAccessNs  cost of one port read or write [ns]
+//         delayCallNs   fixed cost of one System_DelayUs() call [ns]
+//         delayPerUsNs  cost per requested microsecond [ns]
+
+//==============================================================================
+void Sim_DelayUs(uint32_t nbrOfUs);
+//==============================================================================
+// Advances the simulated time by the cost of System_DelayUs(nbrOfUs).
+//------------------------------------------------------------------------------
+
+//==============================================================================
+void Sim_DelayNs(uint32_t nbrOfNs);
+//==============================================================================
+// Advances the simulated time by the cost of the inline System_DelayNs().
+//------------------------------------------------------------------------------
+
+//==============================================================================
+void Sim_ResetStats(void);
+//==============================================================================
+// Resets the statistics (not the time).
+//------------------------------------------------------------------------------
+
+//==============================================================================
+tSimStats Sim_GetStats(void);
+//==============================================================================
+// Gets the statistics since the last reset.
+//------------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,65 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  sim_crc.c
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  Host (Linux)
+// Compiler  :  GCC
+// Brief     :  Check of the CRC implementation of the driver: SHT85_CalcCrc()
+//              against the bitwise CRC-8 of the datasheet (polynomial 0x31,
+//              initial value 0xFF) for all 65536 words. Built once per
+//              CRC_TABLE_SIZE, the exit code is 1 on a mismatch.
+//==============================================================================
+
+#include "sht85.h"
+#include <stdio.h>
+
+#define CRC_POLYNOMIAL  0x31 // P(x) = x^8 + x^5 + x^4 + 1, without x^8
+#define CRC_INIT        0xFF
+
+static uint8_t CrcBitwise(const uint8_t data[], uint8_t nbrOfBytes);
+
+//------------------------------------------------------------------------------
+int main(void)
+{
+  uint8_t  data[2];        // word, MSB first as sent by the sensor
+  uint32_t word;           // word value
+  uint32_t mismatches = 0; // words with a different CRC
+
+  for(word = 0; word < 0x10000; word++) {
+    data[0] = (uint8_t)(word >> 8);
+    data[1] = (uint8_t)word;
+    if(SHT85_CalcCrc(data, 2) != CrcBitwise(data, 2)) {
+      if(mismatches == 0) {
+        printf("  0x%04X: CRC 0x%02X, expected 0x%02X\n", (unsigned)word,
+               SHT85_CalcCrc(data, 2), CrcBitwise(data, 2));
+      }
+      mismatches++;
+    }
+  }
+
+  printf("CRC table %d bytes: %u of 65536 words differ from the bitwise "
+         "CRC-8\n", CRC_TABLE_SIZE, (unsigned)mismatches);
+
+  return (mismatches == 0) ? 0 : 1;
+}
+
+//------------------------------------------------------------------------------
+static uint8_t CrcBitwise(const uint8_t data[], uint8_t nbrOfBytes)
+{
+  uint8_t crc = CRC_INIT; // calculated checksum
+  uint8_t byteCtr;        // byte counter
+  uint8_t bit;            // bit counter
+
+  for(byteCtr = 0; byteCtr < nbrOfBytes; byteCtr++) {
+    crc ^= data[byteCtr];
+    for(bit = 0; bit < 8; bit++) {
+      crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ CRC_POLYNOMIAL)
+                         : (uint8_t)(crc << 1);
+    }
+  }
+
+  return crc;
+}
@@ -0,0 +1,202 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  sim_fuzz.c
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  Host (Linux)
+// Compiler  :  GCC
+// Brief     :  Random input test of the frame, CRC and NACK paths of the
+//              driver against the sensor model: random environments, serial
+//              numbers and command words, 1 to 3 bit errors in the response
+//              frame and NACKed addresses or command bytes. The driver has to
+//              return the values of the model, CHECKSUM_ERROR for a corrupted
+//              frame (the CRC-8 finds up to 3 bit errors in a word),
+//              ACK_ERROR for a NACK, and leave the bus idle.
+//
+//              sht85_fuzz [iterations [seed]], the exit code is 1 on a
+//              failure.
+//==============================================================================
+
+#include "sht85.h"
+#include "sim_bus.h"
+#include "sim_sht85.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define DEFAULT_ITERATIONS  20000
+#define MAX_FAILURES        10    // failures printed
+#define MEAS_TIMEOUT_MS     50    // single shot measurement timeout
+#define SETTLE_NS           2000000 // longer than the reset and break time
+
+// operations of an iteration
+enum { OP_MEASURE, OP_SERIAL, OP_STATUS, OP_COMMAND, NBR_OF_OPS };
+
+static uint32_t Random(void);
+static uint16_t ExpectedRaw(double value, double offset, double range);
+static void     Fail(uint32_t iteration, const char* operation,
+                     etError error, etError expected);
+
+static uint32_t seed = 1; // state of the random generator
+static uint32_t failures; // failed checks
+
+//------------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  static tSimSht85 model;      // sensor model
+  static tSht85    sensor;     // sensor instance
+  uint32_t iterations = DEFAULT_ITERATIONS; // number of iterations
+  uint32_t start;              // seed of the run
+  uint32_t n;                  // iteration
+  uint32_t counts[3] = {0};    // frames: correct, corrupted, NACKed
+  uint32_t serialNumber;       // read serial number
+  uint16_t status;             // read status register
+  uint16_t rawTemp;            // raw temperature
+  uint16_t rawHumi;            // raw humidity
+  uint8_t  frameLen;           // length of the response frame
+  uint8_t  bits;               // number of bit errors
+  uint8_t  op;                 // operation
+  uint8_t  i;                  // bit error counter
+  bool     flipped;            // bit errors in the response frame
+  etError  expected;           // expected error code
+  etError  error;              // error code
+  static const etSingleMeasureModes modes[3] = {
+    SINGLE_MEAS_HIGH, SINGLE_MEAS_MEDIUM, SINGLE_MEAS_LOW
+  };
+
+  if(argc > 1) iterations = (uint32_t)strtoul(argv[1], 0, 0);
+  if(argc > 2) seed       = (uint32_t)strtoul(argv[2], 0, 0);
+  start = seed;
+
+  Sim_Reset();
+  SimSht85_Init(&model, GPIOB, 0x0200, 0x0100);
+  SHT85_Init(&sensor, &I2c_DefaultBus, SHT85_I2C_ADDR);
+  I2c_SetTiming(&I2c_TimingFast);
+  Sim_IdleNs(50000000);
+
+  for(n = 0; n < iterations; n++) {
+    op       = (uint8_t)(Random() % NBR_OF_OPS);
+    frameLen = (op == OP_STATUS) ? 3 : (op == OP_COMMAND) ? 0 : 6;
+
+    // faults: NACK of the address or of the command bytes, or 1..3 bit
+    // errors anywhere in the response frame
+    model.faults = 0;
+    memset(model.txFlip, 0, sizeof(model.txFlip));
+    flipped = false;
+    switch(Random() % 4) {
+      case 0: model.faults = SIM_FAULT_NACK;      break;
+      case 1: model.faults = SIM_FAULT_NACK_DATA; break;
+      case 2:
+        bits = (uint8_t)(1 + Random() % 3);
+        for(i = 0; i < bits && frameLen > 0; i++) {
+          model.txFlip[Random() % frameLen] ^= (uint8_t)(1U << Random() % 8);
+        }
+        for(i = 0; i < frameLen; i++) {
+          flipped |= model.txFlip[i] != 0;
+        }
+        break;
+      default: break;
+    }
+    expected = model.faults ? ACK_ERROR
+                            : flipped ? CHECKSUM_ERROR : NO_ERROR;
+
+    switch(op) {
+      case OP_MEASURE:
+        SimSht85_SetEnvironment(&model,
+                                (float)(Random() % 17501) / 100 - 45,
+                                (float)(Random() % 10001) / 100);
+        error = SHT85_SingleMeasurmentRaw(&sensor, &rawTemp, &rawHumi,
+                                          modes[Random() % 3],
+                                          MEAS_TIMEOUT_MS);
+        if(error != expected) {
+          Fail(n, "SingleMeasurmentRaw", error, expected);
+        } else if(error == NO_ERROR &&
+                  (rawTemp != ExpectedRaw(model.temperature, 45, 175) ||
+                   rawHumi != ExpectedRaw(model.humidity, 0, 100))) {
+          Fail(n, "SingleMeasurmentRaw values", error, expected);
+        }
+        break;
+
+      case OP_SERIAL:
+        model.serialNumber = Random() ^ Random() << 16;
+        error = SHT85_ReadSerialNumber(&sensor, &serialNumber);
+        if(error != expected) {
+          Fail(n, "ReadSerialNumber", error, expected);
+        } else if(error == NO_ERROR && serialNumber != model.serialNumber) {
+          Fail(n, "ReadSerialNumber value", error, expected);
+        }
+        break;
+
+      case OP_STATUS:
+        error = SHT85_ReadStatus(&sensor, &status);
+        if(error != expected) {
+          Fail(n, "ReadStatus", error, expected);
+        } else if(error == NO_ERROR && status != model.status) {
+          Fail(n, "ReadStatus value", error, expected);
+        }
+        break;
+
+      default:
+        // any command word is acknowledged, the model is reset afterwards
+        error = SHT85_WriteCommand(&sensor, (etCommands)(Random() & 0xFFFF));
+        if(error != expected) {
+          Fail(n, "WriteCommand", error, expected);
+        }
+        break;
+    }
+
+    // the bus is released after every call, also after a fault
+    if((SimGpio_ReadIdr(GPIOB) & 0x0300) != 0x0300) {
+      Fail(n, "bus not idle", error, expected);
+    }
+    counts[expected == NO_ERROR ? 0 : expected == CHECKSUM_ERROR ? 1 : 2]++;
+
+    // back to a known state: no faults, idle and heater off
+    model.faults = 0;
+    memset(model.txFlip, 0, sizeof(model.txFlip));
+    if(op == OP_COMMAND) {
+      Sim_IdleNs(SETTLE_NS);
+      SHT85_WriteCommand(&sensor, CMD_SOFT_RESET);
+    }
+    Sim_IdleNs(SETTLE_NS);
+  }
+
+  printf("Fuzz %u iterations, seed %u: %u correct, %u corrupted, %u NACKed "
+         "frames, %u failures\n", (unsigned)iterations, (unsigned)start,
+         (unsigned)counts[0], (unsigned)counts[1], (unsigned)counts[2],
+         (unsigned)failures);
+
+  return (failures == 0) ? 0 : 1;
+}
+
+//------------------------------------------------------------------------------
+static uint32_t Random(void)
+{
+  // linear congruential generator, upper 16 bits
+  seed = seed * 1103515245 + 12345;
+
+  return seed >> 16;
+}
+
+//------------------------------------------------------------------------------
+static uint16_t ExpectedRaw(double value, double offset, double range)
+{
+  double raw = floor((value + offset) * 65535.0 / range + 0.5); // raw value
+
+  // same conversion as the model
+  return (uint16_t)(raw < 0 ? 0 : (raw > 65535 ? 65535 : raw));
+}
+
+//------------------------------------------------------------------------------
+static void Fail(uint32_t iteration, const char* operation,
+                 etError error, etError expected)
+{
+  if(failures < MAX_FAILURES) {
+    printf("  iteration %u: %s, error 0x%02X, expected 0x%02X\n",
+           (unsigned)iteration, operation, error, expected);
+  }
+  failures++;
+}
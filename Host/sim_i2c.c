@@ -0,0 +1,406 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  sim_i2c.c
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  Host (Linux)
+// Compiler  :  GCC
+// Brief     :  Model of the I2C1 peripheral in master mode and of DMA1
+//              channel 7 (I2C1_RX) for the peripheral backend (i2c_hal_hw.c).
+//              The model drives SCL on PB8 and SDA on PB9 through the output
+//              register of the port, with the bit times of CCR. A register
+//              access that starts an action runs it on the simulated bus at
+//              once, the CPU polls the flags meanwhile:
+//
+//              - CR1 START: start or repeated start condition, then SB
+//              - DR write: address or data byte, then ADDR/BTF or AF
+//              - SR1 read, then SR2 read: clears ADDR, starts the reception
+//              - any read during the reception: receives a byte with the
+//                acknowledge of CR1 ACK, then RXNE; with DMAEN the DMA
+//                receives all CNDTR bytes, the last one without acknowledge
+//                if LAST is set
+//              - CR1 STOP: stop condition, after the byte in reception
+//
+//              IFCR of the DMA takes effect at the next I2C1 access.
+//==============================================================================
+
+#include "sim_bus.h"
+#include <string.h>
+
+#define SCL_PIN             0x0100   // PB8
+#define SDA_PIN             0x0200   // PB9
+#define REGISTER_ACCESS_NS  250      // 2 cycles, as a port access
+#define STRETCH_POLL_NS     1000     // SCL polling while a slave stretches
+#define STRETCH_MAX_NS      25000000 // the peripheral would wait forever
+#define SR1_RC_W0           0xDF00   // SR1 flags cleared by writing 0
+
+// transfer phases
+enum { PH_IDLE, PH_ADDRESS, PH_TRANSMIT, PH_RECEIVE };
+
+I2C_TypeDef         SimI2c1;
+DMA_TypeDef         SimDma1;
+DMA_Channel_TypeDef SimDma1Channel[7];
+AFIO_TypeDef        SimAfio;
+
+static uint8_t phase;   // transfer phase
+static bool    sr1Read; // SR1 read with ADDR set, an SR2 read clears ADDR
+static bool    nacked;  // last received byte not acknowledged
+
+static bool     Receiving(void);
+static void     Reset(void);
+static void     Start(void);
+static void     Stop(void);
+static void     Address(uint8_t byte);
+static void     Transmit(uint8_t byte);
+static void     Receive(void);
+static void     ReceiveDma(void);
+static bool     WriteBus(uint8_t byte);
+static uint8_t  ReadBus(bool ack);
+static void     Drive(uint16_t pin, bool high);
+static bool     Level(uint16_t pin);
+static void     ReleaseScl(void);
+static uint32_t LowNs(void);
+static uint32_t HighNs(void);
+static void     ClearDmaFlags(void);
+
+//------------------------------------------------------------------------------
+uint16_t SimI2c_Read(size_t offset)
+{
+  uint16_t value; // register value
+
+  Sim_CpuNs(REGISTER_ACCESS_NS);
+  ClearDmaFlags();
+
+  // reading SR1 and then SR2 clears ADDR
+  if(offset == offsetof(I2C_TypeDef, SR1) && (SimI2c1.SR1 & I2C_SR1_ADDR)) {
+    sr1Read = true;
+  } else if(offset == offsetof(I2C_TypeDef, SR2) && sr1Read) {
+    sr1Read      = false;
+    SimI2c1.SR1 &= ~I2C_SR1_ADDR;
+  }
+
+  // the reception runs from the clearing of ADDR, the CPU sees its end with
+  // the next access
+  if(Receiving()) {
+    if(SimI2c1.CR2 & I2C_CR2_DMAEN) {
+      ReceiveDma();
+    } else {
+      Receive();
+    }
+  }
+
+  value = *(volatile uint16_t*)((uint8_t*)&SimI2c1 + offset);
+  if(offset == offsetof(I2C_TypeDef, DR)) {
+    SimI2c1.SR1 &= ~(I2C_SR1_RXNE | I2C_SR1_BTF);
+  }
+
+  return value;
+}
+
+//------------------------------------------------------------------------------
+void SimI2c_Write(size_t offset, uint16_t value)
+{
+  Sim_CpuNs(REGISTER_ACCESS_NS);
+  ClearDmaFlags();
+
+  switch(offset) {
+    case offsetof(I2C_TypeDef, CR1):
+      if(value & I2C_CR1_SWRST) {
+        Reset();
+        SimI2c1.CR1 = value;
+        break;
+      }
+      SimI2c1.CR1 = value;
+      // a disabled peripheral releases the lines and forgets the transfer
+      if(!(value & I2C_CR1_PE)) {
+        Drive(SCL_PIN | SDA_PIN, true);
+        SimI2c1.CR1 &= ~(I2C_CR1_START | I2C_CR1_STOP);
+        SimI2c1.SR1  = 0;
+        SimI2c1.SR2  = 0;
+        phase        = PH_IDLE;
+        break;
+      }
+      if(value & I2C_CR1_START) {
+        Start();
+      }
+      // a stop during the reception of a byte follows after it
+      if((value & I2C_CR1_STOP) && !Receiving()) {
+        Stop();
+      }
+      break;
+
+    case offsetof(I2C_TypeDef, DR):
+      SimI2c1.DR = value;
+      if(phase == PH_ADDRESS) {
+        Address((uint8_t)value);
+      } else if(phase == PH_TRANSMIT) {
+        Transmit((uint8_t)value);
+      }
+      break;
+
+    case offsetof(I2C_TypeDef, SR1):
+      SimI2c1.SR1 &= value | ~SR1_RC_W0;
+      break;
+
+    case offsetof(I2C_TypeDef, SR2):
+      break; // read only
+
+    default:
+      *(volatile uint16_t*)((uint8_t*)&SimI2c1 + offset) = value;
+      break;
+  }
+}
+
+//------------------------------------------------------------------------------
+static bool Receiving(void)
+{
+  // from the clearing of ADDR until a byte is not acknowledged, SCL is held
+  // low while a received byte is not read
+  return phase == PH_RECEIVE && !nacked &&
+         !(SimI2c1.SR1 & (I2C_SR1_ADDR | I2C_SR1_RXNE));
+}
+
+//------------------------------------------------------------------------------
+static void Reset(void)
+{
+  memset(&SimI2c1, 0, sizeof(SimI2c1));
+  Drive(SCL_PIN | SDA_PIN, true);
+  phase   = PH_IDLE;
+  sr1Read = false;
+  nacked  = false;
+}
+
+//------------------------------------------------------------------------------
+static void Start(void)
+{
+  if(phase != PH_IDLE) {
+    // repeated start: SCL is held low after the last acknowledge
+    Drive(SDA_PIN, true);
+    Sim_CpuNs(LowNs());
+    ReleaseScl();
+    Sim_CpuNs(HighNs());
+  }
+
+  Drive(SDA_PIN, false);
+  Sim_CpuNs(HighNs());
+  Drive(SCL_PIN, false);
+
+  SimI2c1.CR1 &= ~I2C_CR1_START;
+  SimI2c1.SR1 |= I2C_SR1_SB;
+  SimI2c1.SR2 |= I2C_SR2_MSL | I2C_SR2_BUSY;
+  phase   = PH_ADDRESS;
+  sr1Read = false;
+  nacked  = false;
+}
+
+//------------------------------------------------------------------------------
+static void Stop(void)
+{
+  SimI2c1.CR1 &= ~I2C_CR1_STOP;
+  if(phase == PH_IDLE) return;
+
+  // SCL is held low after the last acknowledge
+  Drive(SDA_PIN, false);
+  Sim_CpuNs(LowNs());
+  ReleaseScl();
+  Sim_CpuNs(HighNs());
+  Drive(SDA_PIN, true);
+  Sim_CpuNs(LowNs()); // bus free time
+
+  SimI2c1.SR2 &= ~(I2C_SR2_MSL | I2C_SR2_BUSY | I2C_SR2_TRA);
+  phase = PH_IDLE;
+}
+
+//------------------------------------------------------------------------------
+static void Address(uint8_t byte)
+{
+  SimI2c1.SR1 &= ~I2C_SR1_SB;
+
+  // after a not acknowledged address the master waits for the stop
+  phase = PH_TRANSMIT;
+  if(!WriteBus(byte)) {
+    SimI2c1.SR1 |= I2C_SR1_AF;
+    return;
+  }
+
+  SimI2c1.SR1 |= I2C_SR1_ADDR;
+  if(byte & 0x01) {
+    phase = PH_RECEIVE;
+  } else {
+    SimI2c1.SR2 |= I2C_SR2_TRA;
+  }
+}
+
+//------------------------------------------------------------------------------
+static void Transmit(uint8_t byte)
+{
+  SimI2c1.SR1 &= ~(I2C_SR1_BTF | I2C_SR1_TXE);
+
+  if(WriteBus(byte)) {
+    SimI2c1.SR1 |= I2C_SR1_BTF | I2C_SR1_TXE;
+  } else {
+    SimI2c1.SR1 |= I2C_SR1_AF;
+  }
+}
+
+//------------------------------------------------------------------------------
+static void Receive(void)
+{
+  bool ack = (SimI2c1.CR1 & I2C_CR1_ACK) != 0; // acknowledge of the byte
+
+  SimI2c1.DR   = ReadBus(ack);
+  SimI2c1.SR1 |= I2C_SR1_RXNE;
+  nacked       = !ack;
+
+  // a stop requested during the reception
+  if(SimI2c1.CR1 & I2C_CR1_STOP) {
+    Stop();
+  }
+}
+
+//------------------------------------------------------------------------------
+static void ReceiveDma(void)
+{
+  DMA_Channel_TypeDef* channel = &SimDma1Channel[6]; // I2C1_RX
+  uint8_t*             data;                         // memory address
+  bool                 ack = true;                   // acknowledge of a byte
+
+  if(!(channel->CCR & DMA_CCR7_EN) || channel->CNDTR == 0) return;
+
+  data = (uint8_t*)channel->CMAR;
+  while(channel->CNDTR > 0) {
+    ack = (SimI2c1.CR1 & I2C_CR1_ACK) &&
+          !(channel->CNDTR == 1 && (SimI2c1.CR2 & I2C_CR2_LAST));
+    *data = ReadBus(ack);
+    if(channel->CCR & DMA_CCR7_MINC) {
+      data++;
+    }
+    channel->CNDTR--;
+  }
+  nacked = !ack;
+
+  SimDma1.ISR |= DMA_ISR_GIF7 | DMA_ISR_TCIF7;
+}
+
+//------------------------------------------------------------------------------
+static bool WriteBus(uint8_t byte)
+{
+  uint8_t mask; // bit mask
+  bool    ack;  // acknowledge of the slave
+
+  // SCL is low after the start condition or the last acknowledge
+  for(mask = 0x80; mask > 0; mask >>= 1) {
+    Drive(SDA_PIN, (byte & mask) != 0);
+    Sim_CpuNs(LowNs());
+    ReleaseScl();
+    Sim_CpuNs(HighNs());
+    Drive(SCL_PIN, false);
+  }
+
+  Drive(SDA_PIN, true);
+  Sim_CpuNs(LowNs());
+  ReleaseScl();
+  Sim_CpuNs(HighNs());
+  ack = !Level(SDA_PIN);
+  Drive(SCL_PIN, false);
+
+  return ack;
+}
+
+//------------------------------------------------------------------------------
+static uint8_t ReadBus(bool ack)
+{
+  uint8_t byte = 0; // received byte
+  uint8_t bit;      // bit counter
+
+  Drive(SDA_PIN, true);
+  for(bit = 0; bit < 8; bit++) {
+    Sim_CpuNs(LowNs());
+    ReleaseScl();
+    Sim_CpuNs(HighNs());
+    byte = (uint8_t)(byte << 1) | (Level(SDA_PIN) ? 1 : 0);
+    Drive(SCL_PIN, false);
+  }
+
+  Drive(SDA_PIN, !ack);
+  Sim_CpuNs(LowNs());
+  ReleaseScl();
+  Sim_CpuNs(HighNs());
+  Drive(SCL_PIN, false);
+  Drive(SDA_PIN, true);
+
+  return byte;
+}
+
+//------------------------------------------------------------------------------
+static void Drive(uint16_t pin, bool high)
+{
+  GPIO_TypeDef* port = GPIOB; // port of SDA and SCL
+
+  // open-drain output of the alternate function
+  if(high) {
+    port->ODR |= pin;
+  } else {
+    port->ODR &= ~(uint32_t)pin;
+  }
+  Sim_Update(port);
+}
+
+//------------------------------------------------------------------------------
+static bool Level(uint16_t pin)
+{
+  Sim_Update(GPIOB);
+
+  return (GPIOB->IDR & pin) != 0;
+}
+
+//------------------------------------------------------------------------------
+static void ReleaseScl(void)
+{
+  uint32_t waitNs; // time waited for SCL
+
+  Drive(SCL_PIN, true);
+
+  // a slave stretching the clock holds SCL low
+  for(waitNs = 0; !Level(SCL_PIN) && waitNs < STRETCH_MAX_NS;
+      waitNs += STRETCH_POLL_NS) {
+    Sim_CpuNs(STRETCH_POLL_NS);
+  }
+}
+
+//------------------------------------------------------------------------------
+static uint32_t LowNs(void)
+{
+  uint32_t pclkMhz = SimI2c1.CR2 & I2C_CR2_FREQ;              // APB1 clock
+  uint32_t ccrNs   = (SimI2c1.CCR & I2C_CCR_CCR) * 1000 /
+                     (pclkMhz ? pclkMhz : 1);                // CCR time
+
+  // fast-mode with DUTY = 0: Tlow = 2 * CCR, standard-mode: Tlow = CCR
+  return (SimI2c1.CCR & I2C_CCR_FS) ? 2 * ccrNs : ccrNs;
+}
+
+//------------------------------------------------------------------------------
+static uint32_t HighNs(void)
+{
+  uint32_t pclkMhz = SimI2c1.CR2 & I2C_CR2_FREQ; // APB1 clock
+
+  return (SimI2c1.CCR & I2C_CCR_CCR) * 1000 / (pclkMhz ? pclkMhz : 1);
+}
+
+//------------------------------------------------------------------------------
+static void ClearDmaFlags(void)
+{
+  uint32_t clear = SimDma1.IFCR; // flags to clear
+  uint8_t  i;                    // channel index
+
+  // CGIFx clears all flags of channel x
+  for(i = 0; i < 7; i++) {
+    if(clear & (1U << (4 * i))) {
+      clear |= 0xFU << (4 * i);
+    }
+  }
+  SimDma1.ISR  &= ~clear;
+  SimDma1.IFCR  = 0;
+}
@@ -0,0 +1,1663 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  sim_main.c
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  Host (Linux)
+// Compiler  :  GCC
+// Brief     :  Runs the sensor commands of the sample against the simulated
+//              SHT85 and reports the bus time and CPU time per operation.
+//
+//              sht85_sim [telemetry file]
+//              writes the telemetry stream of the task run to the file, see
+//              Tools/sht85_decode.
+//==============================================================================
+
+#include "sht85.h"
+#include "sht85_stream.h"
+#include "sht85_schedule.h"
+#include "sht85_queue.h"
+#include "task.h"
+#include "app.h"
+#include "power.h"
+#include "telemetry.h"
+#include "aggregate.h"
+#include "sht85_derived.h"
+#include "sht85_heater.h"
+#include "sht85_health.h"
+#include "sht85_recovery.h"
+#include "sht85_tuner.h"
+#include "sht85_alarm.h"
+#include "instrument.h"
+#include "sim_bus.h"
+#include "sim_sht85.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#define NBR_OF_LOCKSTEP_SENSORS  4
+#define NBR_OF_TIMING_PROFILES   4
+#define STREAM_SECONDS           10
+#define TIMER_SECONDS            1
+#define TIMER_START_MS           10   // first period of the timer check
+#define POLL_SECONDS             30
+#define MIXED_SECONDS            3
+#define FETCH_DEADLINE_MS        5
+#define TASK_SECONDS             10
+#define FAULT_START_MS           4000 // CRC fault injected during the task run
+#define FAULT_END_MS             4300
+#define LOW_POWER_SAMPLES        20
+#define BURST_RECORDS            1000 // telemetry records, one per ms
+#define AGGREGATE_SAMPLES        2000 // samples of the aggregation check
+#define AGGREGATE_LENGTH         100  // window length
+#define AGGREGATE_HOP            10   // hop of the rolling window
+#define AGGREGATE_MEAN_ERROR     0.5   // mean rounded to the unit
+#define AGGREGATE_VAR_ERROR      0.001 // relative variance error
+#define DERIVED_RAW_TEMP_MAX     39321 // 60°C, top of the Magnus range
+#define DERIVED_RAW_HUMI_MIN     655   // 1%RH
+#define DERIVED_STEP_TEMP        37    // raw steps of the validation grid
+#define DERIVED_STEP_HUMI        61
+#define DERIVED_DEW_POINT_ERROR  0.02  // error bounds of sht85_derived.h [°C]
+#define DERIVED_ABS_HUMI_ERROR   0.04  // [g/m^3]
+#define DERIVED_MIXING_ERROR     0.06  // [g/kg]
+#define DERIVED_RELATIVE_ERROR   0.001 // of the values above 10
+#define HEATER_SECONDS           40
+#define HEATER_SUSTAIN_MS        10000 // shorter than in the application
+#define HEATER_PULSE_MS          10000
+#define HEATER_SETTLE_MS         5000
+#define HEATER_DRY_NS            5000000000ULL // heating that dries the sensor
+#define HEATER_COOLING_NS        1500000000.0  // cooling time constant
+#define HEALTH_INTERVAL          10   // fetches per status read
+#define HEALTH_RESET_MS          2000 // sensor reset after the start
+#define HEALTH_SECONDS           5
+#define RECOVERY_SECONDS         10
+#define RECOVERY_GLITCH_MS       3000 // CRC fault of the healthy sensor
+#define RECOVERY_GLITCH_END_MS   3050
+#define RECOVERY_DEAD_ADDR       0x45 // address of the dead sensor
+#define RECOVERY_BACK_MS         200  // samples again after the glitch
+#define TUNER_SECONDS            60
+#define TUNER_THRESHOLD          70.0f // humidity alarm threshold [%RH]
+#define TUNER_GUARD              2.0f  // guard band of it [%RH]
+#define TUNER_HOLD_SAMPLES       50
+#define TUNER_NOISE_T            0.1f  // allowed temperature noise [°C]
+#define TUNER_NOISE_RH           0.15f // allowed humidity noise [%RH]
+#define ALARM_SECONDS            60
+#define ALARM_PERIOD_S           20.0  // period of the humidity swing [s]
+#define ALARM_THRESHOLD          50.0  // humidity alarm threshold [%RH]
+#define ALARM_HYSTERESIS         0.3   // hysteresis of it [%RH]
+#define ALARM_SWING              1.0   // amplitude of the humidity [%RH]
+#define ALARM_STEP_S             30.0  // temperature step [s]
+
+// the bit-banged backend runs a bus on any port pins, the peripheral backend
+// only on I2C1 (PB8/PB9)
+#ifdef I2C_HAL_HARDWARE
+  #define PORT_A_BUSES  false
+#else
+  #define PORT_A_BUSES  true
+#endif
+
+// bus timing profiles to compare
+static const tI2cTiming* const timingProfile[NBR_OF_TIMING_PROFILES] = {
+  &I2c_TimingStandard, &I2c_TimingFast, &I2c_TimingFastPlus, &I2c_TimingScope
+};
+static const char* const timingName[NBR_OF_TIMING_PROFILES] = {
+  "ReadMeasurementBuffer std", "ReadMeasurementBuffer fast",
+  "ReadMeasurementBuffer fast+", "ReadMeasurementBuffer scope"
+};
+
+static void Report(const char* operation, etError error, etError expected);
+static void Check(bool passed, const char* check);
+static void CheckValues(float temperature, float humidity,
+                        float expectedTemp, float expectedHumi);
+static void ReportInstr(void);
+static void PollPeriodic(tSht85* sensor, bool scheduled, const char* operation);
+static void TimerPeriod(uint16_t periodMs, uint32_t handlerUs,
+                        const char* operation);
+static void TimerCheckHandler(void);
+static void MixedWorkload(tSht85* sensors[], bool queued,
+                          const char* operation);
+static void Issue(tSht85Queue* queue, tSht85QueueStats stats[],
+                  uint32_t eventMs, tSht85* sensor, etCommands command,
+                  etSht85Priority priority, uint16_t deadlineMs);
+static void BlockingLoop(tSht85* sensor);
+static void RunTasks(tSimSht85* model, tSht85* sensor, tSht85Stream* stream,
+                     FILE* telemetry);
+static void TelemetryBurst(void);
+static void Aggregation(bool rolling, const char* operation);
+static void CheckSummary(const tAggregateSummary* summary,
+                         const int16_t values[], uint16_t count,
+                         bool humidity, double* meanError,
+                         double* varianceError);
+static void DerivedQuantities(void);
+static void HeaterRecovery(tSimSht85* model, tSht85* sensor,
+                           tSht85Stream* stream);
+static void HealthMonitor(tSht85* sensor, tSht85Stream* stream,
+                          uint16_t interval, const char* operation);
+static void CondensingEnvironment(tSimSht85* model, uint64_t timeNs,
+                                  float* temperature, float* humidity);
+static void BusClear(tSimSht85* model, tSht85* sensor);
+static void SharedBusRecovery(tSht85Stream* stream, uint32_t minBackoffMs,
+                              uint32_t maxBackoffMs, const char* operation);
+static void ReportIdle(uint32_t samples);
+static void LowPower(tSimSht85* model, tSht85* sensor, uint32_t intervalMs,
+                     etPowerMode mode, const char* operation);
+static void Tuner(tSimSht85* model, tSht85* sensor, tSht85Stream* stream,
+                  bool tuned, const char* operation);
+static void TunerEnvironment(tSimSht85* model, uint64_t timeNs,
+                             float* temperature, float* humidity);
+static void TunerTruth(uint64_t timeNs, float* temperature, float* humidity);
+static void Alarms(tSimSht85* model, tSht85* sensor, tSht85Stream* stream);
+static void AlarmEnvironment(tSimSht85* model, uint64_t timeNs,
+                             float* temperature, float* humidity);
+
+static uint32_t failures;     // failed checks
+static uint64_t tunerStartNs; // start of the tuner scenario [ns]
+static uint64_t alarmStartNs; // start of the alarm scenario [ns]
+static uint16_t timerPeriodMs;  // period set by the timer handler [ms]
+static uint32_t timerHandlerUs; // time in the timer handler [us]
+static uint32_t timerCalls;     // timer interrupts
+static uint64_t timerLastNs;    // last timer interrupt [ns]
+static uint64_t timerMaxNs;     // longest interval between them [ns]
+
+//------------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  static tSimSht85    model[NBR_OF_LOCKSTEP_SENSORS];  // simulated sensors
+  static tSht85       sensor[NBR_OF_LOCKSTEP_SENSORS]; // sensor instances
+  static tI2cBus      bus[NBR_OF_LOCKSTEP_SENSORS];    // buses on port A
+  static tSht85Stream stream;                          // 10Hz sample stream
+  tSht85Sample samples[SHT85_STREAM_SIZE];
+  uint32_t nbrOfSamples = 0;
+  uint8_t  nbrOfRead;
+  tSht85*  sensors[NBR_OF_LOCKSTEP_SENSORS];
+  float    temperatures[NBR_OF_LOCKSTEP_SENSORS];
+  float    humidities[NBR_OF_LOCKSTEP_SENSORS];
+  etError  errors[NBR_OF_LOCKSTEP_SENSORS];
+  etError  error;
+  uint32_t serialNumber;
+  uint16_t status;
+  float    temperature;
+  float    humidity;
+  tSht85Status decoded;
+  const tI2cTiming* defaultTiming;
+  uint64_t profileNs[NBR_OF_TIMING_PROFILES];
+  uint64_t startNs;
+  uint32_t profileWrites = 0;
+  uint8_t  i;
+
+  Sim_Reset();
+  SimSht85_Init(&model[0], GPIOB, 0x0200, 0x0100);
+  SimSht85_SetEnvironment(&model[0], 23.5f, 41.2f);
+  SHT85_Init(&sensor[0], &I2c_DefaultBus, SHT85_I2C_ADDR);
+
+  // power-up time
+  Sim_IdleNs(50000000);
+
+  printf("%-28s %-6s %10s %10s %7s\n", "operation", "error", "bus [us]",
+         "cpu [us]", "writes");
+
+#ifdef SHT85_INSTRUMENT
+  Instr_Reset();
+#endif
+  Sim_ResetStats();
+  Report("SoftReset", SHT85_SoftReset(&sensor[0]), NO_ERROR);
+
+  Sim_ResetStats();
+  error = SHT85_ReadSerialNumber(&sensor[0], &serialNumber);
+  Report("ReadSerialNumber", error, NO_ERROR);
+  Check(serialNumber == model[0].serialNumber, "serial number");
+
+  Sim_ResetStats();
+  error = SHT85_ReadStatus(&sensor[0], &status);
+  Report("ReadStatus", error, NO_ERROR);
+  SHT85_DecodeStatus(status, &decoded);
+  Check(decoded.resetDetected, "reset flag after the soft reset");
+
+  Sim_ResetStats();
+  error = SHT85_SingleMeasurment(&sensor[0], &temperature, &humidity,
+                                 SINGLE_MEAS_HIGH, 50);
+  Report("SingleMeasurment high", error, NO_ERROR);
+  CheckValues(temperature, humidity, 23.5f, 41.2f);
+
+  Sim_ResetStats();
+  error = SHT85_SingleMeasurment(&sensor[0], &temperature, &humidity,
+                                 SINGLE_MEAS_MEDIUM, 50);
+  Report("SingleMeasurment medium", error, NO_ERROR);
+  CheckValues(temperature, humidity, 23.5f, 41.2f);
+
+  Sim_ResetStats();
+  error = SHT85_SingleMeasurment(&sensor[0], &temperature, &humidity,
+                                 SINGLE_MEAS_LOW, 50);
+  Report("SingleMeasurment low", error, NO_ERROR);
+  CheckValues(temperature, humidity, 23.5f, 41.2f);
+
+  Sim_ResetStats();
+  error = SHT85_StartMeasurementAsync(&sensor[0], SINGLE_MEAS_HIGH, 0);
+  while(SHT85_ProcessAsync(&sensor[0])) {
+    Sim_IdleNs(1000000);
+  }
+  Report("StartMeasurementAsync high", error, NO_ERROR);
+
+  Sim_ResetStats();
+  error = SHT85_StartPeriodicMeasurment(&sensor[0], PERI_MEAS_HIGH_10_HZ);
+  Report("StartPeriodicMeasurment", error, NO_ERROR);
+  startNs = Sim_GetStats().busNs;
+
+  Sim_IdleNs(100000000);
+  Sim_ResetStats();
+  error = SHT85_ReadMeasurementBuffer(&sensor[0], &temperature, &humidity);
+  Report("ReadMeasurementBuffer", error, NO_ERROR);
+  CheckValues(temperature, humidity, 23.5f, 41.2f);
+
+  // no new sample since the last fetch: the sensor NACKs the read header
+  Sim_ResetStats();
+  error = SHT85_ReadMeasurementBuffer(&sensor[0], &temperature, &humidity);
+  Report("ReadMeasurementBuffer empty", error, ACK_ERROR);
+
+  // same read with all timing profiles
+  defaultTiming = I2c_GetTiming();
+  for(i = 0; i < NBR_OF_TIMING_PROFILES; i++) {
+    I2c_SetTiming(timingProfile[i]);
+    Sim_IdleNs(100000000);
+    Sim_ResetStats();
+    error = SHT85_ReadMeasurementBuffer(&sensor[0], &temperature, &humidity);
+    Report(timingName[i], error, NO_ERROR);
+    CheckValues(temperature, humidity, 23.5f, 41.2f);
+    profileNs[i]   = Sim_GetStats().busNs;
+    profileWrites += Sim_GetStats().portWrites;
+  }
+  I2c_SetTiming(defaultTiming);
+
+  // the bit-banged backend runs every profile on the port pins, the
+  // peripheral limits fast+ to 400kHz and has no gap after each byte
+  Check(profileNs[1] < profileNs[0], "fast profile faster than std");
+#ifdef I2C_HAL_HARDWARE
+  Check(profileNs[2] == profileNs[1], "fast+ profile limited to 400kHz");
+  Check(profileNs[3] == profileNs[0], "scope profile same as std");
+  Check(profileWrites == 0, "no port writes by the peripheral");
+#else
+  Check(profileNs[2] < profileNs[1], "fast+ profile faster than fast");
+  Check(profileNs[3] > profileNs[0], "scope profile slower than std");
+  Check(profileWrites > 0, "port writes by the bit-banged bus");
+#endif
+
+  Sim_ResetStats();
+  Report("StopPeriodicMeasurment", SHT85_StopPeriodicMeasurment(&sensor[0]),
+         NO_ERROR);
+  Check(Sim_GetStats().busNs == startNs, "stop at the default timing");
+  // the sensor accepts commands again after the break time
+  Sim_IdleNs(SHT85_BREAK_MS * 1000000ULL);
+
+  printf("\nlast measurement: %.2f degC, %.2f %%RH, serial 0x%08X\n\n",
+         temperature, humidity, (unsigned)serialNumber);
+  ReportInstr();
+
+  // 1Hz periodic mode: fixed 100ms polling against the fetch scheduler, also
+  // with a sensor clock 0.5% faster and 0.5% slower than the controller
+  PollPeriodic(&sensor[0], false, "Poll 1Hz every 100ms, 30s");
+  PollPeriodic(&sensor[0], true,  "Scheduled 1Hz, 30s");
+  model[0].clockPpm = 5000;
+  PollPeriodic(&sensor[0], true,  "Scheduled 1Hz +0.5%, 30s");
+  model[0].clockPpm = -5000;
+  PollPeriodic(&sensor[0], true,  "Scheduled 1Hz -0.5%, 30s");
+  model[0].clockPpm = 0;
+  printf("\n");
+
+  // 10Hz stream, fetched by the timer interrupt, drained once per second
+  SHT85_StreamInit(&stream, &sensor[0]);
+  Sim_ResetStats();
+  error = SHT85_StreamStart(&stream, PERI_MEAS_HIGH_10_HZ);
+  for(i = 0; i < STREAM_SECONDS && error == NO_ERROR; i++) {
+    Sim_IdleNs(1000000000);
+    error = SHT85_StreamRead(&stream, samples, SHT85_STREAM_SIZE, &nbrOfRead);
+    nbrOfSamples += nbrOfRead;
+  }
+  error |= SHT85_StreamStop(&stream);
+  Report("Stream 10Hz, 10s", error, NO_ERROR);
+  Check(nbrOfSamples >= STREAM_SECONDS * 10 - 1, "a sample per period");
+  Check(stream.schedule.missed == 0 && stream.schedule.duplicates == 0,
+        "no missed or duplicate samples");
+  Check(stream.overruns == 0, "no overruns");
+  printf("  %u samples, %u interrupts, %u not ready, %u overruns, "
+         "%.1f us bus per sample\n\n", (unsigned)nbrOfSamples,
+         (unsigned)Sim_GetStats().interrupts,
+         (unsigned)stream.schedule.notReady, (unsigned)stream.overruns,
+         nbrOfSamples ? Sim_GetStats().busNs / 1000.0 / nbrOfSamples : 0.0);
+
+  // the periodic timer at the shortest period, and a period shortened in the
+  // handler below the time it has already run, as after a slow fetch
+  TimerPeriod(1, 100,  "Timer 1ms, 1s");
+  TimerPeriod(2, 3000, "Timer 2ms after 3ms, 1s");
+  printf("\n");
+
+  // several sensors on port A, SDA on bit 0..3, common SCL on bit 8; the
+  // peripheral backend has a single bus
+  if(PORT_A_BUSES) {
+    Sim_Reset();
+    for(i = 0; i < NBR_OF_LOCKSTEP_SENSORS; i++) {
+      bus[i].port   = GPIOA;
+      bus[i].sdaPin = (uint16_t)(1U << i);
+      bus[i].sclPin = 0x0100;
+      SimSht85_Init(&model[i], GPIOA, bus[i].sdaPin, bus[i].sclPin);
+      SimSht85_SetEnvironment(&model[i], 20.0f + i, 40.0f + i);
+      SHT85_Init(&sensor[i], &bus[i], SHT85_I2C_ADDR);
+      sensors[i] = &sensor[i];
+    }
+
+    // power-up time
+    Sim_IdleNs(50000000);
+
+    for(i = 0; i < NBR_OF_LOCKSTEP_SENSORS; i++) {
+      SHT85_StartPeriodicMeasurment(&sensor[i], PERI_MEAS_HIGH_10_HZ);
+    }
+
+    Sim_IdleNs(100000000);
+    Sim_ResetStats();
+    for(i = 0; i < NBR_OF_LOCKSTEP_SENSORS; i++) {
+      errors[i] = SHT85_ReadMeasurementBuffer(&sensor[i], &temperatures[i],
+                                              &humidities[i]);
+    }
+    Report("4 sensors sequential",
+           errors[0] | errors[1] | errors[2] | errors[3], NO_ERROR);
+    for(i = 0; i < NBR_OF_LOCKSTEP_SENSORS; i++) {
+      CheckValues(temperatures[i], humidities[i], 20.0f + i, 40.0f + i);
+    }
+
+    Sim_IdleNs(100000000);
+    Sim_ResetStats();
+    SHT85_ReadMeasurementBuffers(sensors, NBR_OF_LOCKSTEP_SENSORS, temperatures,
+                                 humidities, errors);
+    Report("4 sensors lockstep", errors[0] | errors[1] | errors[2] | errors[3],
+           NO_ERROR);
+
+    for(i = 0; i < NBR_OF_LOCKSTEP_SENSORS; i++) {
+      printf("sensor %u: %.2f degC, %.2f %%RH\n", i, temperatures[i],
+             humidities[i]);
+      CheckValues(temperatures[i], humidities[i], 20.0f + i, 40.0f + i);
+    }
+    printf("\n");
+
+    // 10Hz fetches of sensor 0 and 1 mixed with housekeeping of sensor 2 and a
+    // soft reset of sensor 3, issued directly and through the command queue
+    MixedWorkload(sensors, false, "Mixed blocking, 3s");
+    MixedWorkload(sensors, true,  "Mixed queued, 3s");
+    printf("\n");
+  } else {
+    printf("4 sensors on port A: not simulated with I2C1\n\n");
+  }
+
+  // the sample application: the former blocking main loop against the
+  // cooperative tasks, which also recover from an injected checksum fault
+  Sim_Reset();
+  SimSht85_Init(&model[0], GPIOB, 0x0200, 0x0100);
+  SimSht85_SetEnvironment(&model[0], 23.5f, 41.2f);
+  SHT85_Init(&sensor[0], &I2c_DefaultBus, SHT85_I2C_ADDR);
+  I2c_SetTiming(&I2c_TimingFast);
+  Sim_IdleNs(50000000);
+  BlockingLoop(&sensor[0]);
+
+  Sim_Reset();
+  SimSht85_Init(&model[0], GPIOB, 0x0200, 0x0100);
+  SimSht85_SetEnvironment(&model[0], 23.5f, 61.2f);
+  RunTasks(&model[0], &sensor[0], &stream,
+           argc > 1 ? fopen(argv[1], "wb") : 0);
+  TelemetryBurst();
+  Aggregation(false, "Aggregation tumbling 100");
+  Aggregation(true,  "Aggregation rolling 100/10");
+  printf("\n");
+
+  // dew point, absolute humidity and mixing ratio against double precision
+  DerivedQuantities();
+  printf("\n");
+
+  // unexpected sensor reset during the stream, found by the status monitor
+  SHT85_Init(&sensor[0], &I2c_DefaultBus, SHT85_I2C_ADDR);
+  HealthMonitor(&sensor[0], &stream, 0, "Sensor reset, no monitor");
+  HealthMonitor(&sensor[0], &stream, HEALTH_INTERVAL,
+                "Sensor reset, monitor 10");
+  printf("\n");
+
+  // condensation on the sensor, dried by a heater pulse
+  HeaterRecovery(&model[0], &sensor[0], &stream);
+  printf("\n");
+
+  // a slave holding SDA low, freed by the bus clear; a glitch of a healthy
+  // sensor and a dead sensor on the same bus, retried every 1ms and with
+  // exponential backoff
+  BusClear(&model[0], &sensor[0]);
+  SharedBusRecovery(&stream, 1, 1, "Dead sensor, retry 1ms");
+  SharedBusRecovery(&stream, 10, 10000, "Dead sensor, backoff");
+  printf("\n");
+
+  // low power logger: single shot and periodic mode at a periodic rate and
+  // the mode chosen by the estimate, also for intervals without a rate
+  Sim_Reset();
+  SimSht85_Init(&model[0], GPIOB, 0x0200, 0x0100);
+  SimSht85_SetEnvironment(&model[0], 23.5f, 41.2f);
+  SHT85_Init(&sensor[0], &I2c_DefaultBus, SHT85_I2C_ADDR);
+  I2c_SetTiming(&I2c_TimingFast);
+  Sim_IdleNs(50000000);
+  System_InitStop();
+  LowPower(&model[0], &sensor[0], 100, POWER_MODE_SINGLE,
+           "Low power 100ms single");
+  LowPower(&model[0], &sensor[0], 100, POWER_MODE_PERIODIC,
+           "Low power 100ms periodic");
+  LowPower(&model[0], &sensor[0], 1000, POWER_MODE_SINGLE,
+           "Low power 1s single");
+  LowPower(&model[0], &sensor[0], 1000, POWER_MODE_PERIODIC,
+           "Low power 1s periodic");
+  LowPower(&model[0], &sensor[0], 1000, POWER_MODE_AUTO,
+           "Low power 1s auto");
+  LowPower(&model[0], &sensor[0], 10000, POWER_MODE_AUTO,
+           "Low power 10s auto");
+  printf("\n");
+
+  // measurement noise of the repeatability: fixed high repeatability against
+  // the tuner, stable air, a humidity ramp and the approach to a threshold
+  Tuner(&model[0], &sensor[0], &stream, false, "Repeatability high, 60s");
+  Tuner(&model[0], &sensor[0], &stream, true,  "Repeatability tuned, 60s");
+  printf("\n");
+
+  // humidity swinging across an alarm threshold at low repeatability, a
+  // plain compare of every sample against the alarm with hysteresis
+  Alarms(&model[0], &sensor[0], &stream);
+
+  if(failures > 0) {
+    printf("\n%u checks failed\n", (unsigned)failures);
+    return 1;
+  }
+
+  printf("\nall checks passed\n");
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+static void Report(const char* operation, etError error, etError expected)
+{
+  tSimStats stats = Sim_GetStats();
+
+  printf("%-28s 0x%02X   %10.1f %10.1f %7u\n", operation, error,
+         stats.busNs / 1000.0, stats.cpuNs / 1000.0, stats.portWrites);
+  if(error != expected) {
+    printf("  FAILED: error code, expected 0x%02X\n", expected);
+    failures++;
+  }
+}
+
+//------------------------------------------------------------------------------
+static void Check(bool passed, const char* check)
+{
+  // printed below the report of the scenario, fails the run
+  if(!passed) {
+    printf("  FAILED: %s\n", check);
+    failures++;
+  }
+}
+
+//------------------------------------------------------------------------------
+static void CheckValues(float temperature, float humidity,
+                        float expectedTemp, float expectedHumi)
+{
+  // one raw step is 0.003°C and 0.002%RH
+  Check(fabsf(temperature - expectedTemp) < 0.01f &&
+        fabsf(humidity - expectedHumi) < 0.01f, "decoded values");
+}
+
+//------------------------------------------------------------------------------
+static void ReportInstr(void)
+{
+#ifdef SHT85_INSTRUMENT
+  static const char* const name[INSTR_NBR_OF_OPS] = {
+    "ReadSerialNumber", "ReadStatus", "ClearAllAlertFlags", "SingleMeasurment",
+    "StartMeasurementAsync", "ProcessAsync", "WriteCommand", "ReadResultRaw",
+    "StartPeriodicMeasurment", "StopPeriodicMeasurment",
+    "ReadMeasurementBuffer", "ReadMeasurementBuffers", "Heater", "SoftReset"
+  };
+  const tInstrStats* stats; // counters of an operation
+  uint8_t            op;    // operation
+
+  printf("%-24s %5s %7s %5s %5s %4s %5s %9s %9s\n", "instrumented call",
+         "calls", "written", "read", "nacks", "crc", "polls", "avg [us]",
+         "max [us]");
+  for(op = 0; op < INSTR_NBR_OF_OPS; op++) {
+    stats = Instr_GetStats((etInstrOp)op);
+    if(stats->calls > 0) {
+      printf("%-24s %5u %7u %5u %5u %4u %5u %9.1f %9.1f\n", name[op],
+             (unsigned)stats->calls, (unsigned)stats->bytesWritten,
+             (unsigned)stats->bytesRead, (unsigned)stats->nacks,
+             (unsigned)stats->crcErrors, (unsigned)stats->polls,
+             (double)stats->cycles / stats->calls / SYSTEM_CYCLES_PER_US,
+             (double)stats->maxCycles / SYSTEM_CYCLES_PER_US);
+    }
+  }
+  printf("\n");
+#endif
+}
+
+//------------------------------------------------------------------------------
+static void PollPeriodic(tSht85* sensor, bool scheduled, const char* operation)
+{
+  tSht85Schedule schedule; // fetch schedule, also used for the statistics
+  uint16_t       rawTemp;  // raw temperature
+  uint16_t       rawHumi;  // raw humidity
+  uint32_t       endMs;    // end of the test [ms]
+  etError        error;    // error code
+
+  Sim_ResetStats();
+  error = SHT85_StartPeriodicMeasurment(sensor, PERI_MEAS_HIGH_1_HZ);
+  SHT85_ScheduleInit(&schedule, PERI_MEAS_HIGH_1_HZ, System_GetTickMs());
+  endMs = System_GetTickMs() + POLL_SECONDS * 1000;
+
+  while(error == NO_ERROR && (int32_t)(System_GetTickMs() - endMs) < 0) {
+    if(scheduled) {
+      Sim_IdleNs((uint64_t)SHT85_ScheduleWaitMs(&schedule, System_GetTickMs())
+                 * 1000000);
+    }
+    error = SHT85_ReadMeasurementBufferRaw(sensor, &rawTemp, &rawHumi);
+    SHT85_ScheduleUpdate(&schedule, error, System_GetTickMs());
+    if(error == ACK_ERROR) error = NO_ERROR;
+    if(!scheduled) {
+      Sim_IdleNs(100000000);
+    }
+  }
+
+  error |= SHT85_StopPeriodicMeasurment(sensor);
+  Report(operation, error, NO_ERROR);
+  printf("  %u fetches, %u samples, %u not ready, %u missed, %u duplicates\n",
+         (unsigned)schedule.fetches, (unsigned)schedule.samples,
+         (unsigned)schedule.notReady, (unsigned)schedule.missed,
+         (unsigned)schedule.duplicates);
+  // 0.5% clock error: up to one sample more or less in the run
+  Check(schedule.samples + 1 >= POLL_SECONDS &&
+        schedule.samples <= POLL_SECONDS + 2, "a sample per period");
+  Check(schedule.missed == 0 && schedule.duplicates == 0,
+        "no missed or duplicate samples");
+
+  // the sensor accepts commands again after the break time
+  Sim_IdleNs(SHT85_BREAK_MS * 1000000ULL);
+}
+
+//------------------------------------------------------------------------------
+static void TimerPeriod(uint16_t periodMs, uint32_t handlerUs,
+                        const char* operation)
+{
+  uint64_t expectedNs; // longest expected interval [ns]
+
+  timerPeriodMs  = periodMs;
+  timerHandlerUs = handlerUs;
+  timerCalls     = 0;
+  timerMaxNs     = 0;
+
+  // the handler sets the period in each interrupt, as the stream does
+  Sim_ResetStats();
+  timerLastNs = Sim_GetTimeNs();
+  System_StartTimer(TIMER_START_MS, TimerCheckHandler);
+  Sim_IdleNs(TIMER_SECONDS * 1000000000ULL);
+  System_StopTimer();
+
+  // the period, or the handler time if the period has passed meanwhile
+  expectedNs = (uint64_t)periodMs * 1000000;
+  if(expectedNs < (uint64_t)handlerUs * 1000) {
+    expectedNs = (uint64_t)handlerUs * 1000;
+  }
+
+  Report(operation, (timerCalls > 1 && timerMaxNs <= expectedNs)
+                    ? NO_ERROR : TIMEOUT_ERROR, NO_ERROR);
+  printf("  %u interrupts, max. interval %.1f ms, expected %.1f ms\n",
+         (unsigned)timerCalls, timerMaxNs / 1e6, expectedNs / 1e6);
+}
+
+//------------------------------------------------------------------------------
+static void TimerCheckHandler(void)
+{
+  uint64_t nowNs = Sim_GetTimeNs(); // time of the interrupt [ns]
+
+  // the first interval is the start period
+  if(timerCalls > 0 && nowNs - timerLastNs > timerMaxNs) {
+    timerMaxNs = nowNs - timerLastNs;
+  }
+  timerLastNs = nowNs;
+  timerCalls++;
+
+  Sim_CpuNs((uint64_t)timerHandlerUs * 1000);
+  System_SetTimerPeriod(timerPeriodMs);
+}
+
+//------------------------------------------------------------------------------
+static void MixedWorkload(tSht85* sensors[], bool queued,
+                          const char* operation)
+{
+  static tSht85Queue queue;    // command queue
+  tSht85Queue*       target = queued ? &queue : 0; // queue, 0 = blocking
+  tSht85QueueStats   stats[SHT85_NBR_OF_PRIOS]; // statistics when blocking
+  tSht85QueueStats*  fetch;    // fetch statistics
+  tSht85QueueStats*  house;    // housekeeping statistics
+  uint32_t           startMs;  // start of the test [ms]
+  uint32_t           nowMs;    // time since the start [ms]
+  uint32_t           waitMs;   // time until the next queue step [ms]
+  uint32_t           t;        // event time [ms]
+  uint32_t           eventMs;  // system time of the event [ms]
+
+  // restart the measurements, the fetches are done in the middle of a period
+  for(t = 0; t < 2; t++) {
+    SHT85_StopPeriodicMeasurment(sensors[t]);
+    Sim_IdleNs(SHT85_BREAK_MS * 1000000ULL);
+    SHT85_StartPeriodicMeasurment(sensors[t], PERI_MEAS_HIGH_10_HZ);
+  }
+
+  SHT85_QueueInit(&queue);
+  memset(stats, 0, sizeof(stats));
+  Sim_ResetStats();
+  startMs = System_GetTickMs();
+
+  for(t = 0; t < MIXED_SECONDS * 1000; t++) {
+    // wait for the event time, execute queued requests meanwhile
+    while((nowMs = System_GetTickMs() - startMs) < t) {
+      waitMs = queued ? SHT85_QueueProcess(&queue, System_GetTickMs())
+                      : SHT85_QUEUE_IDLE;
+      if(waitMs > t - nowMs) waitMs = t - nowMs;
+      Sim_IdleNs((uint64_t)waitMs * 1000000);
+    }
+
+    eventMs = startMs + t;
+    if(t % 100 == 50) {
+      Issue(target, stats, eventMs, sensors[0], CMD_FETCH_DATA,
+            SHT85_PRIO_FETCH, FETCH_DEADLINE_MS);
+      Issue(target, stats, eventMs, sensors[1], CMD_FETCH_DATA,
+            SHT85_PRIO_FETCH, FETCH_DEADLINE_MS);
+    }
+    if(t % 250 == 10) {
+      Issue(target, stats, eventMs, sensors[2], CMD_READ_STATUS,
+            SHT85_PRIO_HOUSEKEEPING, 0);
+      Issue(target, stats, eventMs, sensors[2], CMD_CLEAR_STATUS,
+            SHT85_PRIO_HOUSEKEEPING, 0);
+      Issue(target, stats, eventMs, sensors[2],
+            (t / 250) % 2 ? CMD_HEATER_DISABLE : CMD_HEATER_ENABLE,
+            SHT85_PRIO_HOUSEKEEPING, 0);
+    }
+    if(t % 1000 == 20) {
+      Issue(target, stats, eventMs, sensors[3], CMD_SOFT_RESET,
+            SHT85_PRIO_HOUSEKEEPING, 0);
+    }
+  }
+
+  while(queued && (waitMs = SHT85_QueueProcess(&queue, System_GetTickMs()))
+                  != SHT85_QUEUE_IDLE) {
+    Sim_IdleNs((uint64_t)waitMs * 1000000);
+  }
+
+  if(queued) {
+    memcpy(stats, queue.stats, sizeof(stats));
+  }
+  fetch = &stats[SHT85_PRIO_FETCH];
+  house = &stats[SHT85_PRIO_HOUSEKEEPING];
+
+  Report(operation, (fetch->failed || house->failed) ? ACK_ERROR : NO_ERROR,
+         NO_ERROR);
+  printf("  fetch latency mean %.2f max %u ms, %u of %u after deadline\n"
+         "  housekeeping latency max %u ms, max. queue depth %u\n",
+         fetch->completed ? (double)fetch->latencySumMs / fetch->completed : 0,
+         (unsigned)fetch->latencyMaxMs, (unsigned)fetch->deadlineMisses,
+         (unsigned)fetch->completed, (unsigned)house->latencyMaxMs,
+         (unsigned)queue.maxDepth);
+  Check(fetch->completed == 2 * MIXED_SECONDS * 10, "all fetches done");
+  // the queue runs a fetch before waiting housekeeping, blocking does not
+  Check(!queued || fetch->deadlineMisses == 0, "fetches within the deadline");
+}
+
+//------------------------------------------------------------------------------
+static void Issue(tSht85Queue* queue, tSht85QueueStats stats[],
+                  uint32_t eventMs, tSht85* sensor, etCommands command,
+                  etSht85Priority priority, uint16_t deadlineMs)
+{
+  tSht85QueueStats* stat = &stats[priority]; // statistics when blocking
+  uint32_t          latencyMs;               // latency [ms]
+  uint16_t          data[2];                 // response
+  etError           error;                   // error code
+
+  if(queue) {
+    SHT85_QueueSubmit(queue, sensor, command, priority, deadlineMs, 0, eventMs);
+    return;
+  }
+
+  // blocking: the command is executed when it is issued
+  switch(command) {
+    case CMD_FETCH_DATA:
+      error = SHT85_ReadMeasurementBufferRaw(sensor, &data[0], &data[1]);
+      break;
+    case CMD_READ_STATUS:
+      error = SHT85_ReadStatus(sensor, &data[0]);
+      break;
+    case CMD_SOFT_RESET:
+      error = SHT85_SoftReset(sensor);
+      break;
+    default:
+      error = SHT85_WriteCommand(sensor, command);
+      break;
+  }
+
+  latencyMs = System_GetTickMs() - eventMs;
+  stat->completed++;
+  stat->latencySumMs += latencyMs;
+  if(latencyMs > stat->latencyMaxMs) stat->latencyMaxMs = latencyMs;
+  if(error != NO_ERROR) stat->failed++;
+  if(deadlineMs > 0 && latencyMs > deadlineMs) stat->deadlineMisses++;
+}
+
+//------------------------------------------------------------------------------
+static void BlockingLoop(tSht85* sensor)
+{
+  uint32_t samples = 0; // read samples
+  uint32_t endMs;       // end of the test [ms]
+  float    temperature; // temperature [°C]
+  float    humidity;    // relative humidity [%RH]
+  etError  error;       // error code
+
+  Sim_ResetStats();
+  error = SHT85_StartPeriodicMeasurment(sensor, PERI_MEAS_HIGH_10_HZ);
+  endMs = System_GetTickMs() + TASK_SECONDS * 1000;
+
+  // read the sensor, then wait 100ms in a delay loop
+  while(error == NO_ERROR && (int32_t)(System_GetTickMs() - endMs) < 0) {
+    System_DelayUs(100000);
+    if(SHT85_ReadMeasurementBuffer(sensor, &temperature, &humidity)
+       == NO_ERROR) {
+      samples++;
+    }
+  }
+
+  error |= SHT85_StopPeriodicMeasurment(sensor);
+  Report("Blocking loop 10Hz, 10s", error, NO_ERROR);
+  ReportIdle(samples);
+  Check(samples + 1 >= TASK_SECONDS * 10, "a sample per period");
+}
+
+//------------------------------------------------------------------------------
+static void RunTasks(tSimSht85* model, tSht85* sensor, tSht85Stream* stream,
+                     FILE* telemetry)
+{
+  const tAppStats* stats = App_GetStats(); // application statistics
+  uint32_t         nowMs;                  // time since the start [ms]
+
+  SHT85_Init(sensor, &I2c_DefaultBus, SHT85_I2C_ADDR);
+  I2c_SetTiming(&I2c_TimingFast);
+  Telemetry_Init(TELEMETRY_BAUDRATE);
+  Sim_SetUartOutput(telemetry);
+  Sim_ResetStats();
+  App_Start(sensor, stream);
+
+  // the sensor powers up with the tasks, a checksum fault is injected for a
+  // while to exercise the recovery task
+  do {
+    Task_Step();
+    nowMs = System_GetTickMs();
+    if(nowMs >= FAULT_START_MS && nowMs < FAULT_END_MS) {
+      model->faults = SIM_FAULT_CRC;
+    } else {
+      model->faults = 0;
+    }
+  } while(nowMs < TASK_SECONDS * 1000);
+
+  Report("Tasks 10Hz, 10s", NO_ERROR, NO_ERROR);
+  ReportIdle(stats->samples);
+  printf("  %u recoveries, %u general call resets, %u interrupts, "
+         "%u repeatability changes\n", (unsigned)stats->recoveries,
+         (unsigned)stats->generalCallResets,
+         (unsigned)Sim_GetStats().interrupts, (unsigned)stats->modeChanges);
+  printf("  %u telemetry records, %u dropped, %u UART bytes\n",
+         (unsigned)Telemetry_GetStats()->records,
+         (unsigned)Telemetry_GetStats()->dropped,
+         (unsigned)Sim_GetStats().uartBytes);
+  // samples are lost during the fault and the power-up and recovery after it
+  Check(stats->samples + (FAULT_END_MS - FAULT_START_MS) / 100 + 2 >=
+        TASK_SECONDS * 10, "samples outside of the fault");
+  Check(stats->recoveries > 0, "recovery from the checksum fault");
+  Check(Telemetry_GetStats()->dropped == 0, "no telemetry records dropped");
+
+  // the telemetry burst afterwards must not write to the closed file
+  Sim_SetUartOutput(0);
+  if(telemetry) {
+    fclose(telemetry);
+  }
+}
+
+//------------------------------------------------------------------------------
+static void TelemetryBurst(void)
+{
+  const tTelemetryStats* stats = Telemetry_GetStats(); // telemetry statistics
+  tTelemetryRecord       record;                       // written record
+  uint16_t               i;                            // record index
+
+  // one record per ms, more than 115200 baud can carry: the writes never
+  // wait, the records that do not fit are dropped
+  Telemetry_Init(TELEMETRY_BAUDRATE);
+  Sim_ResetStats();
+  for(i = 0; i < BURST_RECORDS; i++) {
+    record.timeMs   = System_GetTickMs();
+    record.sensorId = (uint8_t)i;
+    record.error    = NO_ERROR;
+    record.rawTemp  = 0x6666;
+    record.rawHumi  = 0x8000;
+    Sim_CpuNs(20000); // encoding and copy of the record
+    Telemetry_Write(&record);
+    Sim_IdleNs(1000000 - 20000);
+  }
+
+  printf("Telemetry burst 1kHz, 1s: %u records, %u dropped, %u transfers, "
+         "UART load %.1f%%\n", (unsigned)stats->records,
+         (unsigned)stats->dropped, (unsigned)stats->transfers,
+         100.0 * Sim_GetStats().uartBytes * 10 / TELEMETRY_BAUDRATE);
+  Check(stats->records + stats->dropped == BURST_RECORDS,
+        "every record sent or counted as dropped");
+}
+
+//------------------------------------------------------------------------------
+static void ReportIdle(uint32_t samples)
+{
+  tSimStats stats = Sim_GetStats();
+
+  printf("  %u samples, CPU idle %.1f%%\n", (unsigned)samples,
+         100.0 * stats.idleNs / (stats.idleNs + stats.cpuNs));
+}
+
+//------------------------------------------------------------------------------
+static void LowPower(tSimSht85* model, tSht85* sensor, uint32_t intervalMs,
+                     etPowerMode mode, const char* operation)
+{
+  tPowerLogger logger;      // low power logger
+  tSimStats    stats;       // simulator statistics
+  uint64_t     measureNs;   // sensor measuring [ns]
+  uint64_t     periodicNs;  // sensor in periodic mode [ns]
+  uint64_t     measureNs0;  // sensor measuring at the start [ns]
+  uint64_t     periodicNs0; // sensor in periodic mode at the start [ns]
+  uint64_t     startNs;     // start of the run [ns]
+  uint64_t     timeNs;      // duration of the run [ns]
+  double       chargeNc;    // charge of controller and sensor [nC]
+  uint16_t     rawTemp;     // raw temperature
+  uint16_t     rawHumi;     // raw humidity
+  uint8_t      i;           // sample index
+  etError      error;       // error code
+
+  Sim_ResetStats();
+  startNs = Sim_GetTimeNs();
+  SimSht85_GetActivity(model, &measureNs0, &periodicNs0);
+  error = Power_LoggerStart(&logger, sensor, intervalMs, SINGLE_MEAS_HIGH,
+                            mode);
+  for(i = 0; i < LOW_POWER_SAMPLES && error == NO_ERROR; i++) {
+    error = Power_LoggerSample(&logger, &rawTemp, &rawHumi);
+  }
+  error |= Power_LoggerStop(&logger);
+
+  // charge from the time in each state and the typical currents, nA * ns
+  stats = Sim_GetStats();
+  SimSht85_GetActivity(model, &measureNs, &periodicNs);
+  measureNs  -= measureNs0;
+  periodicNs -= periodicNs0;
+  timeNs      = Sim_GetTimeNs() - startNs;
+  chargeNc = ((double)POWER_RUN_NA * stats.cpuNs +
+              (double)POWER_SLEEP_NA * stats.idleNs +
+              (double)POWER_STOP_NA * stats.stopNs +
+              (double)POWER_SENSOR_MEASURE_NA * measureNs +
+              (double)POWER_SENSOR_PERIODIC_NA * periodicNs +
+              (double)POWER_SENSOR_IDLE_NA * (timeNs - periodicNs)) /
+             1e9;
+
+  Report(operation, error, NO_ERROR);
+  printf("  %s mode, %u samples, %u wake-ups, stop %.1f%%, "
+         "%.2f uJ per sample (estimate %.2f uJ)\n",
+         logger.periodic ? "periodic" : "single shot",
+         (unsigned)logger.samples, (unsigned)logger.wakeups,
+         100.0 * stats.stopNs / timeNs,
+         logger.samples ? chargeNc * POWER_SUPPLY_MV / 1e6 / logger.samples
+                        : 0.0,
+         Power_EstimateChargeNc(intervalMs, SINGLE_MEAS_HIGH,
+                                logger.periodic) * POWER_SUPPLY_MV / 1e6);
+  Check(logger.samples == LOW_POWER_SAMPLES, "all samples taken");
+  Check(mode == POWER_MODE_AUTO ||
+        logger.periodic == (mode == POWER_MODE_PERIODIC), "mode");
+  Check(chargeNc <= Power_EstimateChargeNc(intervalMs, SINGLE_MEAS_HIGH,
+                                           logger.periodic) *
+                    logger.samples, "charge within the estimate");
+
+  // the sensor accepts commands again after the break time
+  Sim_IdleNs(SHT85_BREAK_MS * 1000000ULL);
+}
+
+//------------------------------------------------------------------------------
+static void Aggregation(bool rolling, const char* operation)
+{
+  static tAggregateSample buffer[AGGREGATE_LENGTH];     // rolling window
+  static int16_t          temperatures[AGGREGATE_SAMPLES]; // [0.01°C]
+  static int16_t          humidities[AGGREGATE_SAMPLES];   // [0.01%RH]
+  tAggregate              aggregate;                    // aggregator
+  tAggregateSummary       summary;                      // window summary
+  uint32_t                seed = 1;                     // noise generator
+  uint32_t                summaries = 0;                // emitted summaries
+  uint16_t                rawTemp;                      // raw temperature
+  uint16_t                rawHumi;                      // raw humidity
+  uint16_t                i;                            // sample index
+  double                  meanError = 0;     // max. error of the mean
+  double                  varianceError = 0; // max. relative variance error
+
+  if(rolling) {
+    Aggregate_InitRolling(&aggregate, AGGREGATE_LENGTH, AGGREGATE_HOP,
+                          buffer);
+  } else {
+    Aggregate_InitTumbling(&aggregate, AGGREGATE_LENGTH);
+  }
+
+  // slow ramp with noise of +-0.5°C / +-2%RH, compared against a double
+  // precision two-pass computation over the same samples
+  for(i = 0; i < AGGREGATE_SAMPLES; i++) {
+    seed    = seed * 1103515245 + 12345;
+    rawTemp = (uint16_t)(0x6000 + i * 4 + ((seed >> 16) % 375) - 187);
+    rawHumi = (uint16_t)(0x8000 - i * 2 + ((seed >> 8) % 2621) - 1310);
+    temperatures[i] = SHT85_CalcTemperatureCenti(rawTemp);
+    humidities[i]   = (int16_t)SHT85_CalcHumidityCenti(rawHumi);
+
+    if(Aggregate_Add(&aggregate, i * 100, rawTemp, rawHumi, &summary)) {
+      summaries++;
+      CheckSummary(&summary, &temperatures[i + 1 - summary.count],
+                   summary.count, false, &meanError, &varianceError);
+      CheckSummary(&summary, &humidities[i + 1 - summary.count],
+                   summary.count, true, &meanError, &varianceError);
+    }
+  }
+
+  printf("%s: %u summaries, %.1fx less data, mean error max %.3f, "
+         "variance error max %.4f%%\n", operation, (unsigned)summaries,
+         (double)AGGREGATE_SAMPLES * TELEMETRY_RECORD_SIZE /
+         (summaries * TELEMETRY_SUMMARY_SIZE), meanError,
+         100.0 * varianceError);
+}
+
+//------------------------------------------------------------------------------
+static void CheckSummary(const tAggregateSummary* summary,
+                         const int16_t values[], uint16_t count,
+                         bool humidity, double* meanError,
+                         double* varianceError)
+{
+  const tAggregateStats* stats; // checked statistics
+  double                 mean = 0;     // reference mean
+  double                 variance = 0; // reference variance
+  int16_t                min = values[0];
+  int16_t                max = values[0];
+  uint16_t               i;
+
+  stats = humidity ? &summary->humidity : &summary->temperature;
+
+  for(i = 0; i < count; i++) {
+    mean += values[i];
+    if(values[i] < min) min = values[i];
+    if(values[i] > max) max = values[i];
+  }
+  mean /= count;
+  for(i = 0; i < count; i++) {
+    variance += (values[i] - mean) * (values[i] - mean);
+  }
+  variance /= count - 1;
+
+  if(stats->min != min || stats->max != max) {
+    printf("  min/max %d/%d, expected %d/%d\n", stats->min, stats->max, min,
+           max);
+  }
+  Check(stats->min == min && stats->max == max, "summary min/max");
+  if(fabs(stats->mean - mean) > *meanError) {
+    *meanError = fabs(stats->mean - mean);
+  }
+  if(fabs(stats->variance - variance) / variance > *varianceError) {
+    *varianceError = fabs(stats->variance - variance) / variance;
+  }
+  Check(fabs(stats->mean - mean) <= AGGREGATE_MEAN_ERROR, "summary mean");
+  Check(fabs(stats->variance - variance) / variance <= AGGREGATE_VAR_ERROR,
+        "summary variance");
+}
+
+//------------------------------------------------------------------------------
+static void DerivedQuantities(void)
+{
+  uint32_t          rawTemp;           // raw temperature
+  uint32_t          rawHumi;           // raw humidity
+  uint32_t          conversions = 0;   // conversions per quantity
+  double            temperature;       // exact temperature [°C]
+  double            gamma;             // Magnus gamma
+  double            vaporPressure;     // vapor pressure [Pa]
+  double            dewPointError = 0; // max. dew point error [°C]
+  double            absHumiError = 0;  // max. absolute humidity error [g/m^3]
+  double            mixingError = 0;   // max. mixing ratio error [g/kg]
+  double            relativeError = 0; // max. relative error above 10
+  double            reference;         // reference value
+  double            error;             // error of one conversion
+  clock_t           start;             // benchmark start
+  double            fixedNs;           // fixed-point time per conversion [ns]
+  double            floatNs;           // float time per conversion [ns]
+  float             gammaFloat;        // Magnus gamma, float
+  float             temperatureFloat;  // temperature [°C], float
+  volatile int32_t  sink = 0;          // keeps the fixed-point loop
+  volatile float    sinkFloat = 0;     // keeps the float loop
+
+  // grid over -45..60°C and 1..100%RH, reference in double precision with
+  // the exact temperature and humidity of the raw values
+  for(rawTemp = 0; rawTemp <= DERIVED_RAW_TEMP_MAX;
+      rawTemp += DERIVED_STEP_TEMP) {
+    for(rawHumi = DERIVED_RAW_HUMI_MIN; rawHumi <= 0xFFFF;
+        rawHumi += DERIVED_STEP_HUMI) {
+      temperature   = -45.0 + 175.0 * rawTemp / 65535.0;
+      gamma         = log(rawHumi / 65535.0) +
+                      17.62 * temperature / (243.12 + temperature);
+      vaporPressure = 611.2 * exp(gamma);
+
+      error = fabs(SHT85_CalcDewPointCenti((uint16_t)rawTemp,
+                                           (uint16_t)rawHumi) / 100.0 -
+                   243.12 * gamma / (17.62 - gamma));
+      if(error > dewPointError) dewPointError = error;
+
+      reference = 2.167 * vaporPressure / (temperature + 273.15);
+      error = fabs(SHT85_CalcAbsHumidityCenti((uint16_t)rawTemp,
+                                              (uint16_t)rawHumi) / 100.0 -
+                   reference);
+      if(error > absHumiError) absHumiError = error;
+      if(reference > 10 && error / reference > relativeError) {
+        relativeError = error / reference;
+      }
+
+      reference = 621.97 * vaporPressure /
+                  (SHT85_PRESSURE_STANDARD_PA - vaporPressure);
+      error = fabs(SHT85_CalcMixingRatioCenti((uint16_t)rawTemp,
+                                              (uint16_t)rawHumi,
+                                              SHT85_PRESSURE_STANDARD_PA)
+                   / 100.0 - reference);
+      if(error > mixingError) mixingError = error;
+      if(reference > 10 && error / reference > relativeError) {
+        relativeError = error / reference;
+      }
+
+      conversions++;
+    }
+  }
+
+  printf("Derived quantities: %u points, max error dew point %.3f°C, "
+         "absolute humidity %.3fg/m^3, mixing ratio %.3fg/kg (%.3f%%)\n",
+         (unsigned)conversions, dewPointError, absHumiError, mixingError,
+         100.0 * relativeError);
+  Check(dewPointError < DERIVED_DEW_POINT_ERROR, "dew point error");
+  Check(absHumiError < DERIVED_ABS_HUMI_ERROR, "absolute humidity error");
+  Check(mixingError < DERIVED_MIXING_ERROR, "mixing ratio error");
+  Check(relativeError < DERIVED_RELATIVE_ERROR, "relative error");
+
+  // host time per dew point conversion, fixed-point and with logf/expf; this
+  // shows the relation only, the cycles on the Cortex-M3 without FPU differ
+  start = clock();
+  for(rawTemp = 0; rawTemp <= DERIVED_RAW_TEMP_MAX;
+      rawTemp += DERIVED_STEP_TEMP) {
+    for(rawHumi = DERIVED_RAW_HUMI_MIN; rawHumi <= 0xFFFF;
+        rawHumi += DERIVED_STEP_HUMI) {
+      sink += SHT85_CalcDewPointCenti((uint16_t)rawTemp, (uint16_t)rawHumi);
+    }
+  }
+  fixedNs = (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / conversions;
+
+  start = clock();
+  for(rawTemp = 0; rawTemp <= DERIVED_RAW_TEMP_MAX;
+      rawTemp += DERIVED_STEP_TEMP) {
+    for(rawHumi = DERIVED_RAW_HUMI_MIN; rawHumi <= 0xFFFF;
+        rawHumi += DERIVED_STEP_HUMI) {
+      temperatureFloat = -45.0f + 175.0f * (float)rawTemp / 65535.0f;
+      gammaFloat = logf((float)rawHumi / 65535.0f) +
+                   17.62f * temperatureFloat / (243.12f + temperatureFloat);
+      sinkFloat += 243.12f * gammaFloat / (17.62f - gammaFloat);
+    }
+  }
+  floatNs = (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / conversions;
+
+  printf("Derived quantities: dew point %.1fns fixed-point, %.1fns float "
+         "per conversion on the host\n", fixedNs, floatNs);
+}
+
+//------------------------------------------------------------------------------
+static void HeaterRecovery(tSimSht85* model, tSht85* sensor,
+                           tSht85Stream* stream)
+{
+  static tSht85Heater heater;                     // heater controller
+  tSht85Sample samples[SHT85_STREAM_SIZE];        // samples read from stream
+  uint8_t      nbrOfRead;                         // number of read samples
+  uint8_t      i;                                 // sample index
+  uint32_t     endMs;                             // end of the test [ms]
+  uint32_t     firstMs = 0;                       // first sample [ms]
+  uint16_t     periodMs;                          // measurement period [ms]
+  int32_t      offset;                            // fetch phase [ms]
+  int32_t      phaseMin[2] = {1000, 1000};        // before and after pulse
+  int32_t      phaseMax[2] = {-1000, -1000};
+  float        humidity[2] = {0, 0};              // last humidity [%RH]
+  bool         after;                             // sample after the pulse
+  etError      error;                             // error code
+
+  Sim_Reset();
+  SimSht85_Init(model, GPIOB, 0x0200, 0x0100);
+  SimSht85_SetEnvironment(model, 18.0f, 88.0f);
+  model->environment = CondensingEnvironment;
+  SHT85_Init(sensor, &I2c_DefaultBus, SHT85_I2C_ADDR);
+  I2c_SetTiming(&I2c_TimingFast);
+  Sim_IdleNs(50000000);
+
+  Sim_ResetStats();
+  SHT85_StreamInit(stream, sensor);
+  SHT85_HeaterInit(&heater, stream, PERI_MEAS_HIGH_10_HZ,
+                   SHT85_HUMIDITY_TO_RAW(95), HEATER_SUSTAIN_MS,
+                   HEATER_PULSE_MS, HEATER_SETTLE_MS);
+  error = SHT85_StreamStart(stream, PERI_MEAS_HIGH_10_HZ);
+  endMs = System_GetTickMs() + HEATER_SECONDS * 1000;
+
+  // the loop of the measurement task, the fetch phase of the samples before
+  // and after the pulse is compared
+  while(error == NO_ERROR && (int32_t)(System_GetTickMs() - endMs) < 0) {
+    if(SHT85_HeaterActive(&heater)) {
+      Sim_IdleNs((uint64_t)SHT85_HeaterWaitMs(&heater, System_GetTickMs())
+                 * 1000000);
+      error = SHT85_HeaterStep(&heater);
+      continue;
+    }
+
+    Sim_IdleNs(10000000);
+    error = SHT85_StreamRead(stream, samples, SHT85_STREAM_SIZE, &nbrOfRead);
+    for(i = 0; i < nbrOfRead; i++) {
+      if(!SHT85_HeaterCheck(&heater, &samples[i])) {
+        continue;
+      }
+      if(firstMs == 0) {
+        firstMs = samples[i].timeMs;
+      }
+      after  = heater.pulses > 0;
+      // phase relative to the first sample, -period/2..period/2
+      periodMs = stream->schedule.periodMs;
+      offset   = (int32_t)((samples[i].timeMs - firstMs + periodMs / 2) %
+                           periodMs) - periodMs / 2;
+      if(offset < phaseMin[after]) phaseMin[after] = offset;
+      if(offset > phaseMax[after]) phaseMax[after] = offset;
+      humidity[after] = SHT85_CalcHumidityCenti(samples[i].rawHumi) / 100.0f;
+    }
+  }
+
+  error |= SHT85_StreamStop(stream);
+  Report("Heater recovery 10Hz, 40s", error, NO_ERROR);
+  printf("  %u pulses, %u samples dropped, %u verify errors, %u samples, "
+         "%u missed\n", (unsigned)heater.pulses, (unsigned)heater.dropped,
+         (unsigned)heater.verifyErrors, (unsigned)stream->schedule.samples,
+         (unsigned)stream->schedule.missed);
+  printf("  before: %.2f%%RH, phase %d..%dms; after: %.2f%%RH, phase "
+         "%d..%dms\n", humidity[0], (int)phaseMin[0], (int)phaseMax[0],
+         humidity[1], (int)phaseMin[1], (int)phaseMax[1]);
+  Check(heater.pulses == 1 && heater.verifyErrors == 0, "one heater pulse");
+  Check(stream->schedule.missed == 0, "no missed samples");
+  Check(humidity[1] < 95.0f, "sensor dried by the pulse");
+  // the stream starts again in its phase, within a few ms
+  Check(phaseMin[1] > -10 && phaseMax[1] < 10, "phase after the pulse");
+}
+
+//------------------------------------------------------------------------------
+static void CondensingEnvironment(tSimSht85* model, uint64_t timeNs,
+                                  float* temperature, float* humidity)
+{
+  double heatT; // remaining heater temperature increase [°C]
+
+  // condensed water reads as saturated until the heater has dried it
+  if(model->heaterNs < HEATER_DRY_NS) {
+    *humidity = 100.0f;
+  }
+
+  // after a pulse the sensor cools down, it reads too warm and too dry
+  if(model->heaterNs > 0) {
+    heatT = model->heaterDeltaT *
+            exp(-(double)(timeNs - model->heaterOffNs) / HEATER_COOLING_NS);
+    *humidity    *= (float)exp(-17.62 * 243.12 * heatT /
+                               ((*temperature + 243.12) *
+                                (*temperature + 243.12)));
+    *temperature += (float)heatT;
+  }
+}
+
+//------------------------------------------------------------------------------
+static void HealthMonitor(tSht85* sensor, tSht85Stream* stream,
+                          uint16_t interval, const char* operation)
+{
+  tSht85Sample samples[SHT85_STREAM_SIZE]; // samples read from the stream
+  uint8_t      nbrOfRead;                  // number of read samples
+  uint32_t     startMs;                    // start of the stream [ms]
+  uint32_t     nowMs;                      // time since the start [ms]
+  uint32_t     lastMs = 0;                 // last sample [ms]
+  uint32_t     resetMs = 0;                // sensor reset [ms]
+  etError      error = NO_ERROR;           // error code
+
+  Sim_IdleNs(50000000);
+  Sim_ResetStats();
+  SHT85_StreamInit(stream, sensor);
+  SHT85_HealthInit(&stream->health, interval);
+  SHT85_StreamStart(stream, PERI_MEAS_HIGH_10_HZ);
+  startMs = System_GetTickMs();
+
+  // a reset (a soft reset here, like a brown-out) ends the periodic mode, the
+  // fetches are NACKed from then on
+  do {
+    Sim_IdleNs(10000000);
+    nowMs = System_GetTickMs() - startMs;
+    if(resetMs == 0 && nowMs >= HEALTH_RESET_MS) {
+      resetMs = nowMs;
+      SHT85_SoftReset(sensor);
+    }
+    error = SHT85_StreamRead(stream, samples, SHT85_STREAM_SIZE, &nbrOfRead);
+    if(nbrOfRead > 0) {
+      lastMs = samples[nbrOfRead - 1].timeMs - startMs;
+    }
+    nowMs = System_GetTickMs() - startMs;
+  } while(error == NO_ERROR && nowMs < HEALTH_SECONDS * 1000);
+
+  SHT85_StreamStop(stream);
+  Report(operation, error, interval > 0 ? RESET_ERROR : NO_ERROR);
+  // found within interval fetches of the 10Hz stream
+  Check(interval == 0 || nowMs - resetMs <= (interval + 1) * 100U,
+        "reset found within the interval");
+  if(error == RESET_ERROR) {
+    printf("  reset found within %ums, %u status reads, %u fetches NACKed\n",
+           (unsigned)(nowMs - resetMs), (unsigned)stream->health.checks,
+           (unsigned)stream->schedule.notReady);
+  } else {
+    printf("  reset not found, %u fetches NACKed since the last sample "
+           "%ums ago\n", (unsigned)stream->schedule.notReady,
+           (unsigned)(nowMs - lastMs));
+  }
+
+  // the sensor accepts commands again after the break time
+  Sim_IdleNs(SHT85_BREAK_MS * 1000000ULL);
+}
+
+//------------------------------------------------------------------------------
+static void BusClear(tSimSht85* model, tSht85* sensor)
+{
+  uint16_t status; // status register
+  etError  error;  // error code
+
+  Sim_Reset();
+  SimSht85_Init(model, GPIOB, 0x0200, 0x0100);
+  SHT85_Init(sensor, &I2c_DefaultBus, SHT85_I2C_ADDR);
+  I2c_SetTiming(&I2c_TimingFast);
+  Sim_IdleNs(50000000);
+
+  SimSht85_HoldSda(model);
+  Sim_ResetStats();
+  error = I2c_BusClear();
+  Report("Bus clear, SDA held low", error, NO_ERROR);
+
+  Sim_ResetStats();
+  error = SHT85_ReadStatus(sensor, &status);
+  Report("ReadStatus after bus clear", error, NO_ERROR);
+}
+
+//------------------------------------------------------------------------------
+static void SharedBusRecovery(tSht85Stream* stream, uint32_t minBackoffMs,
+                              uint32_t maxBackoffMs, const char* operation)
+{
+  static tSimSht85      model[2];    // healthy and dead sensor
+  static tSht85         sensor[2];   // sensor instances
+  static tSht85Recovery recovery[2]; // recovery of the sensors
+  tSht85Sample samples[SHT85_STREAM_SIZE]; // samples read from the stream
+  uint8_t      nbrOfRead;                  // number of read samples
+  uint32_t     nbrOfSamples = 0;           // samples of the healthy sensor
+  uint32_t     startMs;                    // start of the test [ms]
+  uint32_t     nowMs;                      // time since the start [ms]
+  uint32_t     glitchMs = 0;               // error of the glitch [ms]
+  uint32_t     backMs   = 0;               // first sample after it [ms]
+  uint64_t     deadNs   = 0;               // bus time of the dead sensor
+  tSimStats    before;                     // statistics before a step
+  uint8_t      i;                          // sensor index
+  etError      error;                      // error code
+
+  // both sensors on the same bus, the second one never answers
+  Sim_Reset();
+  for(i = 0; i < 2; i++) {
+    SimSht85_Init(&model[i], GPIOB, 0x0200, 0x0100);
+  }
+  model[1].address = RECOVERY_DEAD_ADDR;
+  model[1].faults  = SIM_FAULT_NACK;
+  SHT85_Init(&sensor[0], &I2c_DefaultBus, SHT85_I2C_ADDR);
+  SHT85_Init(&sensor[1], &I2c_DefaultBus, RECOVERY_DEAD_ADDR);
+  I2c_SetTiming(&I2c_TimingFast);
+  Sim_IdleNs(50000000);
+
+  Sim_ResetStats();
+  SHT85_StreamInit(stream, &sensor[0]);
+  SHT85_HealthInit(&stream->health, HEALTH_INTERVAL);
+  SHT85_RecoveryInit(&recovery[0], &sensor[0], stream, PERI_MEAS_HIGH_10_HZ,
+                     10, 10000);
+  SHT85_RecoveryInit(&recovery[1], &sensor[1], 0, PERI_MEAS_HIGH_10_HZ,
+                     minBackoffMs, maxBackoffMs);
+
+  // the dead sensor is found at the start, the general call reset of its
+  // first attempt is over before the stream starts
+  SHT85_RecoveryStart(&recovery[1]);
+  SHT85_RecoveryStep(&recovery[1]);
+  Sim_IdleNs(SHT85_RECOVERY_RESET_MS * 1000000);
+  error   = SHT85_StreamStart(stream, PERI_MEAS_HIGH_10_HZ);
+  startMs = System_GetTickMs();
+
+  // the loop of the application, in steps of 1ms
+  do {
+    Sim_IdleNs(1000000);
+    nowMs = System_GetTickMs() - startMs;
+    model[0].faults = (nowMs >= RECOVERY_GLITCH_MS &&
+                       nowMs < RECOVERY_GLITCH_END_MS) ? SIM_FAULT_CRC : 0;
+
+    for(i = 0; i < 2; i++) {
+      if(SHT85_RecoveryActive(&recovery[i]) &&
+         SHT85_RecoveryWaitMs(&recovery[i], System_GetTickMs()) == 0) {
+        before = Sim_GetStats();
+        SHT85_RecoveryStep(&recovery[i]);
+        if(i == 1) {
+          deadNs += Sim_GetStats().busNs - before.busNs;
+        }
+      }
+    }
+
+    if(!SHT85_RecoveryActive(&recovery[0])) {
+      error = SHT85_StreamRead(stream, samples, SHT85_STREAM_SIZE,
+                               &nbrOfRead);
+      nbrOfSamples += nbrOfRead;
+      if(nbrOfRead > 0 && glitchMs > 0 && backMs == 0) {
+        backMs = samples[0].timeMs - startMs;
+      }
+      if(error != NO_ERROR) {
+        if(glitchMs == 0) {
+          glitchMs = nowMs;
+        }
+        SHT85_RecoveryStart(&recovery[0]);
+      }
+    }
+  } while(nowMs < RECOVERY_SECONDS * 1000);
+
+  SHT85_StreamStop(stream);
+  Report(operation, NO_ERROR, NO_ERROR);
+  printf("  0x%02X: %u samples, %u recoveries, %u attempts, back %ums after "
+         "the glitch\n", SHT85_I2C_ADDR, (unsigned)nbrOfSamples,
+         (unsigned)recovery[0].recoveries, (unsigned)recovery[0].attempts,
+         (unsigned)(backMs - glitchMs));
+  printf("  0x%02X: %u attempts, %u general calls, max. %u in a row, "
+         "%.1f%% of the bus time\n", RECOVERY_DEAD_ADDR,
+         (unsigned)recovery[1].attempts, (unsigned)recovery[1].generalCalls,
+         (unsigned)recovery[1].maxInRow,
+         100.0 * deadNs / (RECOVERY_SECONDS * 1000000000.0));
+  Check(nbrOfSamples + 2 >= RECOVERY_SECONDS * 10,
+        "samples of the healthy sensor");
+  Check(recovery[0].recoveries > 0 && backMs > glitchMs &&
+        backMs - glitchMs <= RECOVERY_BACK_MS, "back after the glitch");
+  // the backoff keeps the dead sensor below 1% of the bus time
+  Check(minBackoffMs == maxBackoffMs ||
+        deadNs < RECOVERY_SECONDS * 10000000ULL, "bus time of the dead sensor");
+}
+
+//------------------------------------------------------------------------------
+static void Tuner(tSimSht85* model, tSht85* sensor, tSht85Stream* stream,
+                  bool tuned, const char* operation)
+{
+  static const char* const levelName[] = {"low", "medium", "high"};
+  tSht85Tuner  tuner;                          // repeatability tuner
+  tSht85Sample samples[SHT85_STREAM_SIZE];     // samples read from the stream
+  etPeriodicMeasureModes measureMode = PERI_MEAS_HIGH_10_HZ; // stream mode
+  uint8_t      nbrOfRead;                      // number of read samples
+  uint8_t      i;                              // sample index
+  uint32_t     nbrOfSamples = 0;               // samples of the run
+  uint32_t     nbrOfGuard   = 0;               // samples in the guard band
+  double       sumTemp      = 0;               // squared errors [°C²]
+  double       sumHumi      = 0;               // squared errors [%RH²]
+  double       sumGuard     = 0;               // same in the guard band
+  double       errTemp;                        // temperature error [°C]
+  double       errHumi;                        // humidity error [%RH]
+  float        temperature;                    // true temperature [°C]
+  float        humidity;                       // true humidity [%RH]
+  uint64_t     measureNs;                      // sensor measuring [ns]
+  uint64_t     periodicNs;                     // sensor in periodic mode [ns]
+  uint64_t     endNs;                          // end of the run [ns]
+  bool         retune;                         // repeatability changed
+  etError      error;                          // error code
+
+  Sim_Reset();
+  SimSht85_Init(model, GPIOB, 0x0200, 0x0100);
+  model->environment = TunerEnvironment;
+  model->noise       = true;
+  SHT85_Init(sensor, &I2c_DefaultBus, SHT85_I2C_ADDR);
+  I2c_SetTiming(&I2c_TimingFast);
+  Sim_IdleNs(50000000);
+
+  SHT85_TunerInit(&tuner, SHT85_TEMPERATURE_DIFF_TO_RAW(TUNER_NOISE_T),
+                  SHT85_HUMIDITY_TO_RAW(TUNER_NOISE_RH),
+                  SHT85_TEMPERATURE_DIFF_TO_RAW(0.02),
+                  SHT85_HUMIDITY_TO_RAW(0.03), TUNER_HOLD_SAMPLES);
+  SHT85_TunerAddThreshold(&tuner, true,
+                          SHT85_HUMIDITY_TO_RAW(TUNER_THRESHOLD),
+                          SHT85_HUMIDITY_TO_RAW(TUNER_GUARD));
+
+  Sim_ResetStats();
+  tunerStartNs = Sim_GetTimeNs();
+  endNs        = tunerStartNs + TUNER_SECONDS * 1000000000ULL;
+  SHT85_StreamInit(stream, sensor);
+  error = SHT85_StreamStart(stream, measureMode);
+
+  while(error == NO_ERROR && Sim_GetTimeNs() < endNs) {
+    Sim_IdleNs(100000000);
+    error  = SHT85_StreamRead(stream, samples, SHT85_STREAM_SIZE, &nbrOfRead);
+    retune = false;
+
+    for(i = 0; i < nbrOfRead; i++) {
+      // error against the environment at the fetch, the conversion ends a
+      // few ms before
+      TunerTruth((uint64_t)samples[i].timeMs * 1000000, &temperature,
+                 &humidity);
+      errTemp  = SHT85_CalcTemperatureCenti(samples[i].rawTemp) / 100.0 -
+                 temperature;
+      errHumi  = SHT85_CalcHumidityCenti(samples[i].rawHumi) / 100.0 -
+                 humidity;
+      sumTemp += errTemp * errTemp;
+      sumHumi += errHumi * errHumi;
+      if(fabsf(humidity - TUNER_THRESHOLD) <= TUNER_GUARD) {
+        sumGuard += errHumi * errHumi;
+        nbrOfGuard++;
+      }
+      nbrOfSamples++;
+
+      if(tuned) {
+        retune |= SHT85_TunerUpdate(&tuner, samples[i].rawTemp,
+                                    samples[i].rawHumi);
+      } else {
+        tuner.samples[SHT85_TUNER_HIGH]++;
+      }
+    }
+
+    if(error == NO_ERROR && retune) {
+      measureMode = SHT85_TunerPeriodicMode(&tuner, measureMode);
+      error = SHT85_StreamStop(stream);
+      System_DelayUs(SHT85_BREAK_MS * 1000);
+      if(error == NO_ERROR) {
+        error = SHT85_StreamStart(stream, measureMode);
+      }
+    }
+  }
+
+  error |= SHT85_StreamStop(stream);
+  SimSht85_GetActivity(model, &measureNs, &periodicNs);
+
+  Report(operation, error, NO_ERROR);
+  printf("  %u samples, %u changes, conversion %.2f ms, bus %.1f us per "
+         "sample\n", (unsigned)nbrOfSamples, (unsigned)tuner.changes,
+         nbrOfSamples ? measureNs / 1e6 / nbrOfSamples : 0.0,
+         nbrOfSamples ? Sim_GetStats().busNs / 1000.0 / nbrOfSamples : 0.0);
+  printf("  samples");
+  for(i = 0; i < 3; i++) {
+    printf(" %s %.1f%%", levelName[i],
+           nbrOfSamples ? 100.0 * tuner.samples[i] / nbrOfSamples : 0.0);
+  }
+  printf("\n  rms error %.3f degC, %.3f %%RH, %.3f %%RH within %.0f%%RH of "
+         "%.0f%%RH\n", nbrOfSamples ? sqrt(sumTemp / nbrOfSamples) : 0.0,
+         nbrOfSamples ? sqrt(sumHumi / nbrOfSamples) : 0.0,
+         nbrOfGuard ? sqrt(sumGuard / nbrOfGuard) : 0.0, TUNER_GUARD,
+         TUNER_THRESHOLD);
+  Check(nbrOfSamples + 1 >= TUNER_SECONDS * 10, "a sample per period");
+  Check(tuned ? tuner.changes > 0 : tuner.changes == 0, "changes");
+  Check(nbrOfSamples > 0 &&
+        sqrt(sumTemp / nbrOfSamples) <= TUNER_NOISE_T &&
+        sqrt(sumHumi / nbrOfSamples) <= TUNER_NOISE_RH, "noise");
+
+  model->environment = 0;
+  model->noise       = false;
+}
+
+//------------------------------------------------------------------------------
+static void TunerEnvironment(tSimSht85* model, uint64_t timeNs,
+                             float* temperature, float* humidity)
+{
+  TunerTruth(timeNs, temperature, humidity);
+}
+
+//------------------------------------------------------------------------------
+static void TunerTruth(uint64_t timeNs, float* temperature, float* humidity)
+{
+  double t = (double)(timeNs - tunerStartNs) / 1e9; // time of the run [s]
+
+  // stable 15s, +6%RH in 10s, stable 15s, then +4.5%RH in 20s across the
+  // guard band of the threshold
+  *temperature = 23.5f;
+  if(t < 15) {
+    *humidity = 60.0f;
+  } else if(t < 25) {
+    *humidity = (float)(60.0 + 0.6 * (t - 15));
+  } else if(t < 40) {
+    *humidity = 66.0f;
+  } else {
+    *humidity = (float)(66.0 + 0.225 * (t - 40));
+  }
+}
+
+//------------------------------------------------------------------------------
+static void Alarms(tSimSht85* model, tSht85* sensor, tSht85Stream* stream)
+{
+  static tSht85Alarm alarm;                    // alarms of the sensor
+  tSht85Sample samples[SHT85_STREAM_SIZE];     // samples read from the stream
+  uint8_t      nbrOfRead;                      // number of read samples
+  uint8_t      i;                              // sample index
+  uint8_t      state = 0;                      // alarm state
+  uint8_t      last;                           // alarm state before a sample
+  bool         high = false;                   // plain compare above
+  uint32_t     toggles = 0;                    // changes of the plain compare
+  uint32_t     changes = 0;                    // changes of the alarm
+  uint32_t     rateAlarms = 0;                 // temperature rate alarms
+  double       t;                              // time of a sample [s]
+  double       crossing;                       // true crossing [s]
+  double       setMin = 1e9, setMax = -1e9;    // set latency [ms]
+  double       clearMin = 1e9, clearMax = -1e9; // clear latency [ms]
+  double       clearPhase;                     // clear limit in the period
+  uint64_t     endNs;                          // end of the run [ns]
+  etError      error;                          // error code
+
+  Sim_Reset();
+  SimSht85_Init(model, GPIOB, 0x0200, 0x0100);
+  model->environment = AlarmEnvironment;
+  model->noise       = true;
+  SHT85_Init(sensor, &I2c_DefaultBus, SHT85_I2C_ADDR);
+  I2c_SetTiming(&I2c_TimingFast);
+  Sim_IdleNs(50000000);
+
+  SHT85_AlarmInit(&alarm, sensor, 0);
+  SHT85_AlarmSetLimits(&alarm, true, SHT85_ALARM_LOW_OFF,
+                       SHT85_HUMIDITY_TO_RAW(ALARM_THRESHOLD),
+                       SHT85_HUMIDITY_TO_RAW(ALARM_HYSTERESIS),
+                       SHT85_ALARM_RATE_OFF);
+  SHT85_AlarmSetLimits(&alarm, false, SHT85_ALARM_LOW_OFF,
+                       SHT85_ALARM_HIGH_OFF, 0,
+                       SHT85_TEMPERATURE_DIFF_TO_RAW(0.5));
+  SHT85_AlarmSetOutput(&alarm, SHT85_ALARM_HUMI_HIGH, GPIOC, 0x0100);
+
+  // time in the period when the humidity falls below the clear limit [s]
+  clearPhase = ALARM_PERIOD_S *
+               (1 - acos(ALARM_HYSTERESIS / ALARM_SWING) / (2 * M_PI));
+
+  Sim_ResetStats();
+  alarmStartNs = Sim_GetTimeNs();
+  endNs        = alarmStartNs + ALARM_SECONDS * 1000000000ULL;
+  SHT85_StreamInit(stream, sensor);
+  error = SHT85_StreamStart(stream, PERI_MEAS_LOW_10_HZ);
+
+  while(error == NO_ERROR && Sim_GetTimeNs() < endNs) {
+    Sim_IdleNs(100000000);
+    error = SHT85_StreamRead(stream, samples, SHT85_STREAM_SIZE, &nbrOfRead);
+
+    for(i = 0; i < nbrOfRead; i++) {
+      // plain compare of the converted value
+      if((SHT85_CalcHumidityCenti(samples[i].rawHumi) > ALARM_THRESHOLD * 100)
+         != high) {
+        high = !high;
+        toggles++;
+      }
+
+      last  = state;
+      state = SHT85_AlarmCheck(&alarm, &samples[i]);
+      if(state == last) continue;
+
+      // latency to the true crossing of the threshold (up, at a quarter of
+      // the period) or of the clear limit (down)
+      t = ((uint64_t)samples[i].timeMs * 1000000 - alarmStartNs) / 1e9;
+      if((state ^ last) & SHT85_ALARM_HUMI_HIGH) {
+        changes++;
+      }
+      if((state & ~last) & SHT85_ALARM_HUMI_HIGH) {
+        crossing = floor(t / ALARM_PERIOD_S + 0.25) * ALARM_PERIOD_S +
+                   ALARM_PERIOD_S / 4;
+        setMin = fmin(setMin, (t - crossing) * 1000);
+        setMax = fmax(setMax, (t - crossing) * 1000);
+      }
+      if((last & ~state) & SHT85_ALARM_HUMI_HIGH) {
+        crossing = floor(t / ALARM_PERIOD_S) * ALARM_PERIOD_S + clearPhase;
+        clearMin = fmin(clearMin, (t - crossing) * 1000);
+        clearMax = fmax(clearMax, (t - crossing) * 1000);
+      }
+      if((state & ~last) & SHT85_ALARM_TEMP_RATE) {
+        rateAlarms++;
+      }
+    }
+  }
+
+  error |= SHT85_StreamStop(stream);
+  Report("Alarm 50%RH, low rep., 60s", error, NO_ERROR);
+  printf("  plain compare %u changes, alarm %u changes (%u crossings), "
+         "%u rate alarms\n", (unsigned)toggles, (unsigned)changes,
+         (unsigned)(2 * ALARM_SECONDS / ALARM_PERIOD_S),
+         (unsigned)rateAlarms);
+  printf("  latency set %.0f..%.0f ms, clear %.0f..%.0f ms, output PC8 %s\n",
+         setMin, setMax, clearMin, clearMax,
+         GPIOC->BSRR == ((state & SHT85_ALARM_HUMI_HIGH) ? 0x00000100
+                                                         : 0x01000000)
+         ? "ok" : "wrong");
+  Check(changes == 2 * ALARM_SECONDS / ALARM_PERIOD_S,
+        "one alarm change per crossing");
+  Check(rateAlarms == 1, "rate alarm at the temperature step");
+  Check(setMax <= SHT85_GetPeriodMs(PERI_MEAS_LOW_10_HZ),
+        "alarm set at most one sample late");
+  Check(GPIOC->BSRR == ((state & SHT85_ALARM_HUMI_HIGH) ? 0x00000100
+                                                        : 0x01000000),
+        "alarm output");
+
+  model->environment = 0;
+  model->noise       = false;
+}
+
+//------------------------------------------------------------------------------
+static void AlarmEnvironment(tSimSht85* model, uint64_t timeNs,
+                             float* temperature, float* humidity)
+{
+  double t = (double)(timeNs - alarmStartNs) / 1e9; // time of the run [s]
+
+  // humidity swinging around the threshold, above it in the second and
+  // third quarter of the period; temperature step of 1°C
+  *humidity    = (float)(ALARM_THRESHOLD -
+                         ALARM_SWING * cos(2 * M_PI * t / ALARM_PERIOD_S));
+  *temperature = (t < ALARM_STEP_S) ? 23.5f : 24.5f;
+}
@@ -0,0 +1,517 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  sim_sht85.c
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  Host (Linux)
+// Compiler  :  GCC
+// Brief     :  Behavioural model of the SHT85
+//==============================================================================
+
+#include "sim_sht85.h"
+#include <math.h>
+#include <string.h>
+
+// status register bits
+#define STATUS_ALERT_PENDING  0x8000
+#define STATUS_HEATER         0x2000
+#define STATUS_RH_ALERT       0x0800
+#define STATUS_T_ALERT        0x0400
+#define STATUS_RESET          0x0010
+#define STATUS_COMMAND        0x0002
+#define STATUS_POWER_UP       (STATUS_ALERT_PENDING | STATUS_RESET)
+
+// typical conversion times [ns]
+#define CONV_HIGH_NS    12500000
+#define CONV_MEDIUM_NS   4500000
+#define CONV_LOW_NS      2500000
+#define RESET_NS         1500000 // soft reset time
+#define BREAK_NS         1000000 // no command accepted after a break
+
+// measurement noise, standard deviation = datasheet repeatability / 3
+// [°C, %RH] by conversion time
+#define NOISE_T_HIGH    (0.04 / 3)
+#define NOISE_T_MEDIUM  (0.08 / 3)
+#define NOISE_T_LOW     (0.15 / 3)
+#define NOISE_RH_HIGH   (0.08 / 3)
+#define NOISE_RH_MEDIUM (0.15 / 3)
+#define NOISE_RH_LOW    (0.21 / 3)
+
+// operating modes
+enum { MODE_IDLE, MODE_SINGLE, MODE_PERIODIC };
+
+// data returned on a read header
+enum { READ_NONE, READ_SERIAL, READ_STATUS, READ_SINGLE, READ_FETCH };
+
+// transfer phases
+enum { PH_IDLE, PH_ADDR, PH_RX, PH_TX, PH_IGNORE };
+
+// periodic measurement commands
+static const struct {
+  uint16_t command;  // command code
+  uint32_t periodMs; // measurement period [ms]
+  uint32_t convNs;   // conversion time [ns]
+} periodicCommands[] = {
+  {0x2032, 2000, CONV_HIGH_NS}, {0x2024, 2000, CONV_MEDIUM_NS},
+  {0x202F, 2000, CONV_LOW_NS},  {0x2130, 1000, CONV_HIGH_NS},
+  {0x2126, 1000, CONV_MEDIUM_NS}, {0x212D, 1000, CONV_LOW_NS},
+  {0x2236,  500, CONV_HIGH_NS}, {0x2220,  500, CONV_MEDIUM_NS},
+  {0x222B,  500, CONV_LOW_NS},  {0x2334,  250, CONV_HIGH_NS},
+  {0x2322,  250, CONV_MEDIUM_NS}, {0x2329,  250, CONV_LOW_NS},
+  {0x2737,  100, CONV_HIGH_NS}, {0x2721,  100, CONV_MEDIUM_NS},
+  {0x272A,  100, CONV_LOW_NS},
+};
+
+static void    Event(tSimDevice* device, etSimEvent event, bool sda);
+static bool    HandleByte(tSimSht85* model, uint8_t byte);
+static bool    HandleReadHeader(tSimSht85* model);
+static void    Execute(tSimSht85* model, uint16_t command);
+static bool    Idle(tSimSht85* model);
+static void    Reset(tSimSht85* model);
+static void    LeavePeriodic(tSimSht85* model);
+static void    HeaterOff(tSimSht85* model);
+static void    LoadWord(tSimSht85* model, uint8_t idx, uint16_t word);
+static void    LoadMeasurement(tSimSht85* model);
+static double  Noise(tSimSht85* model);
+static void    DriveBit(tSimSht85* model);
+
+//------------------------------------------------------------------------------
+void SimSht85_Init(tSimSht85* model, GPIO_TypeDef* port, uint16_t sdaPin,
+                   uint16_t sclPin)
+{
+  model->device.port   = port;
+  model->device.sdaPin = sdaPin;
+  model->device.sclPin = sclPin;
+  model->device.sdaLow = false;
+  model->device.sclLow = false;
+  model->device.event  = Event;
+
+  model->address      = 0x44;
+  model->serialNumber = 0x12345678;
+  model->temperature  = 25.0f;
+  model->humidity     = 50.0f;
+  model->environment  = 0;
+  model->heaterDeltaT = 3.0f;
+  model->clockPpm     = 0;
+  model->noise        = false;
+  model->noiseSeed    = 1;
+  model->faults       = 0;
+  memset(model->txFlip, 0, sizeof(model->txFlip));
+  model->phase        = PH_IDLE;
+  model->commands     = 0;
+  model->nacks        = 0;
+  model->measurements = 0;
+  model->measureNs    = 0;
+  model->periodicNs   = 0;
+  model->heaterNs     = 0;
+  model->heaterOffNs  = 0;
+  model->status       = 0;
+  model->mode         = MODE_IDLE;
+
+  Reset(model);
+  Sim_Attach(&model->device);
+}
+
+//------------------------------------------------------------------------------
+void SimSht85_GetActivity(tSimSht85* model, uint64_t* measureNs,
+                          uint64_t* periodicNs)
+{
+  uint64_t elapsedNs = 0; // time in the running periodic measurement
+
+  *measureNs  = model->measureNs;
+  *periodicNs = model->periodicNs;
+
+  if(model->mode == MODE_PERIODIC) {
+    elapsedNs    = Sim_GetTimeNs() - model->startNs;
+    *periodicNs += elapsedNs;
+    *measureNs  += elapsedNs / model->periodNs * model->convNs;
+  }
+}
+
+//------------------------------------------------------------------------------
+void SimSht85_SetEnvironment(tSimSht85* model, float temperature,
+                             float humidity)
+{
+  model->temperature = temperature;
+  model->humidity    = humidity;
+}
+
+//------------------------------------------------------------------------------
+void SimSht85_HoldSda(tSimSht85* model)
+{
+  model->phase     = PH_TX;
+  model->txBuf[0]  = 0x00;
+  model->txLen     = 1;
+  model->txIdx     = 0;
+  model->txBits    = 0;
+  model->masterAck = false;
+  DriveBit(model);
+}
+
+//------------------------------------------------------------------------------
+uint8_t SimSht85_Crc(const uint8_t data[], uint8_t nbrOfBytes)
+{
+  uint8_t crc = 0xFF; // calculated checksum
+  uint8_t i;          // byte counter
+  uint8_t bit;        // bit counter
+
+  for(i = 0; i < nbrOfBytes; i++) {
+    crc ^= data[i];
+    for(bit = 0; bit < 8; bit++) {
+      crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+    }
+  }
+
+  return crc;
+}
+
+//------------------------------------------------------------------------------
+static void Event(tSimDevice* device, etSimEvent event, bool sda)
+{
+  tSimSht85* model = (tSimSht85*)device;
+
+  switch(event) {
+    case SIM_START:
+      model->phase    = PH_ADDR;
+      model->ackPhase = false;
+      model->bitCnt   = 0;
+      model->shift    = 0;
+      model->rxCnt    = 0;
+      device->sdaLow  = false;
+      break;
+
+    case SIM_STOP:
+      model->phase   = PH_IDLE;
+      device->sdaLow = false;
+      break;
+
+    case SIM_SCL_RISE:
+      if((model->phase == PH_ADDR || model->phase == PH_RX) &&
+         !model->ackPhase && model->bitCnt < 8) {
+        // sample data bit
+        model->shift = (uint8_t)((model->shift << 1) | (sda ? 1 : 0));
+        model->bitCnt++;
+      } else if(model->phase == PH_TX && model->txBits == 8) {
+        // sample acknowledge of the master
+        model->masterAck = !sda;
+      }
+      break;
+
+    case SIM_SCL_FALL:
+      if(model->phase == PH_ADDR || model->phase == PH_RX) {
+        if(model->ackPhase) {
+          // end of acknowledge clock
+          model->ackPhase = false;
+          model->bitCnt   = 0;
+          model->shift    = 0;
+          device->sdaLow  = false;
+          model->phase    = model->nextPhase;
+          if(model->phase == PH_TX) {
+            model->txIdx  = 0;
+            model->txBits = 0;
+            DriveBit(model);
+          }
+        } else if(model->bitCnt == 8) {
+          // byte received: acknowledge it or not
+          model->ackPhase = true;
+          device->sdaLow  = HandleByte(model, model->shift);
+        }
+      } else if(model->phase == PH_TX) {
+        if(model->txBits < 8) {
+          model->txBits++;
+          if(model->txBits < 8) {
+            DriveBit(model);
+          } else {
+            device->sdaLow = false; // release SDA for the master acknowledge
+          }
+        } else if(model->masterAck && model->txIdx + 1 < model->txLen) {
+          model->txIdx++;
+          model->txBits = 0;
+          DriveBit(model);
+        } else {
+          model->phase   = PH_IGNORE;
+          device->sdaLow = false;
+        }
+      }
+      break;
+  }
+}
+
+//------------------------------------------------------------------------------
+static bool HandleByte(tSimSht85* model, uint8_t byte)
+{
+  bool ack = true; // acknowledge
+
+  if(model->phase == PH_ADDR) {
+    model->generalCall = (byte == 0x00);
+
+    if(byte >> 1 != model->address && !model->generalCall) {
+      ack = false; // other device
+    } else if((model->faults & SIM_FAULT_NACK) ||
+              Sim_GetTimeNs() < model->busyNs) {
+      ack = false; // not responding
+    } else if(byte & 0x01) {
+      ack = HandleReadHeader(model);
+    }
+
+    if(ack) {
+      model->nextPhase = (byte & 0x01) ? PH_TX : PH_RX;
+    } else {
+      model->nextPhase = PH_IGNORE;
+      if(byte >> 1 == model->address) model->nacks++;
+    }
+  } else if(model->faults & SIM_FAULT_NACK_DATA) {
+    ack = false; // command byte not received
+    model->nextPhase = PH_IGNORE;
+  } else {
+    // command bytes
+    if(model->rxCnt < 2) {
+      model->rxBuf[model->rxCnt++] = byte;
+    }
+
+    if(model->generalCall) {
+      if(byte == 0x06) Reset(model);
+    } else if(model->rxCnt == 2) {
+      Execute(model, (uint16_t)(model->rxBuf[0] << 8 | model->rxBuf[1]));
+      model->rxCnt = 3; // ignore further bytes
+    }
+    model->nextPhase = PH_RX;
+  }
+
+  return ack;
+}
+
+//------------------------------------------------------------------------------
+static bool HandleReadHeader(tSimSht85* model)
+{
+  uint64_t now = Sim_GetTimeNs();
+  uint32_t available; // periodic: number of finished measurements
+
+  switch(model->readSource) {
+    case READ_SERIAL:
+      LoadWord(model, 0, (uint16_t)(model->serialNumber >> 16));
+      LoadWord(model, 1, (uint16_t)model->serialNumber);
+      model->txLen = 6;
+      break;
+
+    case READ_STATUS:
+      LoadWord(model, 0, model->status);
+      model->txLen = 3;
+      break;
+
+    case READ_SINGLE:
+      if(now < model->readyNs) return false; // still measuring
+      LoadMeasurement(model);
+      model->mode = MODE_IDLE;
+      break;
+
+    case READ_FETCH:
+      if(now < model->startNs + model->convNs) return false;
+      available = (uint32_t)((now - model->startNs - model->convNs) /
+                             model->periodNs) + 1;
+      if(available <= model->fetched) return false; // no new data
+      model->fetched = available;
+      LoadMeasurement(model);
+      break;
+
+    default:
+      return false;
+  }
+
+  model->readSource = READ_NONE;
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+static void Execute(tSimSht85* model, uint16_t command)
+{
+  uint8_t i;                // command table index
+  bool    valid = true;     // command is valid in the current mode
+
+  model->commands++;
+
+  switch(command) {
+    case 0x3780: model->readSource = READ_SERIAL; break;
+    case 0xF32D: model->readSource = READ_STATUS; break;
+    case 0x3041:
+      model->status &= ~(STATUS_ALERT_PENDING | STATUS_RH_ALERT |
+                         STATUS_T_ALERT | STATUS_RESET);
+      break;
+    case 0x306D:
+      if(!(model->status & STATUS_HEATER)) {
+        model->heaterOnNs = Sim_GetTimeNs();
+        model->status    |= STATUS_HEATER;
+      }
+      break;
+    case 0x3066: HeaterOff(model); break;
+    case 0x30A2: Reset(model); return;
+    case 0x3093:
+      LeavePeriodic(model);
+      model->mode   = MODE_IDLE;
+      model->busyNs = Sim_GetTimeNs() + BREAK_NS;
+      break;
+    case 0xE000:
+      valid = (model->mode == MODE_PERIODIC);
+      if(valid) model->readSource = READ_FETCH;
+      break;
+    case 0x2400: case 0x240B: case 0x2416:
+      valid = (model->mode != MODE_PERIODIC);
+      if(valid) {
+        model->convNs  = (command == 0x2400) ? CONV_HIGH_NS :
+                         (command == 0x240B) ? CONV_MEDIUM_NS : CONV_LOW_NS;
+        model->mode    = MODE_SINGLE;
+        model->readyNs = Sim_GetTimeNs() + model->convNs;
+        model->measureNs += model->convNs;
+        model->readSource = READ_SINGLE;
+      }
+      break;
+    default:
+      valid = false;
+      for(i = 0; i < sizeof(periodicCommands) / sizeof(periodicCommands[0]);
+          i++) {
+        // the periodic mode is started from idle only, a running one has
+        // to be stopped with a break first
+        if(periodicCommands[i].command == command && Idle(model)) {
+          model->mode     = MODE_PERIODIC;
+          model->periodNs = (uint64_t)periodicCommands[i].periodMs *
+                            1000000000000 / (1000000 + model->clockPpm);
+          model->convNs   = periodicCommands[i].convNs;
+          model->startNs  = Sim_GetTimeNs();
+          model->fetched  = 0;
+          valid = true;
+        }
+      }
+      break;
+  }
+
+  if(valid) {
+    model->status &= ~STATUS_COMMAND;
+  } else {
+    model->status |= STATUS_COMMAND;
+  }
+}
+
+//------------------------------------------------------------------------------
+static bool Idle(tSimSht85* model)
+{
+  // a single shot measurement is done after its conversion time
+  return model->mode == MODE_IDLE ||
+         (model->mode == MODE_SINGLE && Sim_GetTimeNs() >= model->readyNs);
+}
+
+//------------------------------------------------------------------------------
+static void Reset(tSimSht85* model)
+{
+  LeavePeriodic(model);
+  HeaterOff(model);
+  model->status     = STATUS_POWER_UP;
+  model->mode       = MODE_IDLE;
+  model->readSource = READ_NONE;
+  model->busyNs     = Sim_GetTimeNs() + RESET_NS;
+}
+
+//------------------------------------------------------------------------------
+static void LeavePeriodic(tSimSht85* model)
+{
+  uint64_t elapsedNs; // time in periodic mode
+
+  // account the measurements of the periodic mode when it ends
+  if(model->mode == MODE_PERIODIC) {
+    elapsedNs          = Sim_GetTimeNs() - model->startNs;
+    model->periodicNs += elapsedNs;
+    model->measureNs  += elapsedNs / model->periodNs * model->convNs;
+  }
+}
+
+//------------------------------------------------------------------------------
+static void HeaterOff(tSimSht85* model)
+{
+  // account the heater pulse when it ends
+  if(model->status & STATUS_HEATER) {
+    model->heaterNs   += Sim_GetTimeNs() - model->heaterOnNs;
+    model->heaterOffNs = Sim_GetTimeNs();
+    model->status     &= ~STATUS_HEATER;
+  }
+}
+
+//------------------------------------------------------------------------------
+static void LoadWord(tSimSht85* model, uint8_t idx, uint16_t word)
+{
+  uint8_t* data = &model->txBuf[idx * 3];
+
+  data[0] = (uint8_t)(word >> 8);
+  data[1] = (uint8_t)word;
+  data[2] = SimSht85_Crc(data, 2);
+
+  if(model->faults & SIM_FAULT_CRC) {
+    data[2] ^= 0xFF;
+  }
+}
+
+//------------------------------------------------------------------------------
+static void LoadMeasurement(tSimSht85* model)
+{
+  float  temperature = model->temperature; // environment temperature
+  float  humidity    = model->humidity;    // environment humidity
+  double rawTemp;                          // temperature raw value
+  double rawHumi;                          // humidity raw value
+
+  if(model->environment) {
+    model->environment(model, Sim_GetTimeNs(), &temperature, &humidity);
+  }
+
+  if(model->status & STATUS_HEATER) {
+    temperature += model->heaterDeltaT;
+  }
+
+  // the shorter the conversion, the larger the noise
+  if(model->noise) {
+    if(model->convNs == CONV_HIGH_NS) {
+      temperature += (float)(NOISE_T_HIGH * Noise(model));
+      humidity    += (float)(NOISE_RH_HIGH * Noise(model));
+    } else if(model->convNs == CONV_MEDIUM_NS) {
+      temperature += (float)(NOISE_T_MEDIUM * Noise(model));
+      humidity    += (float)(NOISE_RH_MEDIUM * Noise(model));
+    } else {
+      temperature += (float)(NOISE_T_LOW * Noise(model));
+      humidity    += (float)(NOISE_RH_LOW * Noise(model));
+    }
+  }
+
+  rawTemp = floor((temperature + 45.0) * 65535.0 / 175.0 + 0.5);
+  rawHumi = floor(humidity * 65535.0 / 100.0 + 0.5);
+  rawTemp = rawTemp < 0 ? 0 : (rawTemp > 65535 ? 65535 : rawTemp);
+  rawHumi = rawHumi < 0 ? 0 : (rawHumi > 65535 ? 65535 : rawHumi);
+
+  LoadWord(model, 0, (uint16_t)rawTemp);
+  LoadWord(model, 1, (uint16_t)rawHumi);
+  model->txLen = 6;
+  model->measurements++;
+}
+
+//------------------------------------------------------------------------------
+static double Noise(tSimSht85* model)
+{
+  double  sum = 0; // sum of uniform values 0..1
+  uint8_t i;       // value counter
+
+  // standard normal by the sum of 12 uniform values, from a linear
+  // congruential generator to be the same on every run
+  for(i = 0; i < 12; i++) {
+    model->noiseSeed = model->noiseSeed * 1664525 + 1013904223;
+    sum += (model->noiseSeed >> 8) / 16777216.0;
+  }
+
+  return sum - 6.0;
+}
+
+//------------------------------------------------------------------------------
+static void DriveBit(tSimSht85* model)
+{
+  uint8_t byte = model->txBuf[model->txIdx] ^ model->txFlip[model->txIdx];
+
+  model->device.sdaLow = ((byte >> (7 - model->txBits)) & 0x01) == 0;
+}
@@ -0,0 +1,130 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  sim_sht85.h
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  Host (Linux)
+// Compiler  :  GCC
+// Brief     :  Behavioural model of the SHT85 on a simulated bus: command
+//              decoding, conversion times (NACK while measuring), periodic
+//              mode, status register, heater, soft/general call reset and CRCs.
+//==============================================================================
+
+#ifndef SIM_SHT85_H
+#define SIM_SHT85_H
+
+#include "sim_bus.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// Fault injection
+#define SIM_FAULT_NACK       0x01 // sensor does not acknowledge its address
+#define SIM_FAULT_CRC        0x02 // all transmitted checksums are wrong
+#define SIM_FAULT_NACK_DATA  0x04 // sensor does not acknowledge command bytes
+
+typedef struct sSimSht85 tSimSht85;
+
+// Environment seen by the sensor, called for every measurement
+typedef void (*tSimEnvironment)(tSimSht85* model, uint64_t timeNs,
+                                float* temperature, float* humidity);
+
+struct sSimSht85{
+  tSimDevice      device;       // bus device, has to be the first member
+  uint8_t         address;      // I2C address
+  uint32_t        serialNumber; // serial number
+  float           temperature;  // environment temperature [°C]
+  float           humidity;     // environment humidity [%RH]
+  tSimEnvironment environment;  // optional environment function
+  float           heaterDeltaT; // temperature increase with heater on [°C]
+  uint8_t         faults;       // injected faults (SIM_FAULT_...)
+  uint8_t         txFlip[6];    // bits inverted on the bus when transmitted
+  int32_t         clockPpm;     // periodic rate error [ppm], > 0 is faster
+  bool            noise;        // noise of the repeatability on the values
+  uint32_t        noiseSeed;    // state of the noise generator
+  // sensor state
+  uint16_t        status;       // status register
+  uint8_t         mode;         // idle, single shot or periodic
+  uint64_t        readyNs;      // single shot: end of conversion
+  uint64_t        convNs;       // conversion time of the current mode
+  uint64_t        periodNs;     // periodic: measurement period
+  uint64_t        startNs;      // periodic: start of the first measurement
+  uint32_t        fetched;      // periodic: number of fetched samples
+  uint64_t        busyNs;       // no response until this time (reset, break)
+  uint8_t         readSource;   // data returned on the next read header
+  // I2C slave state
+  uint8_t         phase;        // transfer phase
+  uint8_t         nextPhase;    // phase after the acknowledge clock
+  bool            ackPhase;     // within the acknowledge clock
+  bool            generalCall;  // addressed by general call
+  uint8_t         bitCnt;       // received bits
+  uint8_t         shift;        // receive shift register
+  uint8_t         rxBuf[2];     // received command bytes
+  uint8_t         rxCnt;        // number of received bytes
+  uint8_t         txBuf[6];     // bytes to transmit
+  uint8_t         txLen;        // number of bytes to transmit
+  uint8_t         txIdx;        // byte in transmission
+  uint8_t         txBits;       // transmitted bits of the current byte
+  bool            masterAck;    // master acknowledged the last byte
+  // statistics
+  uint32_t        commands;     // executed commands
+  uint32_t        nacks;        // not acknowledged headers
+  uint32_t        measurements; // delivered measurements
+  uint64_t        measureNs;    // time measuring, for the energy estimate
+  uint64_t        periodicNs;   // time in periodic mode, ended runs
+  uint64_t        heaterNs;     // time with heater on, ended pulses
+  uint64_t        heaterOnNs;   // start of the running heater pulse
+  uint64_t        heaterOffNs;  // end of the last heater pulse
+};
+
+//==============================================================================
+void SimSht85_Init(tSimSht85* model, GPIO_TypeDef* port, uint16_t sdaPin,
+                   uint16_t sclPin);
+//==============================================================================
+// Initializes a sensor model with address 0x44 at 25°C / 50%RH and attaches
+// it to the simulated bus. The model starts in the power-up state, without
+// measurement noise.
+//------------------------------------------------------------------------------
+// input:  model        sensor model
+//         port         port of SDA and SCL
+//         sdaPin       SDA pin mask
+//         sclPin       SCL pin mask
+
+//==============================================================================
+void SimSht85_SetEnvironment(tSimSht85* model, float temperature,
+                             float humidity);
+//==============================================================================
+// Sets a constant environment.
+//------------------------------------------------------------------------------
+// input:  model        sensor model
+//         temperature  temperature [°C]
+//         humidity     relative humidity [%RH]
+
+//==============================================================================
+void SimSht85_GetActivity(tSimSht85* model, uint64_t* measureNs,
+                          uint64_t* periodicNs);
+//==============================================================================
+// Gets the accumulated time the sensor spent measuring and in periodic mode,
+// including a running periodic measurement.
+//------------------------------------------------------------------------------
+// input:  model        sensor model
+//         measureNs    pointer to time measuring [ns]
+//         periodicNs   pointer to time in periodic mode [ns]
+
+//==============================================================================
+void SimSht85_HoldSda(tSimSht85* model);
+//==============================================================================
+// Puts the model in the middle of transmitting a zero byte, as if the master
+// had been reset during a read: the model holds SDA low until the byte is
+// clocked out.
+//------------------------------------------------------------------------------
+// input:  model        sensor model
+
+//==============================================================================
+uint8_t SimSht85_Crc(const uint8_t data[], uint8_t nbrOfBytes);
+//==============================================================================
+// Reference CRC-8 (polynomial 0x31, init 0xFF) of the model.
+//------------------------------------------------------------------------------
+
+#endif
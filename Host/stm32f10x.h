@@ -0,0 +1,171 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  stm32f10x.h
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  Host (Linux)
+// Compiler  :  GCC
+// Brief     :  Host replacement of the controller register definitions.
+//              The registers are plain memory, all SDA/SCL port accesses are
+//              routed to the simulated bus (sim_bus.h), the I2C1 register
+//              accesses to the peripheral model (sim_i2c.c).
+//==============================================================================
+
+#ifndef STM32F10X_H
+#define STM32F10X_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define __IO volatile
+
+// memory barrier, orders the accesses of interrupt handler and main loop
+#define __DMB() __sync_synchronize()
+
+// wait for interrupt, the simulated controller sleeps until the next one
+void Sim_WaitForInterrupt(void);
+#define __WFI() Sim_WaitForInterrupt()
+
+// interrupts run only while the simulated time advances, never between two
+// statements: nothing to lock
+#define __disable_irq() ((void)0)
+#define __enable_irq()  ((void)0)
+
+// GPIO port, padded to the register block size of the controller (0x400)
+typedef struct{
+  __IO uint32_t CRL;
+  __IO uint32_t CRH;
+  __IO uint32_t IDR;
+  __IO uint32_t ODR;
+  __IO uint32_t BSRR;
+  __IO uint32_t BRR;
+  __IO uint32_t LCKR;
+  uint8_t       RESERVED[0x400 - 7 * 4];
+}GPIO_TypeDef;
+
+// reset and clock control
+typedef struct{
+  __IO uint32_t CR;
+  __IO uint32_t CFGR;
+  __IO uint32_t CIR;
+  __IO uint32_t APB2RSTR;
+  __IO uint32_t APB1RSTR;
+  __IO uint32_t AHBENR;
+  __IO uint32_t APB2ENR;
+  __IO uint32_t APB1ENR;
+  __IO uint32_t BDCR;
+  __IO uint32_t CSR;
+}RCC_TypeDef;
+
+// I2C peripheral, 16 bit registers on 32 bit boundaries
+typedef struct{
+  __IO uint16_t CR1;
+  uint16_t      RESERVED0;
+  __IO uint16_t CR2;
+  uint16_t      RESERVED1;
+  __IO uint16_t OAR1;
+  uint16_t      RESERVED2;
+  __IO uint16_t OAR2;
+  uint16_t      RESERVED3;
+  __IO uint16_t DR;
+  uint16_t      RESERVED4;
+  __IO uint16_t SR1;
+  uint16_t      RESERVED5;
+  __IO uint16_t SR2;
+  uint16_t      RESERVED6;
+  __IO uint16_t CCR;
+  uint16_t      RESERVED7;
+  __IO uint16_t TRISE;
+  uint16_t      RESERVED8;
+}I2C_TypeDef;
+
+// DMA controller
+typedef struct{
+  __IO uint32_t ISR;
+  __IO uint32_t IFCR;
+}DMA_TypeDef;
+
+// DMA channel, the addresses hold a full host pointer (DMA_ADDRESS())
+typedef struct{
+  __IO uint32_t  CCR;
+  __IO uint32_t  CNDTR;
+  __IO uintptr_t CPAR;
+  __IO uintptr_t CMAR;
+}DMA_Channel_TypeDef;
+
+// alternate function I/O
+typedef struct{
+  __IO uint32_t EVCR;
+  __IO uint32_t MAPR;
+}AFIO_TypeDef;
+
+extern GPIO_TypeDef        SimGpio[5]; // simulated ports A..E
+extern RCC_TypeDef         SimRcc;
+extern I2C_TypeDef         SimI2c1;
+extern DMA_TypeDef         SimDma1;
+extern DMA_Channel_TypeDef SimDma1Channel[7];
+extern AFIO_TypeDef        SimAfio;
+
+#define GPIOA_BASE    ((uintptr_t)&SimGpio[0])
+#define GPIOA         (&SimGpio[0])
+#define GPIOB         (&SimGpio[1])
+#define GPIOC         (&SimGpio[2])
+#define GPIOD         (&SimGpio[3])
+#define GPIOE         (&SimGpio[4])
+#define RCC           (&SimRcc)
+#define I2C1          (&SimI2c1)
+#define DMA1          (&SimDma1)
+#define DMA1_Channel7 (&SimDma1Channel[6])
+#define AFIO          (&SimAfio)
+
+// register bits of the I2C1 backend
+#define RCC_APB2ENR_AFIOEN    0x00000001
+#define RCC_APB2ENR_IOPBEN    0x00000008
+#define RCC_APB1ENR_I2C1EN    0x00200000
+#define RCC_AHBENR_DMA1EN     0x00000001
+#define AFIO_MAPR_I2C1_REMAP  0x00000002
+#define I2C_CR1_PE            0x0001
+#define I2C_CR1_START         0x0100
+#define I2C_CR1_STOP          0x0200
+#define I2C_CR1_ACK           0x0400
+#define I2C_CR1_SWRST         0x8000
+#define I2C_CR2_FREQ          0x003F
+#define I2C_CR2_DMAEN         0x0800
+#define I2C_CR2_LAST          0x1000
+#define I2C_SR1_SB            0x0001
+#define I2C_SR1_ADDR          0x0002
+#define I2C_SR1_BTF           0x0004
+#define I2C_SR1_RXNE          0x0040
+#define I2C_SR1_TXE           0x0080
+#define I2C_SR1_AF            0x0400
+#define I2C_SR2_MSL           0x0001
+#define I2C_SR2_BUSY          0x0002
+#define I2C_SR2_TRA           0x0004
+#define I2C_CCR_CCR           0x0FFF
+#define I2C_CCR_FS            0x8000
+#define DMA_ISR_GIF7          0x01000000
+#define DMA_ISR_TCIF7         0x02000000
+#define DMA_IFCR_CGIF7        0x01000000
+#define DMA_CCR7_EN           0x00000001
+#define DMA_CCR7_MINC         0x00000080
+
+// SDA/SCL port accesses go through the bus model
+void     SimGpio_WriteBsrr(GPIO_TypeDef* port, uint32_t value);
+uint32_t SimGpio_ReadIdr(GPIO_TypeDef* port);
+
+#define GPIO_WRITE_BSRR(port, value) SimGpio_WriteBsrr((port), (value))
+#define GPIO_READ_IDR(port)          SimGpio_ReadIdr(port)
+
+// I2C1 register accesses go through the peripheral model, which runs the
+// transfers on PB8/PB9 when they are started by a register access
+uint16_t SimI2c_Read(size_t offset);
+void     SimI2c_Write(size_t offset, uint16_t value);
+
+#define I2C_READ_REG(reg)         SimI2c_Read(offsetof(I2C_TypeDef, reg))
+#define I2C_WRITE_REG(reg, value) \
+  SimI2c_Write(offsetof(I2C_TypeDef, reg), (uint16_t)(value))
+#define DMA_ADDRESS(pointer)      ((uintptr_t)(pointer))
+
+#endif
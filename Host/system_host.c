@@ -0,0 +1,97 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  system_host.c
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  Host (Linux)
+// Compiler  :  GCC
+// Brief     :  System functions on the simulated time base, replaces system.c
+//==============================================================================
+
+#include "system.h"
+#include "sim_bus.h"
+
+//------------------------------------------------------------------------------
+void System_Init(void)
+{
+  // no initialization required
+}
+
+//------------------------------------------------------------------------------
+uint32_t System_GetTickMs(void)
+{
+  return (uint32_t)(Sim_GetTimeNs() / 1000000);
+}
+
+//------------------------------------------------------------------------------
+void System_StartTimer(uint16_t periodMs, tSystemTimerHandler handler)
+{
+  Sim_StartTimer(SYSTEM_TIMER_TICK_US * 1000, SYSTEM_TIMER_RELOAD(periodMs),
+                 handler);
+}
+
+//------------------------------------------------------------------------------
+void System_SetTimerPeriod(uint16_t periodMs)
+{
+  uint16_t reload = SYSTEM_TIMER_RELOAD(periodMs); // auto-reload value
+
+  // as on the controller: an update event if the counter is beyond the period
+  Sim_SetTimerReload(reload);
+  if(Sim_GetTimerCount() > reload) {
+    Sim_TimerUpdate();
+  }
+}
+
+//------------------------------------------------------------------------------
+void System_StopTimer(void)
+{
+  Sim_StopTimer();
+}
+
+//------------------------------------------------------------------------------
+void System_InitStop(void)
+{
+  // no initialization required
+}
+
+//------------------------------------------------------------------------------
+uint32_t System_StopMs(uint32_t ms)
+{
+  Sim_StopNs((uint64_t)ms * 1000000);
+  
+  return ms;
+}
+
+//------------------------------------------------------------------------------
+void System_InitUart(uint32_t baudrate)
+{
+  // 10 bits per byte: start, 8 data, stop
+  Sim_InitUart(10000000000ULL / baudrate);
+}
+
+//------------------------------------------------------------------------------
+void System_UartSend(const uint8_t data[], uint16_t size,
+                     tSystemUartHandler handler)
+{
+  Sim_UartSend(data, size, handler);
+}
+
+//------------------------------------------------------------------------------
+void System_DelayUs(uint32_t nbrOfUs)
+{
+  Sim_DelayUs(nbrOfUs);
+}
+
+//------------------------------------------------------------------------------
+void System_DelayNs(uint32_t nbrOfNs)
+{
+  Sim_DelayNs(nbrOfNs);
+}
+
+//------------------------------------------------------------------------------
+uint32_t System_GetCycles(void)
+{
+  return (uint32_t)(Sim_GetTimeNs() * SYSTEM_CYCLES_PER_US / 1000);
+}
@@ -0,0 +1,208 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  aggregate.c
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  STM32F100RB
+// IDE       :  µVision V5.25.2.0
+// Compiler  :  Armcc
+// Brief     :  Window aggregation of temperature and humidity samples.
+//==============================================================================
+
+#include "aggregate.h"
+
+static void    Summarize(tAggregate* aggregate);
+static void    Emit(const tAggregate* aggregate, tAggregateSummary* summary);
+static void    ChannelAdd(tAggregateChannel* channel, int16_t value,
+                          uint16_t count);
+static void    ChannelStats(const tAggregateChannel* channel, uint16_t count,
+                            tAggregateStats* stats);
+static int32_t DivRound(int32_t dividend, int32_t divisor);
+
+//------------------------------------------------------------------------------
+void Aggregate_InitTumbling(tAggregate* aggregate, uint16_t length)
+{
+  aggregate->length    = length;
+  aggregate->hop       = length;
+  aggregate->buffer    = 0;
+  aggregate->head      = 0;
+  aggregate->count     = 0;
+  aggregate->sinceEmit = 0;
+}
+
+//------------------------------------------------------------------------------
+void Aggregate_InitRolling(tAggregate* aggregate, uint16_t length,
+                           uint16_t hop, tAggregateSample buffer[])
+{
+  aggregate->length    = length;
+  aggregate->hop       = hop;
+  aggregate->buffer    = buffer;
+  aggregate->head      = 0;
+  aggregate->count     = 0;
+  aggregate->sinceEmit = 0;
+}
+
+//------------------------------------------------------------------------------
+bool Aggregate_Add(tAggregate* aggregate, uint32_t timeMs,
+                   uint16_t rawValueTemp, uint16_t rawValueHumi,
+                   tAggregateSummary* summary)
+{
+  int16_t           temperature; // temperature [0.01°C]
+  int16_t           humidity;    // relative humidity [0.01%RH]
+  tAggregateSample* sample;      // sample in the ring buffer
+  
+  temperature = SHT85_CalcTemperatureCenti(rawValueTemp);
+  humidity    = (int16_t)SHT85_CalcHumidityCenti(rawValueHumi);
+  
+  if(aggregate->buffer) {
+    // rolling: the sample replaces the oldest one, the summary is computed
+    // from the buffer when due
+    sample = &aggregate->buffer[aggregate->head];
+    sample->timeMs      = timeMs;
+    sample->temperature = temperature;
+    sample->humidity    = humidity;
+    
+    if(++aggregate->head >= aggregate->length) {
+      aggregate->head = 0;
+    }
+    if(aggregate->count < aggregate->length) {
+      aggregate->count++;
+    }
+    
+    if(++aggregate->sinceEmit < aggregate->hop) {
+      return false;
+    }
+    
+    Summarize(aggregate);
+    Emit(aggregate, summary);
+    aggregate->sinceEmit = 0;
+  } else {
+    // tumbling: the sample is accumulated, the window restarts after the
+    // summary
+    aggregate->count++;
+    if(aggregate->count == 1) {
+      aggregate->startMs = timeMs;
+    }
+    aggregate->endMs = timeMs;
+    ChannelAdd(&aggregate->temperature, temperature, aggregate->count);
+    ChannelAdd(&aggregate->humidity, humidity, aggregate->count);
+    
+    if(aggregate->count < aggregate->length) {
+      return false;
+    }
+    
+    Emit(aggregate, summary);
+    aggregate->count = 0;
+  }
+  
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool Aggregate_Flush(tAggregate* aggregate, tAggregateSummary* summary)
+{
+  if(aggregate->count == 0) {
+    return false;
+  }
+  
+  if(aggregate->buffer) {
+    Summarize(aggregate);
+    aggregate->sinceEmit = 0;
+    Emit(aggregate, summary);
+  } else {
+    Emit(aggregate, summary);
+    aggregate->count = 0;
+  }
+  
+  return true;
+}
+
+//------------------------------------------------------------------------------
+static void Summarize(tAggregate* aggregate)
+{
+  const tAggregateSample* sample; // sample in the ring buffer
+  uint16_t                index;  // buffer index, oldest sample first
+  uint16_t                i;      // sample counter
+  
+  index = (uint16_t)((aggregate->head + aggregate->length - aggregate->count)
+                     % aggregate->length);
+  aggregate->startMs = aggregate->buffer[index].timeMs;
+  
+  for(i = 1; i <= aggregate->count; i++) {
+    sample = &aggregate->buffer[index];
+    ChannelAdd(&aggregate->temperature, sample->temperature, i);
+    ChannelAdd(&aggregate->humidity, sample->humidity, i);
+    aggregate->endMs = sample->timeMs;
+    
+    if(++index >= aggregate->length) {
+      index = 0;
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+static void Emit(const tAggregate* aggregate, tAggregateSummary* summary)
+{
+  summary->startMs = aggregate->startMs;
+  summary->endMs   = aggregate->endMs;
+  summary->count   = aggregate->count;
+  ChannelStats(&aggregate->temperature, aggregate->count,
+               &summary->temperature);
+  ChannelStats(&aggregate->humidity, aggregate->count, &summary->humidity);
+}
+
+//------------------------------------------------------------------------------
+static void ChannelAdd(tAggregateChannel* channel, int16_t value,
+                       uint16_t count)
+{
+  int32_t valueQ8 = (int32_t)value * 256; // value [1/256 unit]
+  int32_t deltaQ8;                        // deviation from the old mean
+  
+  // first sample of the window
+  if(count == 1) {
+    channel->min    = value;
+    channel->max    = value;
+    channel->sum    = value;
+    channel->meanQ8 = valueQ8;
+    channel->m2Q16  = 0;
+    return;
+  }
+  
+  if(value < channel->min) channel->min = value;
+  if(value > channel->max) channel->max = value;
+  channel->sum += value;
+  
+  // Welford: mean += delta / n, M2 += delta * (value - new mean)
+  deltaQ8          = valueQ8 - channel->meanQ8;
+  channel->meanQ8 += DivRound(deltaQ8, count);
+  channel->m2Q16  += (int64_t)deltaQ8 * (valueQ8 - channel->meanQ8);
+}
+
+//------------------------------------------------------------------------------
+static void ChannelStats(const tAggregateChannel* channel, uint16_t count,
+                         tAggregateStats* stats)
+{
+  stats->min      = channel->min;
+  stats->max      = channel->max;
+  stats->mean     = (int16_t)DivRound(channel->sum, count);
+  stats->variance = 0;
+  
+  // sample variance M2 / (n - 1), rounding may leave M2 slightly negative
+  if(count > 1 && channel->m2Q16 > 0) {
+    stats->variance = (uint32_t)((channel->m2Q16 / (count - 1) + 0x8000)
+                                 >> 16);
+  }
+}
+
+//------------------------------------------------------------------------------
+static int32_t DivRound(int32_t dividend, int32_t divisor)
+{
+  // rounds half away from zero, for positive divisors
+  if(dividend >= 0) {
+    return (dividend + divisor / 2) / divisor;
+  } else {
+    return (dividend - divisor / 2) / divisor;
+  }
+}
@@ -0,0 +1,135 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  aggregate.h
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  STM32F100RB
+// IDE       :  µVision V5.25.2.0
+// Compiler  :  Armcc
+// Brief     :  Window aggregation: reduces the samples to window summaries
+//              (count, min, max, mean, variance) of temperature [0.01°C] and
+//              relative humidity [0.01%RH], in integer arithmetic.
+//
+//              Tumbling window: the samples are accumulated as they come
+//              (Welford), a summary is emitted every window length samples,
+//              then the window starts empty again. No sample buffer needed.
+//
+//              Rolling window: the last window length samples are kept in a
+//              ring buffer of the caller, every hop samples a summary of them
+//              is computed (Welford pass over the buffer).
+//
+//              The running mean is kept with 8 fractional bits and the sum of
+//              squared deviations with 16. The summary mean is rounded to the
+//              unit (0.01°C, 0.01%RH) from the exact sum of the values, the
+//              variance is within 0.1% of the exact value.
+//==============================================================================
+
+#ifndef AGGREGATE_H
+#define AGGREGATE_H
+
+#include "sht85.h"
+#include "system.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// One sample of a rolling window buffer
+typedef struct {
+  uint32_t timeMs;      // time of the sample [ms]
+  int16_t  temperature; // temperature [0.01°C]
+  int16_t  humidity;    // relative humidity [0.01%RH]
+} tAggregateSample;
+
+// Welford accumulator of one quantity
+typedef struct {
+  int16_t min;    // smallest value
+  int16_t max;    // largest value
+  int32_t sum;    // sum of the values, fits 65535 samples [unit]
+  int32_t meanQ8; // running mean [1/256 unit]
+  int64_t m2Q16;  // sum of squared deviations from the mean [1/65536 unit^2]
+} tAggregateChannel;
+
+// Statistics of one quantity over a window
+typedef struct {
+  int16_t  min;      // smallest value
+  int16_t  max;      // largest value
+  int16_t  mean;     // mean, rounded
+  uint32_t variance; // sample variance (n - 1) [unit^2], 0 for one sample
+} tAggregateStats;
+
+// Summary of a window
+typedef struct {
+  uint32_t        startMs;     // time of the first sample [ms]
+  uint32_t        endMs;       // time of the last sample [ms]
+  uint16_t        count;       // number of samples
+  tAggregateStats temperature; // temperature [0.01°C]
+  tAggregateStats humidity;    // relative humidity [0.01%RH]
+} tAggregateSummary;
+
+// Window aggregator
+typedef struct {
+  uint16_t          length;      // samples per window
+  uint16_t          hop;         // samples between two summaries
+  tAggregateSample* buffer;      // ring buffer (rolling), 0 = tumbling
+  uint16_t          head;        // index of the next sample in the buffer
+  uint16_t          count;       // samples in the window
+  uint16_t          sinceEmit;   // samples since the last summary
+  uint32_t          startMs;     // time of the first sample [ms]
+  uint32_t          endMs;       // time of the last sample [ms]
+  tAggregateChannel temperature; // temperature accumulator
+  tAggregateChannel humidity;    // humidity accumulator
+} tAggregate;
+
+//==============================================================================
+// Initializes a tumbling window.
+//------------------------------------------------------------------------------
+// input: aggregate     aggregator instance
+//        length        samples per window, 1..65535
+//------------------------------------------------------------------------------
+void Aggregate_InitTumbling(tAggregate* aggregate, uint16_t length);
+
+
+//==============================================================================
+// Initializes a rolling window.
+//------------------------------------------------------------------------------
+// input: aggregate     aggregator instance
+//        length        samples per window, 2..65535
+//        hop           samples between two summaries, 1..length
+//        buffer        ring buffer of length samples
+//
+// remark: until the buffer is filled, the summaries cover fewer samples
+//------------------------------------------------------------------------------
+void Aggregate_InitRolling(tAggregate* aggregate, uint16_t length,
+                           uint16_t hop, tAggregateSample buffer[]);
+
+
+//==============================================================================
+// Adds a sample, e.g. from SHT85_ReadMeasurementBufferRaw(), the stream or
+// SHT85_SingleMeasurmentRaw().
+//------------------------------------------------------------------------------
+// input: aggregate     aggregator instance
+//        timeMs        time of the sample [ms]
+//        rawValueTemp  raw temperature value
+//        rawValueHumi  raw humidity value
+//        summary       pointer to the summary, written when one is due
+//
+// return: true = summary written, false = no summary due
+//------------------------------------------------------------------------------
+bool Aggregate_Add(tAggregate* aggregate, uint32_t timeMs,
+                   uint16_t rawValueTemp, uint16_t rawValueHumi,
+                   tAggregateSummary* summary);
+
+
+//==============================================================================
+// Emits the summary of an incomplete window, e.g. before stopping. A tumbling
+// window starts empty again.
+//------------------------------------------------------------------------------
+// input: aggregate     aggregator instance
+//        summary       pointer to the summary
+//
+// return: true = summary written, false = no samples in the window
+//------------------------------------------------------------------------------
+bool Aggregate_Flush(tAggregate* aggregate, tAggregateSummary* summary);
+
+#endif
@@ -0,0 +1,363 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  app.c
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  STM32F100RB
+// IDE       :  µVision V5.25.2.0
+// Compiler  :  Armcc
+// Brief     :  Application Layer: the sample application as cooperative
+//              tasks.
+//==============================================================================
+
+#include "app.h"
+#include "task.h"
+#include "telemetry.h"
+#include "sht85_heater.h"
+#include "sht85_recovery.h"
+#include "sht85_tuner.h"
+#include "sht85_alarm.h"
+
+#define SAMPLE_BATCH       8 // samples read from the stream at once
+#define POWER_UP_MS       50 // time after power on until the sensor is ready
+#define SENSOR_ID          0 // sensor id in the telemetry records
+#define WINDOW_SAMPLES    50 // samples per summary, 5s at 10Hz
+#define MEASURE_MODE      PERI_MEAS_HIGH_10_HZ
+#define HEALTH_INTERVAL   10 // fetches per status read, 1s at 10Hz
+
+// error recovery: backoff from 10ms up to 10s for failed attempts in a row
+#define RECOVERY_BACKOFF_MIN_MS    10
+#define RECOVERY_BACKOFF_MAX_MS 10000
+
+// condensation recovery: heater pulse after 1min above 95%RH
+#define HEATER_THRESHOLD  SHT85_HUMIDITY_TO_RAW(95)
+#define HEATER_SUSTAIN_MS 60000 // time above the threshold [ms]
+#define HEATER_PULSE_MS   10000 // heater on time [ms]
+#define HEATER_SETTLE_MS   5000 // samples dropped after the pulse [ms]
+
+// blue LED: humidity above 50%RH, off again below 49%RH
+#define HUMIDITY_HIGH      SHT85_HUMIDITY_TO_RAW(50)
+#define HUMIDITY_HYST      SHT85_HUMIDITY_TO_RAW(1)
+
+// repeatability: as low as the noise and rate of change allow, high within
+// 2%RH of the LED threshold; one step down after 5s of stable values
+#define TUNER_NOISE_TEMP   SHT85_TEMPERATURE_DIFF_TO_RAW(0.1)
+#define TUNER_NOISE_HUMI   SHT85_HUMIDITY_TO_RAW(0.15)
+#define TUNER_RATE_TEMP    SHT85_TEMPERATURE_DIFF_TO_RAW(0.02) // per sample
+#define TUNER_RATE_HUMI    SHT85_HUMIDITY_TO_RAW(0.03)         // per sample
+#define TUNER_GUARD_HUMI   SHT85_HUMIDITY_TO_RAW(2)
+#define TUNER_HOLD_SAMPLES 50
+
+static void LedInit(void);
+static void LedBlue(bool on);
+static void LedGreen(bool on);
+static void MeasurementDone(tSht85* measuredSensor, etError error,
+                            float temperature, float humidity);
+static void AlarmChanged(const tSht85Alarm* changedAlarm, uint8_t changed);
+static etTaskState MeasureTask(tTask* task);
+static etTaskState RecoveryTask(tTask* task);
+static etTaskState LedTask(tTask* task);
+
+static tSht85*        sensor;       // sensor of the application
+static tSht85Stream*  stream;       // periodic sample stream of the sensor
+static tTask          measureTask;  // measurement task
+static tTask          recoveryTask; // error recovery task
+static tTask          ledTask;      // LED task
+static tAppStats      stats;        // statistics
+static tAggregate     aggregate;    // window of the streamed samples
+static tSht85Heater   heater;       // condensation recovery of the stream
+static tSht85Recovery recovery;     // error recovery of the sensor
+static tSht85Tuner    tuner;        // repeatability of the stream
+static tSht85Alarm    humiAlarm;    // humidity alarm of the blue LED
+// state shared by the tasks
+static bool           measuring;    // periodic measurement runs without error
+static bool           humidityHigh; // relative humidity over 50%
+static bool           recover;      // recovery requested by the measurement
+static bool           ledGreen;     // state of the green LED
+static bool           ledBlue;      // state of the blue LED
+
+//------------------------------------------------------------------------------
+void App_Start(tSht85* appSensor, tSht85Stream* appStream)
+{
+  sensor       = appSensor;
+  stream       = appStream;
+  measuring    = false;
+  humidityHigh = false;
+  recover      = false;
+  ledGreen     = false;
+  ledBlue      = false;
+  
+  stats.samples           = 0;
+  stats.recoveries        = 0;
+  stats.generalCallResets = 0;
+  stats.modeChanges       = 0;
+  
+  LedInit();
+  
+  Task_Start(&measureTask,  MeasureTask);
+  Task_Start(&recoveryTask, RecoveryTask);
+  Task_Start(&ledTask,      LedTask);
+}
+
+//------------------------------------------------------------------------------
+const tAppStats* App_GetStats(void)
+{
+  return &stats;
+}
+
+//------------------------------------------------------------------------------
+static etTaskState MeasureTask(tTask* task)
+{
+  static etError         error;                 // error code, kept across waits
+  static uint32_t        serialNumber;          // serial number
+  etPeriodicMeasureModes measureMode;           // periodic mode of the tuner
+  float                  temperature;           // temperature [°C]
+  float                  humidity;              // relative humidity [%RH]
+  tSht85Sample           samples[SAMPLE_BATCH]; // samples read from the stream
+  tTelemetryRecord       record;                // telemetry record of an error
+  tAggregateSummary      summary;               // window summary
+  uint8_t                nbrOfSamples;          // number of read samples
+  uint8_t                i;                     // sample index
+  bool                   retune = false;        // repeatability changed
+  
+  TASK_BEGIN(task);
+  
+  // wait 50ms after power on
+  TASK_DELAY_MS(task, POWER_UP_MS);
+  
+  // demonstartion of SoftReset command, the reset time is waited for
+  // without blocking
+  error = SHT85_WriteCommand(sensor, CMD_SOFT_RESET);
+  TASK_DELAY_MS(task, SHT85_SOFT_RESET_MS);
+  
+  // demonstartion of ReadSerialNumber command
+  error = SHT85_ReadSerialNumber(sensor, &serialNumber);
+  
+  // demonstration of the single shot measurement
+  // measurement with high repeatability, blocks until the result is read
+  error = SHT85_SingleMeasurment(sensor, &temperature, &humidity,
+                                 SINGLE_MEAS_HIGH, 50);
+  
+  // demonstration of the non-blocking single shot measurement
+  // the result is passed to MeasurementDone(), which sets the blue LED
+  // through the alarm, the stream keeps it from there
+  SHT85_AlarmInit(&humiAlarm, sensor, AlarmChanged);
+  SHT85_AlarmSetLimits(&humiAlarm, true, SHT85_ALARM_LOW_OFF,
+                       HUMIDITY_HIGH, HUMIDITY_HYST, SHT85_ALARM_RATE_OFF);
+  error = SHT85_StartMeasurementAsync(sensor, SINGLE_MEAS_HIGH,
+                                      MeasurementDone);
+  TASK_WAIT_UNTIL(task, !SHT85_ProcessAsync(sensor));
+  
+  // --- demonstration of the periodic measurement mode ---
+  SHT85_StreamInit(stream, sensor);
+  SHT85_HealthInit(&stream->health, HEALTH_INTERVAL);
+  SHT85_HeaterInit(&heater, stream, MEASURE_MODE, HEATER_THRESHOLD,
+                   HEATER_SUSTAIN_MS, HEATER_PULSE_MS, HEATER_SETTLE_MS);
+  SHT85_RecoveryInit(&recovery, sensor, stream, MEASURE_MODE,
+                     RECOVERY_BACKOFF_MIN_MS, RECOVERY_BACKOFF_MAX_MS);
+  SHT85_TunerInit(&tuner, TUNER_NOISE_TEMP, TUNER_NOISE_HUMI,
+                  TUNER_RATE_TEMP, TUNER_RATE_HUMI, TUNER_HOLD_SAMPLES);
+  SHT85_TunerAddThreshold(&tuner, true, HUMIDITY_HIGH, TUNER_GUARD_HUMI);
+  
+  // start periodic measurement, with high repeatability and 10 measurements
+  // per second, the timer interrupt fetches every sample into the stream
+  error = SHT85_StreamStart(stream, MEASURE_MODE);
+  
+  while(1) {
+    measuring = (error == NO_ERROR);
+    Aggregate_InitTumbling(&aggregate, WINDOW_SAMPLES);
+    
+    // loop while no error
+    while(error == NO_ERROR) {
+      // sleep until the timer interrupt has fetched samples
+      TASK_WAIT_UNTIL(task, SHT85_StreamPending(stream));
+      
+      // drain the stream, the raw values are sufficient for a threshold
+      // compare
+      error = SHT85_StreamRead(stream, samples, SAMPLE_BATCH, &nbrOfSamples);
+      stats.samples += nbrOfSamples;
+      
+      for(i = 0; i < nbrOfSamples; i++) {
+        // samples while the sensor cools down after a heater pulse are
+        // dropped
+        if(!SHT85_HeaterCheck(&heater, &samples[i])) {
+          continue;
+        }
+        
+        // raw compare, the LED task is woken only on a change
+        SHT85_AlarmCheck(&humiAlarm, &samples[i]);
+        retune |= SHT85_TunerUpdate(&tuner, samples[i].rawTemp,
+                                    samples[i].rawHumi);
+        
+        // only the window summaries are streamed, a full UART buffer drops
+        // them instead of waiting
+        if(Aggregate_Add(&aggregate, samples[i].timeMs, samples[i].rawTemp,
+                         samples[i].rawHumi, &summary)) {
+          Telemetry_WriteSummary(SENSOR_ID, &summary);
+        }
+      }
+      
+      // repeatability changed: the heater and the recovery start the stream
+      // in the new mode, a running stream is started again
+      if(retune) {
+        retune               = false;
+        measureMode          = SHT85_TunerPeriodicMode(&tuner, MEASURE_MODE);
+        heater.measureMode   = measureMode;
+        recovery.measureMode = measureMode;
+        stats.modeChanges++;
+        if(error == NO_ERROR && !SHT85_HeaterActive(&heater)) {
+          // the sensor accepts no command for 1ms after the break, one tick
+          // more as the delay starts within a tick; the mode is kept by the
+          // heater across the wait
+          error = SHT85_StreamStop(stream);
+          TASK_DELAY_MS(task, SHT85_BREAK_MS + 1);
+          if(error == NO_ERROR) {
+            error = SHT85_StreamStart(stream, heater.measureMode);
+          }
+        }
+      }
+      
+      // condensation: the window ends before the heater pulse, the stream
+      // is stopped during the pulse and resumes in its phase
+      if(error == NO_ERROR && SHT85_HeaterActive(&heater)) {
+        if(Aggregate_Flush(&aggregate, &summary)) {
+          Telemetry_WriteSummary(SENSOR_ID, &summary);
+        }
+        while(error == NO_ERROR && SHT85_HeaterActive(&heater)) {
+          TASK_WAIT_UNTIL(task,
+                          SHT85_HeaterWaitMs(&heater, System_GetTickMs()) == 0);
+          error = SHT85_HeaterStep(&heater);
+        }
+      }
+    }
+    
+    // report the samples before the error and the error as record without
+    // values
+    if(Aggregate_Flush(&aggregate, &summary)) {
+      Telemetry_WriteSummary(SENSOR_ID, &summary);
+    }
+    record.timeMs   = System_GetTickMs();
+    record.sensorId = SENSOR_ID;
+    record.error    = error;
+    record.rawTemp  = 0;
+    record.rawHumi  = 0;
+    Telemetry_Write(&record);
+    
+    measuring = false;
+    
+    // --- error handling ---
+    // let the recovery task reset the sensor and start the stream again, and
+    // wait until it is done
+    recover = true;
+    TASK_WAIT_UNTIL(task, !recover);
+    error = NO_ERROR;
+  }
+  
+  TASK_END(task);
+}
+
+//------------------------------------------------------------------------------
+static etTaskState RecoveryTask(tTask* task)
+{
+  TASK_BEGIN(task);
+  
+  while(1) {
+    TASK_WAIT_UNTIL(task, recover);
+    stats.recoveries++;
+    
+    // free the bus, reset the sensor and start the stream again; the reset
+    // time and the backoff of failed attempts are waited for without
+    // blocking
+    SHT85_RecoveryStart(&recovery);
+    while(SHT85_RecoveryActive(&recovery)) {
+      TASK_WAIT_UNTIL(task,
+                      SHT85_RecoveryWaitMs(&recovery, System_GetTickMs()) == 0);
+      SHT85_RecoveryStep(&recovery);
+    }
+    
+    stats.generalCallResets = recovery.generalCalls;
+    recover = false;
+  }
+  
+  TASK_END(task);
+}
+
+//------------------------------------------------------------------------------
+static etTaskState LedTask(tTask* task)
+{
+  TASK_BEGIN(task);
+  
+  while(1) {
+    TASK_WAIT_UNTIL(task, measuring != ledGreen || humidityHigh != ledBlue);
+    
+    // green LED on while measuring without error
+    ledGreen = measuring;
+    LedGreen(ledGreen);
+    
+    // if the Relative Humidity is over 50% -> the blue LED lights up
+    ledBlue = humidityHigh;
+    LedBlue(ledBlue);
+  }
+  
+  TASK_END(task);
+}
+
+//------------------------------------------------------------------------------
+static void MeasurementDone(tSht85* measuredSensor, etError error,
+                            float temperature, float humidity)
+{
+  tSht85Sample sample; // result as the first sample of the alarm
+  
+  if(error != NO_ERROR || measuredSensor != humiAlarm.sensor) {
+    return;
+  }
+  
+  // the same limits and hysteresis as the stream, the conversion back to raw
+  // values is done once
+  sample.timeMs  = System_GetTickMs();
+  sample.rawTemp = SHT85_TEMPERATURE_TO_RAW(temperature);
+  sample.rawHumi = SHT85_HUMIDITY_TO_RAW(humidity);
+  SHT85_AlarmCheck(&humiAlarm, &sample);
+}
+
+//------------------------------------------------------------------------------
+static void AlarmChanged(const tSht85Alarm* changedAlarm, uint8_t changed)
+{
+  if(changed & SHT85_ALARM_HUMI_HIGH) {
+    humidityHigh = (changedAlarm->state & SHT85_ALARM_HUMI_HIGH) != 0;
+  }
+}
+
+//------------------------------------------------------------------------------
+/* -- adapt this code for your platform -- */
+static void LedInit(void)
+{
+  RCC->APB2ENR |= 0x00000010;  // I/O port C clock enabled
+  GPIOC->CRH   &= 0xFFFFFF00;  // set general purpose output mode for LEDs
+  GPIOC->CRH   |= 0x00000011;  //
+  GPIOC->BSRR   = 0x03000000;  // LEDs off
+}
+
+//------------------------------------------------------------------------------
+/* -- adapt this code for your platform -- */
+static void LedBlue(bool on)
+{
+  if(on) {
+    GPIOC->BSRR = 0x00000100;
+  } else {
+    GPIOC->BSRR = 0x01000000;
+  }
+}
+
+//------------------------------------------------------------------------------
+/* -- adapt this code for your platform -- */
+static void LedGreen(bool on)
+{
+  if(on) {
+    GPIOC->BSRR = 0x00000200;
+  } else {
+    GPIOC->BSRR = 0x02000000;
+  }
+}
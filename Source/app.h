@@ -0,0 +1,61 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  app.h
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  STM32F100RB
+// IDE       :  µVision V5.25.2.0
+// Compiler  :  Armcc
+// Brief     :  Application Layer: the sample application as cooperative
+//              tasks. The measurement task demonstrates the sensor commands
+//              and then drains the periodic sample stream, the recovery task
+//              frees the bus, resets the sensor and starts the stream again
+//              after an error (also after an unexpected reset found by the
+//              health monitor), with a backoff for failed attempts in a row
+//              (sht85_recovery.h), and the LED task shows the state on the
+//              LEDs. After a minute of condensation (over 95%RH)
+//              the sensor is dried by a heater pulse (sht85_heater.h).
+//              Summaries of 5s windows of the samples (aggregate.h) and the
+//              errors are streamed as telemetry (telemetry.h),
+//              Telemetry_Init() has to be called before App_Start(). LEDs:
+//                green: periodic measurement running without error
+//                blue:  relative humidity over 50%
+//==============================================================================
+
+#ifndef APP_H
+#define APP_H
+
+#include "sht85.h"
+#include "sht85_stream.h"
+#include "system.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// Application statistics
+typedef struct {
+  uint32_t samples;           // samples read from the stream
+  uint32_t recoveries;        // error recoveries
+  uint32_t generalCallResets; // recoveries with a general call reset
+  uint32_t modeChanges;       // repeatability changes of the tuner
+} tAppStats;
+
+//==============================================================================
+// Initializes the LEDs and starts the application tasks. The tasks run with
+// Task_Run() or Task_Step().
+//------------------------------------------------------------------------------
+// input: sensor        initialized sensor instance
+//        stream        stream instance for the periodic measurement
+//------------------------------------------------------------------------------
+void App_Start(tSht85* sensor, tSht85Stream* stream);
+
+
+//==============================================================================
+// Gets the application statistics.
+//------------------------------------------------------------------------------
+// return: statistics since App_Start()
+//------------------------------------------------------------------------------
+const tAppStats* App_GetStats(void);
+
+#endif
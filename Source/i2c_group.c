@@ -0,0 +1,202 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  i2c_group.c
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  STM32F100RB
+// IDE       :  µVision V5.25.2.0
+// Compiler  :  Armcc
+// Brief     :  I2C lockstep layer for several bit-banged buses
+//==============================================================================
+
+#include "i2c_group.h"
+#include "system.h"
+#include "instrument.h"
+
+//-- Defines for IO-Pins -------------------------------------------------------
+// SDA of all active buses, SCL of all buses
+#define SDA_LOW(pins)  GPIO_WRITE_BSRR(group->port, (uint32_t)(pins) << 16)
+#define SDA_OPEN(pins) GPIO_WRITE_BSRR(group->port, (pins)) // open-drain
+#define SDA_READ       GPIO_READ_IDR(group->port)  // read SDA of all buses
+
+#define SCL_LOW()  GPIO_WRITE_BSRR(group->port, (uint32_t)group->sclPins << 16)
+#define SCL_OPEN() GPIO_WRITE_BSRR(group->port, group->sclPins)
+
+static uint16_t ActiveSdaPins(tI2cGroup* group);
+
+//------------------------------------------------------------------------------
+void I2cGroup_Init(tI2cGroup* group)
+{
+  group->port       = 0;
+  group->sclPins    = 0;
+  group->sdaPins    = 0;
+  group->active     = 0;
+  group->nbrOfBuses = 0;
+}
+
+//------------------------------------------------------------------------------
+bool I2cGroup_AddBus(tI2cGroup* group, const tI2cBus* bus)
+{
+  if(group->nbrOfBuses >= I2C_GROUP_MAX_BUSES) return false;
+  if(group->port != 0 && group->port != bus->port) return false;
+  if(group->sdaPins & bus->sdaPin) return false;
+  
+  group->port     = bus->port;
+  group->sclPins |= bus->sclPin;
+  group->sdaPins |= bus->sdaPin;
+  group->sdaPin[group->nbrOfBuses++] = bus->sdaPin;
+  
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void I2cGroup_StartCondition(tI2cGroup* group)
+{
+  const tI2cTiming* timing = I2c_GetTiming(); // bus timing profile
+  
+  group->active = (uint16_t)((1UL << group->nbrOfBuses) - 1);
+  
+  SDA_OPEN(group->sdaPins);
+  System_DelayNs(timing->tLowNs);
+  SCL_OPEN();
+  System_DelayNs(timing->tSuStaNs);
+  SDA_LOW(group->sdaPins);
+  System_DelayNs(timing->tHdStaNs);
+  SCL_LOW();
+}
+
+//------------------------------------------------------------------------------
+void I2cGroup_StopCondition(tI2cGroup* group)
+{
+  const tI2cTiming* timing = I2c_GetTiming(); // bus timing profile
+  
+  SCL_LOW();
+  SDA_LOW(group->sdaPins);
+  System_DelayNs(timing->tLowNs);
+  SCL_OPEN();
+  System_DelayNs(timing->tSuStoNs);
+  SDA_OPEN(group->sdaPins);
+  System_DelayNs(timing->tBufNs);
+}
+
+//------------------------------------------------------------------------------
+uint16_t I2cGroup_WriteByte(tI2cGroup* group, uint8_t txByte)
+{
+  const tI2cTiming* timing  = I2c_GetTiming();     // bus timing profile
+  uint16_t          sdaPins = ActiveSdaPins(group); // SDA pins of active buses
+  uint16_t          sdaIn;                          // SDA input of all buses
+  uint16_t          nack = 0;                       // buses without acknowledge
+  uint8_t           busIdx;                         // bus index
+  
+  for(uint8_t mask = 0x80; mask > 0; mask >>= 1) {
+    // masking txByte
+    if((mask & txByte) == 0) {
+      SDA_LOW(sdaPins);  // write 0 to SDA-Lines
+    } else {
+      SDA_OPEN(sdaPins); // write 1 to SDA-Lines
+    }
+    
+    // SCL low period, includes data set-up time
+    System_DelayNs(timing->tLowNs);
+    
+    // generate clock pulse on SCL
+    SCL_OPEN();
+    System_DelayNs(timing->tHighNs);
+    SCL_LOW();
+  }
+  
+  // release SDA-lines
+  SDA_OPEN(sdaPins);
+  
+  // ack reading
+  System_DelayNs(timing->tLowNs);
+  SCL_OPEN();
+  System_DelayNs(timing->tHighNs);
+  
+  // check ack from all i2c slaves with one port read
+  sdaIn = SDA_READ;
+  for(busIdx = 0; busIdx < group->nbrOfBuses; busIdx++) {
+    if((group->active & (1U << busIdx)) && (sdaIn & group->sdaPin[busIdx])) {
+      nack |= 1U << busIdx;
+      INSTR_COUNT(nacks);
+    }
+  }
+  INSTR_COUNT(bytesWritten);
+  
+  SCL_LOW();
+  
+  // buses without acknowledge drop out of the transfer
+  group->active &= ~nack;
+  
+  return nack;
+}
+
+//------------------------------------------------------------------------------
+void I2cGroup_ReadByte(tI2cGroup* group, uint8_t rxBytes[], etI2cAck ack)
+{
+  const tI2cTiming* timing  = I2c_GetTiming();     // bus timing profile
+  uint16_t          sdaPins = ActiveSdaPins(group); // SDA pins of active buses
+  uint16_t          sdaIn;                          // SDA input of all buses
+  uint8_t           busIdx;                         // bus index
+  
+  for(busIdx = 0; busIdx < group->nbrOfBuses; busIdx++) {
+    rxBytes[busIdx] = 0;
+  }
+  
+  // release SDA-lines
+  SDA_OPEN(sdaPins);
+  
+  for(uint8_t mask = 0x80; mask > 0; mask >>= 1) {
+    // SCL low period, slaves shift out the next bit
+    System_DelayNs(timing->tLowNs);
+    
+    SCL_OPEN();
+    System_DelayNs(timing->tHighNs);
+    
+    // read bit of all buses with one port read
+    sdaIn = SDA_READ;
+    for(busIdx = 0; busIdx < group->nbrOfBuses; busIdx++) {
+      if(sdaIn & group->sdaPin[busIdx]) {
+        rxBytes[busIdx] |= mask;
+      }
+    }
+    
+    SCL_LOW();
+  }
+  
+  // send acknowledge on active buses if necessary
+  if(ack == ACK) {
+    SDA_LOW(sdaPins);
+  } else {
+    SDA_OPEN(sdaPins);
+  }
+  
+  // SCL low period, includes data set-up time
+  System_DelayNs(timing->tLowNs);
+  
+  // generate clock pulse on SCL
+  SCL_OPEN();
+  System_DelayNs(timing->tHighNs);
+  SCL_LOW();
+  
+  // release SDA-lines
+  SDA_OPEN(sdaPins);
+  INSTR_COUNT(bytesRead);
+}
+
+//------------------------------------------------------------------------------
+static uint16_t ActiveSdaPins(tI2cGroup* group)
+{
+  uint16_t sdaPins = 0; // SDA pins of active buses
+  uint8_t  busIdx;      // bus index
+  
+  for(busIdx = 0; busIdx < group->nbrOfBuses; busIdx++) {
+    if(group->active & (1U << busIdx)) {
+      sdaPins |= group->sdaPin[busIdx];
+    }
+  }
+  
+  return sdaPins;
+}
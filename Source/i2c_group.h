@@ -0,0 +1,92 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  i2c_group.h
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  STM32F100RB
+// IDE       :  µVision V5.25.2.0
+// Compiler  :  Armcc
+// Brief     :  I2C lockstep layer: clocks several bit-banged buses of the same
+//              GPIO port with one set of port accesses. All buses see the same
+//              start/stop conditions and written bytes, only the read bytes
+//              differ per bus. The timing profile selected with
+//              I2c_SetTiming() is used, clock stretching is not supported.
+//==============================================================================
+
+#ifndef I2C_GROUP_H
+#define I2C_GROUP_H
+
+#include "i2c_hal.h"
+#include "system.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#define I2C_GROUP_MAX_BUSES  16 // max. number of buses in a group
+
+// Group of buses clocked in lockstep
+typedef struct{
+  GPIO_TypeDef* port;                        // common GPIO port of all buses
+  uint16_t      sclPins;                     // SCL pins of all buses
+  uint16_t      sdaPins;                     // SDA pins of all buses
+  uint16_t      active;                      // buses taking part [bit/bus]
+  uint8_t       nbrOfBuses;                  // number of buses in the group
+  uint16_t      sdaPin[I2C_GROUP_MAX_BUSES]; // SDA pin of each bus
+}tI2cGroup;
+
+//==============================================================================
+void I2cGroup_Init(tI2cGroup* group);
+//==============================================================================
+// Initializes an empty group.
+//------------------------------------------------------------------------------
+// input:  group        group to initialize
+
+//==============================================================================
+bool I2cGroup_AddBus(tI2cGroup* group, const tI2cBus* bus);
+//==============================================================================
+// Adds a bus to the group. The bus ports have to be initialized with
+// I2c_InitBus(). Buses may share the SCL pin but not the SDA pin.
+//------------------------------------------------------------------------------
+// input:  group        group
+//         bus          bus to add
+//
+// return: true  = bus added, its index is nbrOfBuses - 1
+//         false = group full, other port or SDA pin already in the group
+
+//==============================================================================
+void I2cGroup_StartCondition(tI2cGroup* group);
+//==============================================================================
+// Writes a start condition on all buses of the group. All buses take part in
+// the following transfer.
+//------------------------------------------------------------------------------
+// input:  group        group
+
+//==============================================================================
+void I2cGroup_StopCondition(tI2cGroup* group);
+//==============================================================================
+// Writes a stop condition on all buses of the group.
+//------------------------------------------------------------------------------
+// input:  group        group
+
+//==============================================================================
+uint16_t I2cGroup_WriteByte(tI2cGroup* group, uint8_t txByte);
+//==============================================================================
+// Writes a byte to all active buses and checks acknowledge. Buses without
+// acknowledge do not take part in the rest of the transfer.
+//------------------------------------------------------------------------------
+// input:  group        group
+//         txByte       transmit byte
+//
+// return: buses without acknowledgment [bit/bus], 0 = no error
+
+//==============================================================================
+void I2cGroup_ReadByte(tI2cGroup* group, uint8_t rxBytes[], etI2cAck ack);
+//==============================================================================
+// Reads a byte on all active buses.
+//------------------------------------------------------------------------------
+// input:  group        group
+//         rxBytes      received bytes, one per bus (0xFF on inactive buses)
+//         ack          Acknowledge: ACK or NO_ACK
+
+#endif
@@ -1,175 +1,358 @@
-//==============================================================================
-// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
-//==============================================================================
-// Project   :  SHT85 Sample Code
-// File      :  i2c_hal.c
-// Author    :  RFU
-// Date      :  17-Mai-2018
-// Controller:  STM32F100RB
-// IDE       :  Vision V5.25.2.0
-// Compiler  :  Armcc
-// Brief     :  I2C hardware abstraction layer
-//==============================================================================
-
-#include "i2c_hal.h"
-#include "system.h"
-
-//-- Defines for IO-Pins -------------------------------------------------------
-// SDA on port B, bit 9
-/* -- adapt this code for your platform -- */
-#define SDA_LOW()  (GPIOB->BSRR = 0x02000000) // set SDA to low
-#define SDA_OPEN() (GPIOB->BSRR = 0x00000200) // set SDA to open-drain
-#define SDA_READ   (GPIOB->IDR  & 0x0200)     // read SDA
-
-// SCL on port B, bit 8
-/* -- adapt this code for your platform -- */
-#define SCL_LOW()  (GPIOB->BSRR = 0x01000000) // set SCL to low
-#define SCL_OPEN() (GPIOB->BSRR = 0x00000100) // set SCL to open-drain
-#define SCL_READ   (GPIOB->IDR  & 0x0100)     // read SCL
-
-//------------------------------------------------------------------------------
-/* -- adapt this code for your platform -- */
-void I2c_Init(void)
-{
-  RCC->APB2ENR |= 0x00000008;  // I/O port B clock enabled
-
-  SDA_OPEN();                  // I2C-bus idle mode SDA released
-  SCL_OPEN();                  // I2C-bus idle mode SCL released
-
-  // SDA on port B, bit 9
-  // SCL on port B, bit 8
-  GPIOB->CRH   &= 0xFFFFFF00;  // set open-drain output for SDA and SCL
-  GPIOB->CRH   |= 0x00000055;  //
-}
-
-//------------------------------------------------------------------------------
-void I2c_StartCondition(void)
-{
-  SDA_OPEN();
-  System_DelayUs(2);
-  SCL_OPEN();
-  System_DelayUs(2);
-  SDA_LOW();
-  System_DelayUs(10);
-  SCL_LOW();
-  System_DelayUs(10);
-}
-
-//------------------------------------------------------------------------------
-void I2c_StopCondition(void)
-{
-  SCL_LOW();
-  System_DelayUs(2);
-  SDA_LOW();
-  System_DelayUs(2);
-  SCL_OPEN();
-  System_DelayUs(10);
-  SDA_OPEN();
-  System_DelayUs(10);
-}
-
-//------------------------------------------------------------------------------
-etError I2c_WriteByte(uint8_t txByte)
-{
-  etError error = NO_ERROR;
-
-  for(uint8_t mask = 0x80; mask > 0; mask >>= 1) {
-    // masking txByte
-    if((mask & txByte) == 0) {
-      SDA_LOW();  // write 0 to SDA-Line
-    } else {
-      SDA_OPEN(); // write 1 to SDA-Line
-    }
-
-    // data set-up time
-    System_DelayUs(2);
-
-    // generate clock pulse on SCL
-    SCL_OPEN();
-    System_DelayUs(10);
-    SCL_LOW();
-
-    // data hold time
-    System_DelayUs(2);
-  }
-
-  // release SDA-line
-  SDA_OPEN();
-
-  // ack reading
-  SCL_OPEN();
-  System_DelayUs(2);
-
-  // check ack from i2c slave
-  if(SDA_READ) {
-    error = ACK_ERROR;
-  }
-
-  SCL_LOW();
-  
-  // wait to see byte package on scope
-  System_DelayUs(20);
-
-  return error;
-}
-
-//------------------------------------------------------------------------------
-uint8_t I2c_ReadByte(etI2cAck ack)
-{
-  uint8_t rxByte = 0;
-
-  // release SDA-line
-  SDA_OPEN();
-
-  for(uint8_t mask = 0x80; mask > 0; mask >>= 1) {
-    SCL_OPEN();
-    System_DelayUs(6);
-
-    // read bit
-    if(SDA_READ) {
-      rxByte = rxByte | mask;
-    }
-
-    SCL_LOW();
-    System_DelayUs(2);
-  }
-
-  // send acknowledge if necessary
-  if(ack == ACK) {
-    SDA_LOW();
-  } else {
-    SDA_OPEN();
-  }
-
-  // data set-up time
-  System_DelayUs(2);
-
-  // generate clock pulse on SCL
-  SCL_OPEN();
-  System_DelayUs(10);
-  SCL_LOW();
-
-  // release SDA-line
-  SDA_OPEN();
-  
-  // wait to see byte package on scope
-  System_DelayUs(20);
-
-  return rxByte;
-}
-
-//------------------------------------------------------------------------------
-etError I2c_GeneralCallReset(void)
-{
-  etError error;
-  
-  I2c_StartCondition();
-  
-  error = I2c_WriteByte(0x00);
-  
-  if(error == NO_ERROR) {
-    error = I2c_WriteByte(0x06);
-  }
-  
-  return error;
-}
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  i2c_hal.c
+// Author    :  RFU
+// Date      :  17-Mai-2018
+// Controller:  STM32F100RB
+// IDE       :  µVision V5.25.2.0
+// Compiler  :  Armcc
+// Brief     :  I2C hardware abstraction layer
+//==============================================================================
+
+#include "i2c_hal.h"
+#include "system.h"
+#include "instrument.h"
+
+//-- Shared by both backends ---------------------------------------------------
+
+// timing profiles, the fields in the order of tI2cTiming
+//  sclHz  tLow tHigh SuSta HdSta SuSto  tBuf    gap stretch
+const tI2cTiming I2c_TimingStandard = {
+   100000, 4700, 4000, 4700, 4000, 4000, 4700,     0, 1000};
+const tI2cTiming I2c_TimingFast     = {
+   400000, 1300,  600,  600,  600,  600, 1300,     0, 1000};
+const tI2cTiming I2c_TimingFastPlus = {
+  1000000,  500,  260,  260,  260,  260,  500,     0, 1000};
+const tI2cTiming I2c_TimingScope    = {
+   100000, 4700, 4000, 4700, 4000, 4000, 4700, 20000, 1000};
+
+//------------------------------------------------------------------------------
+etError I2c_Transfer(uint8_t address, const uint8_t txBytes[], uint8_t txLen,
+                     uint8_t rxBytes[], uint8_t rxLen, uint8_t flags)
+{
+  etError error = NO_ERROR; // error code
+  uint8_t byteCtr;          // byte counter
+  
+  // write phase, also used for an address only transfer
+  if(txLen > 0 || rxLen == 0) {
+    I2c_StartCondition();
+    error = I2c_WriteByte(address << 1);
+    for(byteCtr = 0; byteCtr < txLen && error == NO_ERROR; byteCtr++) {
+      error = I2c_WriteByte(txBytes[byteCtr]);
+    }
+  }
+  
+  // read phase, after a write phase with a repeated start condition
+  if(error == NO_ERROR && rxLen > 0) {
+    I2c_StartCondition();
+    error = I2c_WriteByte(address << 1 | 0x01);
+    if(error == NO_ERROR) {
+      I2c_ReadBytes(rxBytes, rxLen, NO_ACK);
+      
+      // a stuck SCL corrupts the read data
+      if(I2c_ClockStretchTimeout()) {
+        error = TIMEOUT_ERROR;
+      }
+    }
+  }
+  
+  // a failed transfer always releases the bus
+  if(error != NO_ERROR || !(flags & I2C_NO_STOP)) {
+    I2c_StopCondition();
+  }
+  
+  return error;
+}
+
+#ifndef I2C_HAL_HARDWARE
+
+//-- Defines for IO-Pins -------------------------------------------------------
+// SDA and SCL of the selected bus
+#define SDA_LOW()  GPIO_WRITE_BSRR(bus->port, (uint32_t)bus->sdaPin << 16)
+#define SDA_OPEN() GPIO_WRITE_BSRR(bus->port, bus->sdaPin) // open-drain
+#define SDA_READ   (GPIO_READ_IDR(bus->port) & bus->sdaPin) // read SDA
+
+#define SCL_LOW()  GPIO_WRITE_BSRR(bus->port, (uint32_t)bus->sclPin << 16)
+#define SCL_OPEN() GPIO_WRITE_BSRR(bus->port, bus->sclPin) // open-drain
+#define SCL_READ   (GPIO_READ_IDR(bus->port) & bus->sclPin) // read SCL
+
+// SDA on port B, bit 9
+// SCL on port B, bit 8
+/* -- adapt this code for your platform -- */
+const tI2cBus I2c_DefaultBus = {GPIOB, 0x0200, 0x0100};
+
+static const tI2cBus*    bus    = &I2c_DefaultBus;      // selected bus
+static const tI2cTiming* timing = &I2c_TimingStandard; // selected timing
+static bool              sclTimeout;                   // SCL stuck low
+
+static void ConfigOpenDrain(GPIO_TypeDef* port, uint16_t pin);
+static void SclRelease(void);
+
+//------------------------------------------------------------------------------
+void I2c_Init(void)
+{
+  I2c_InitBus(&I2c_DefaultBus);
+  I2c_SelectBus(&I2c_DefaultBus);
+}
+
+//------------------------------------------------------------------------------
+/* -- adapt this code for your platform -- */
+void I2c_InitBus(const tI2cBus* initBus)
+{
+  // I/O port clock enabled (port A = bit 2, port B = bit 3, ...)
+  RCC->APB2ENR |= 0x00000004 <<
+                  (((uintptr_t)initBus->port - GPIOA_BASE) / 0x400);
+
+  // I2C-bus idle mode SDA and SCL released
+  GPIO_WRITE_BSRR(initBus->port, initBus->sdaPin | initBus->sclPin);
+
+  // set open-drain output for SDA and SCL
+  ConfigOpenDrain(initBus->port, initBus->sdaPin);
+  ConfigOpenDrain(initBus->port, initBus->sclPin);
+}
+
+//------------------------------------------------------------------------------
+void I2c_SelectBus(const tI2cBus* selectBus)
+{
+  bus = selectBus;
+}
+
+//------------------------------------------------------------------------------
+void I2c_SetTiming(const tI2cTiming* setTiming)
+{
+  timing = setTiming;
+}
+
+//------------------------------------------------------------------------------
+const tI2cTiming* I2c_GetTiming(void)
+{
+  return timing;
+}
+
+//------------------------------------------------------------------------------
+bool I2c_ClockStretchTimeout(void)
+{
+  return sclTimeout;
+}
+
+//------------------------------------------------------------------------------
+void I2c_StartCondition(void)
+{
+  sclTimeout = false;
+
+  SDA_OPEN();
+  System_DelayNs(timing->tLowNs);
+  SclRelease();
+  System_DelayNs(timing->tSuStaNs);
+  SDA_LOW();
+  System_DelayNs(timing->tHdStaNs);
+  SCL_LOW();
+}
+
+//------------------------------------------------------------------------------
+void I2c_StopCondition(void)
+{
+  SCL_LOW();
+  SDA_LOW();
+  System_DelayNs(timing->tLowNs);
+  SclRelease();
+  System_DelayNs(timing->tSuStoNs);
+  SDA_OPEN();
+  System_DelayNs(timing->tBufNs);
+}
+
+//------------------------------------------------------------------------------
+etError I2c_WriteByte(uint8_t txByte)
+{
+  etError error = NO_ERROR;
+
+  for(uint8_t mask = 0x80; mask > 0; mask >>= 1) {
+    // masking txByte
+    if((mask & txByte) == 0) {
+      SDA_LOW();  // write 0 to SDA-Line
+    } else {
+      SDA_OPEN(); // write 1 to SDA-Line
+    }
+
+    // SCL low period, includes data set-up time
+    System_DelayNs(timing->tLowNs);
+
+    // generate clock pulse on SCL
+    SclRelease();
+    System_DelayNs(timing->tHighNs);
+    SCL_LOW();
+  }
+
+  // release SDA-line
+  SDA_OPEN();
+
+  // ack reading
+  System_DelayNs(timing->tLowNs);
+  SclRelease();
+  System_DelayNs(timing->tHighNs);
+
+  // check ack from i2c slave
+  if(SDA_READ) {
+    error = ACK_ERROR;
+    INSTR_COUNT(nacks);
+  }
+  INSTR_COUNT(bytesWritten);
+
+  SCL_LOW();
+
+  if(sclTimeout) {
+    error = TIMEOUT_ERROR;
+  }
+
+  // additional gap, e.g. to see byte packages on scope
+  if(timing->tByteGapNs > 0) {
+    System_DelayNs(timing->tByteGapNs);
+  }
+
+  return error;
+}
+
+//------------------------------------------------------------------------------
+uint8_t I2c_ReadByte(etI2cAck ack)
+{
+  uint8_t rxByte = 0;
+
+  // release SDA-line
+  SDA_OPEN();
+
+  for(uint8_t mask = 0x80; mask > 0; mask >>= 1) {
+    // SCL low period, slave shifts out the next bit
+    System_DelayNs(timing->tLowNs);
+
+    SclRelease();
+    System_DelayNs(timing->tHighNs);
+
+    // read bit
+    if(SDA_READ) {
+      rxByte = rxByte | mask;
+    }
+
+    SCL_LOW();
+  }
+
+  // send acknowledge if necessary
+  if(ack == ACK) {
+    SDA_LOW();
+  } else {
+    SDA_OPEN();
+  }
+
+  // SCL low period, includes data set-up time
+  System_DelayNs(timing->tLowNs);
+
+  // generate clock pulse on SCL
+  SclRelease();
+  System_DelayNs(timing->tHighNs);
+  SCL_LOW();
+
+  // release SDA-line
+  SDA_OPEN();
+  INSTR_COUNT(bytesRead);
+
+  // additional gap, e.g. to see byte packages on scope
+  if(timing->tByteGapNs > 0) {
+    System_DelayNs(timing->tByteGapNs);
+  }
+
+  return rxByte;
+}
+
+//------------------------------------------------------------------------------
+void I2c_ReadBytes(uint8_t rxBytes[], uint8_t nbrOfBytes, etI2cAck lastAck)
+{
+  uint8_t byteCtr; // byte counter
+
+  for(byteCtr = 0; byteCtr < nbrOfBytes; byteCtr++) {
+    rxBytes[byteCtr] = I2c_ReadByte((byteCtr + 1 < nbrOfBytes) ? ACK : lastAck);
+  }
+}
+
+//------------------------------------------------------------------------------
+etError I2c_GeneralCallReset(void)
+{
+  etError error;
+  
+  I2c_StartCondition();
+  
+  error = I2c_WriteByte(0x00);
+  
+  if(error == NO_ERROR) {
+    error = I2c_WriteByte(0x06);
+  }
+  
+  I2c_StopCondition();
+  
+  return error;
+}
+
+//------------------------------------------------------------------------------
+etError I2c_BusClear(void)
+{
+  uint8_t clocks; // SCL clocks
+  
+  sclTimeout = false;
+  SDA_OPEN();
+  
+  // a slave holding SDA low transmits a byte, it releases SDA for the
+  // acknowledge after at most 9 clocks
+  for(clocks = 0; clocks < 9 && !SDA_READ && !sclTimeout; clocks++) {
+    SCL_LOW();
+    System_DelayNs(timing->tLowNs);
+    SclRelease();
+    System_DelayNs(timing->tHighNs);
+  }
+  
+  if(!SDA_READ || sclTimeout) {
+    return TIMEOUT_ERROR;
+  }
+  
+  I2c_StopCondition();
+  
+  return NO_ERROR;
+}
+
+//------------------------------------------------------------------------------
+/* -- adapt this code for your platform -- */
+static void ConfigOpenDrain(GPIO_TypeDef* port, uint16_t pin)
+{
+  uint8_t pinNbr = 0; // pin number 0..15
+  
+  while((pin >> pinNbr) > 1) pinNbr++;
+  
+  // general purpose output open-drain, 10MHz (CNF = 01, MODE = 01)
+  if(pinNbr < 8) {
+    port->CRL &= ~(0xFUL << (pinNbr * 4));
+    port->CRL |=  (0x5UL << (pinNbr * 4));
+  } else {
+    port->CRH &= ~(0xFUL << ((pinNbr - 8) * 4));
+    port->CRH |=  (0x5UL << ((pinNbr - 8) * 4));
+  }
+}
+
+//------------------------------------------------------------------------------
+static void SclRelease(void)
+{
+  uint16_t timeout = timing->stretchTimeoutUs; // remaining stretch time [us]
+
+  SCL_OPEN();
+
+  // a slave may hold SCL low (clock stretching), wait until it is released
+  if(timeout > 0) {
+    while(!SCL_READ && !sclTimeout) {
+      if(timeout-- == 0) {
+        sclTimeout = true;
+      } else {
+        System_DelayUs(1);
+      }
+    }
+  }
+}
+
+#endif /* I2C_HAL_HARDWARE */
@@ -1,78 +1,202 @@
-//==============================================================================
-// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
-//==============================================================================
-// Project   :  SHT3x Sample Code
-// File      :  i2c_hal.h
-// Author    :  RFU
-// Date      :  17-Mai-2018
-// Controller:  STM32F100RB
-// IDE       :  Vision V5.25.2.0
-// Compiler  :  Armcc
-// Brief     :  I2C hardware abstraction layer 
-//==============================================================================
-
-#ifndef I2C_HAL_H
-#define I2C_HAL_H
-
-#include "system.h"
-#include <stdint.h>
-
-typedef enum{
-  ACK    = 0,
-  NO_ACK = 1,
-}etI2cAck;
-
-//==============================================================================
-void I2c_Init(void);
-//==============================================================================
-// Initializes the ports for I2C interface.
-//------------------------------------------------------------------------------
-
-//==============================================================================
-void I2c_StartCondition(void);
-//==============================================================================
-// Writes a start condition on I2C-Bus.
-//------------------------------------------------------------------------------
-//       _____
-// SDA:       |_____
-//       _______
-// SCL:         |___
-
-//==============================================================================
-void I2c_StopCondition(void);
-//==============================================================================
-// Writes a stop condition on I2C-Bus.
-//------------------------------------------------------------------------------
-//              _____
-// SDA:   _____|
-//            _______
-// SCL:   ___|
-
-//==============================================================================
-etError I2c_WriteByte(uint8_t txByte);
-//==============================================================================
-// Writes a byte to I2C-Bus and checks acknowledge.
-//------------------------------------------------------------------------------
-// input:  txByte       transmit byte
-//
-// return: error:       ACK_ERROR = no acknowledgment
-//                      NO_ERROR  = no error
-
-//==============================================================================
-uint8_t I2c_ReadByte(etI2cAck ack);
-//==============================================================================
-// Reads a byte on I2C-Bus.
-//------------------------------------------------------------------------------
-// input:  ack          Acknowledge: ACK or NO_ACK
-//
-// return: rxByte
-
-//==============================================================================
-etError I2c_GeneralCallReset(void);
-//==============================================================================
-// Reset all i2c devices through general call.
-//------------------------------------------------------------------------------
-// return: error:       ACK_ERROR = no acknowledgment
-//                      NO_ERROR  = no error
-
-#endif
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT3x Sample Code
+// File      :  i2c_hal.h
+// Author    :  RFU
+// Date      :  17-Mai-2018
+// Controller:  STM32F100RB
+// IDE       :  µVision V5.25.2.0
+// Compiler  :  Armcc
+// Brief     :  I2C hardware abstraction layer 
+//==============================================================================
+
+#ifndef I2C_HAL_H
+#define I2C_HAL_H
+
+#include "system.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// I2C backend selection
+// The API below is implemented by two backends, selected at compile time:
+//   - i2c_hal.c    : "bit-banging" on normal I/O's (default)
+//   - i2c_hal_hw.c : I2C1 peripheral (PB8/PB9 remap) with DMA for multi-byte
+//                    reads, enabled by defining I2C_HAL_HARDWARE
+// #define I2C_HAL_HARDWARE
+
+// I2C transfer flags
+#define I2C_NO_STOP  0x01 // no stop condition, the next transfer begins with a
+                          // repeated start condition
+
+typedef enum{
+  ACK    = 0,
+  NO_ACK = 1,
+}etI2cAck;
+
+// I2C bus pin descriptor (SDA and SCL on the same port)
+typedef struct{
+  GPIO_TypeDef* port;   // GPIO port of SDA and SCL
+  uint16_t      sdaPin; // SDA pin mask, e.g. 0x0200 for bit 9
+  uint16_t      sclPin; // SCL pin mask, e.g. 0x0100 for bit 8
+}tI2cBus;
+
+// default bus: SDA on port B, bit 9 / SCL on port B, bit 8
+extern const tI2cBus I2c_DefaultBus;
+
+// I2C bus timing profile, minimum values of the I2C specification
+typedef struct{
+  uint32_t sclHz;            // nominal SCL frequency [Hz] (hardware backend)
+  uint16_t tLowNs;           // SCL low period, includes data set-up time [ns]
+  uint16_t tHighNs;          // SCL high period [ns]
+  uint16_t tSuStaNs;         // set-up time for a (repeated) start [ns]
+  uint16_t tHdStaNs;         // hold time for a start condition [ns]
+  uint16_t tSuStoNs;         // set-up time for a stop condition [ns]
+  uint16_t tBufNs;           // bus free time between stop and start [ns]
+  uint16_t tByteGapNs;       // additional SCL low time after each byte [ns]
+  uint16_t stretchTimeoutUs; // max. clock stretching by a slave [us], 0 = off
+}tI2cTiming;
+
+// predefined timing profiles
+extern const tI2cTiming I2c_TimingStandard; // 100kHz
+extern const tI2cTiming I2c_TimingFast;     // 400kHz
+extern const tI2cTiming I2c_TimingFastPlus; // 1MHz, limited by the core clock
+extern const tI2cTiming I2c_TimingScope;    // 100kHz, gap after each byte
+
+//==============================================================================
+void I2c_Init(void);
+//==============================================================================
+// Initializes the ports for I2C interface on the default bus and selects it.
+//------------------------------------------------------------------------------
+
+//==============================================================================
+void I2c_InitBus(const tI2cBus* bus);
+//==============================================================================
+// Initializes the ports of a bus for I2C interface.
+//------------------------------------------------------------------------------
+// input:  bus          bus pin descriptor
+// remark: the hardware backend supports only the I2C1 bus (PB8/PB9)
+
+//==============================================================================
+void I2c_SelectBus(const tI2cBus* bus);
+//==============================================================================
+// Selects the bus used by all following bus accesses.
+//------------------------------------------------------------------------------
+// input:  bus          bus pin descriptor
+
+//==============================================================================
+void I2c_SetTiming(const tI2cTiming* timing);
+//==============================================================================
+// Sets the timing profile of all buses, e.g. the fastest profile the wiring
+// allows. Default: I2c_TimingStandard (bit-bang), I2c_TimingFast (hardware).
+//------------------------------------------------------------------------------
+// input:  timing       timing profile, must remain valid while it is in use
+// remark: the hardware backend uses only sclHz, limited to 400kHz
+
+//==============================================================================
+const tI2cTiming* I2c_GetTiming(void);
+//==============================================================================
+// Gets the selected timing profile.
+//------------------------------------------------------------------------------
+
+//==============================================================================
+bool I2c_ClockStretchTimeout(void);
+//==============================================================================
+// Checks if a slave held SCL low longer than the stretch timeout of the timing
+// profile since the last start condition. The transfer is then corrupted.
+//------------------------------------------------------------------------------
+// return: true if SCL was stuck low
+// remark: the hardware backend waits for SCL by itself and returns false
+
+//==============================================================================
+void I2c_StartCondition(void);
+//==============================================================================
+// Writes a start condition on I2C-Bus.
+//------------------------------------------------------------------------------
+//       _____
+// SDA:       |_____
+//       _______
+// SCL:         |___
+
+//==============================================================================
+void I2c_StopCondition(void);
+//==============================================================================
+// Writes a stop condition on I2C-Bus.
+//------------------------------------------------------------------------------
+//              _____
+// SDA:   _____|
+//            _______
+// SCL:   ___|
+
+//==============================================================================
+etError I2c_WriteByte(uint8_t txByte);
+//==============================================================================
+// Writes a byte to I2C-Bus and checks acknowledge.
+//------------------------------------------------------------------------------
+// input:  txByte       transmit byte
+//
+// return: error:       ACK_ERROR     = no acknowledgment
+//                      TIMEOUT_ERROR = SCL held low too long (bit-bang)
+//                      NO_ERROR      = no error
+
+//==============================================================================
+uint8_t I2c_ReadByte(etI2cAck ack);
+//==============================================================================
+// Reads a byte on I2C-Bus.
+//------------------------------------------------------------------------------
+// input:  ack          Acknowledge: ACK or NO_ACK
+//
+// return: rxByte
+
+//==============================================================================
+void I2c_ReadBytes(uint8_t rxBytes[], uint8_t nbrOfBytes, etI2cAck lastAck);
+//==============================================================================
+// Reads several bytes on I2C-Bus. All bytes except the last one are
+// acknowledged.
+//------------------------------------------------------------------------------
+// input:  rxBytes      pointer to receive buffer
+//         nbrOfBytes   number of bytes to read
+//         lastAck      Acknowledge of the last byte: ACK or NO_ACK
+
+//==============================================================================
+etError I2c_Transfer(uint8_t address, const uint8_t txBytes[], uint8_t txLen,
+                     uint8_t rxBytes[], uint8_t rxLen, uint8_t flags);
+//==============================================================================
+// Executes a complete transfer with a device on the selected bus:
+// start, address + write, txBytes, repeated start, address + read, rxBytes,
+// stop. The write phase is omitted if txLen is 0 (unless rxLen is 0 too: then
+// only the address is written), the read phase if rxLen is 0. The last read
+// byte is not acknowledged.
+//------------------------------------------------------------------------------
+// input:  address      7-bit I2C address
+//         txBytes      bytes to write
+//         txLen        number of bytes to write
+//         rxBytes      buffer for the read bytes
+//         rxLen        number of bytes to read
+//         flags        I2C_NO_STOP or 0
+//
+// return: error:       ACK_ERROR     = no acknowledgment
+//                      TIMEOUT_ERROR = SCL held low too long (bit-bang)
+//                      NO_ERROR      = no error
+// remark: a failed transfer is always terminated by a stop condition
+
+//==============================================================================
+etError I2c_GeneralCallReset(void);
+//==============================================================================
+// Reset all i2c devices through general call.
+//------------------------------------------------------------------------------
+// return: error:       ACK_ERROR = no acknowledgment
+//                      NO_ERROR  = no error
+
+//==============================================================================
+etError I2c_BusClear(void);
+//==============================================================================
+// Frees a bus whose SDA is held low by a slave, e.g. after a reset of the
+// controller in the middle of a read: SCL is clocked up to 9 times until the
+// slave releases SDA, then a stop condition ends whatever the slaves consider
+// to be in progress.
+//------------------------------------------------------------------------------
+// return: error:       TIMEOUT_ERROR = SDA or SCL still low
+//                      NO_ERROR      = bus free
+
+#endif
@@ -0,0 +1,375 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  i2c_hal_hw.c
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  STM32F100RB
+// IDE       :  µVision V5.25.2.0
+// Compiler  :  Armcc
+// Brief     :  I2C hardware abstraction layer, I2C1 peripheral backend
+//              SCL on PB8, SDA on PB9 (I2C1 remap). Multi-byte reads are done
+//              by DMA1 channel 7, the peripheral generates the NACK of the last
+//              byte by itself (LAST bit).
+//==============================================================================
+
+#include "i2c_hal.h"
+#include "system.h"
+#include "instrument.h"
+#include <stdbool.h>
+
+#ifdef I2C_HAL_HARDWARE
+
+//-- Defines for bus timing ----------------------------------------------------
+/* -- adapt this code for your platform -- */
+#define I2C_PCLK1_MHZ   8      // APB1 clock [MHz] (HSI, no prescaler)
+#define I2C_MAX_SCL_HZ  400000 // peripheral supports standard- and fast-mode
+#define I2C_HW_TIMEOUT  10000  // flag polling timeout [loop iterations]
+
+// read-modify-write of I2C1 register bits
+#define I2C_SET_BITS(reg, mask) \
+  I2C_WRITE_REG(reg, I2C_READ_REG(reg) | (mask))
+#define I2C_CLEAR_BITS(reg, mask) \
+  I2C_WRITE_REG(reg, I2C_READ_REG(reg) & ~(mask))
+
+// SDA on port B, bit 9
+// SCL on port B, bit 8
+const tI2cBus I2c_DefaultBus = {GPIOB, 0x0200, 0x0100};
+
+// transfer state, the hardware is always one step ahead of the byte-oriented
+// API, so some actions have to be deferred to the next call
+static bool addressPhase; // next written byte is the address byte
+static bool addrPending;  // read address acknowledged, ADDR not yet cleared
+static bool stopPending;  // stop condition already requested by a read
+
+static const tI2cTiming* timing = &I2c_TimingFast; // selected timing
+
+static bool WaitFlag(uint16_t mask);
+static bool WaitAddrOrAf(void);
+static void ClearAddr(void);
+
+//------------------------------------------------------------------------------
+/* -- adapt this code for your platform -- */
+void I2c_Init(void)
+{
+  RCC->APB2ENR |= RCC_APB2ENR_IOPBEN | RCC_APB2ENR_AFIOEN;
+  RCC->APB1ENR |= RCC_APB1ENR_I2C1EN;
+  RCC->AHBENR  |= RCC_AHBENR_DMA1EN;
+
+  // SCL on port B, bit 8
+  // SDA on port B, bit 9
+  AFIO->MAPR   |= AFIO_MAPR_I2C1_REMAP;
+  GPIOB->CRH   &= 0xFFFFFF00;  // set alternate function open-drain output
+  GPIOB->CRH   |= 0x000000DD;  // for SDA and SCL
+
+  // reset and configure peripheral
+  I2C_WRITE_REG(CR1, I2C_CR1_SWRST);
+  I2C_WRITE_REG(CR1, 0);
+  I2C_WRITE_REG(CR2, I2C_PCLK1_MHZ);
+  I2c_SetTiming(timing); // sets CCR and TRISE, enables the peripheral
+
+  // DMA1 channel 7: I2C1_RX, peripheral to memory, memory increment
+  DMA1_Channel7->CCR  = 0;
+  DMA1_Channel7->CPAR = DMA_ADDRESS(&I2C1->DR);
+
+  addressPhase = false;
+  addrPending  = false;
+  stopPending  = false;
+}
+
+//------------------------------------------------------------------------------
+void I2c_InitBus(const tI2cBus* bus)
+{
+  // only one bus available: I2C1
+  (void)bus;
+  I2c_Init();
+}
+
+//------------------------------------------------------------------------------
+void I2c_SelectBus(const tI2cBus* bus)
+{
+  // only one bus available: I2C1
+  (void)bus;
+}
+
+//------------------------------------------------------------------------------
+void I2c_SetTiming(const tI2cTiming* setTiming)
+{
+  uint32_t sclHz = setTiming->sclHz; // SCL frequency [Hz]
+
+  timing = setTiming;
+
+  if(sclHz > I2C_MAX_SCL_HZ) {
+    sclHz = I2C_MAX_SCL_HZ;
+  }
+
+  // CCR and TRISE can only be written while the peripheral is disabled
+  I2C_CLEAR_BITS(CR1, I2C_CR1_PE);
+
+  if(sclHz > 100000) {
+    // Fast-mode, Tlow/Thigh = 2, CCR = PCLK1 / (3 * f) rounded up
+    I2C_WRITE_REG(CCR, I2C_CCR_FS | ((I2C_PCLK1_MHZ * 1000000 + 3 * sclHz - 1) /
+                                     (3 * sclHz)));
+    I2C_WRITE_REG(TRISE, (I2C_PCLK1_MHZ * 300) / 1000 + 1); // max. 300ns
+  } else {
+    // Standard-mode, Tlow/Thigh = 1, CCR = PCLK1 / (2 * f)
+    I2C_WRITE_REG(CCR, (I2C_PCLK1_MHZ * 1000000) / (2 * sclHz));
+    I2C_WRITE_REG(TRISE, I2C_PCLK1_MHZ + 1);                // max. 1000ns
+  }
+
+  I2C_SET_BITS(CR1, I2C_CR1_PE);
+}
+
+//------------------------------------------------------------------------------
+const tI2cTiming* I2c_GetTiming(void)
+{
+  return timing;
+}
+
+//------------------------------------------------------------------------------
+bool I2c_ClockStretchTimeout(void)
+{
+  // the peripheral waits for a stretched SCL by itself
+  return false;
+}
+
+//------------------------------------------------------------------------------
+void I2c_StartCondition(void)
+{
+  I2C_SET_BITS(CR1, I2C_CR1_START);
+  WaitFlag(I2C_SR1_SB);
+
+  addressPhase = true;
+  addrPending  = false;
+  stopPending  = false;
+}
+
+//------------------------------------------------------------------------------
+void I2c_StopCondition(void)
+{
+  uint32_t timeout = I2C_HW_TIMEOUT;
+
+  // a read with NO_ACK has already requested the stop condition
+  if(!stopPending) {
+    if(addrPending) {
+      ClearAddr();
+    }
+    I2C_SET_BITS(CR1, I2C_CR1_STOP);
+  }
+
+  // wait until the stop condition is on the bus
+  while((I2C_READ_REG(CR1) & I2C_CR1_STOP) && timeout--);
+
+  addressPhase = false;
+  addrPending  = false;
+  stopPending  = false;
+}
+
+//------------------------------------------------------------------------------
+etError I2c_WriteByte(uint8_t txByte)
+{
+  etError error = NO_ERROR;
+
+  I2C_WRITE_REG(DR, txByte);
+
+  if(addressPhase) {
+    addressPhase = false;
+
+    // wait for address acknowledge or no acknowledge
+    if(!WaitAddrOrAf()) {
+      error = ACK_ERROR;
+    } else if(txByte & 0x01) {
+      // read access: ADDR is cleared by the first read, after the ACK control
+      // for the first byte is set up
+      addrPending = true;
+    } else {
+      ClearAddr();
+    }
+  } else {
+    // wait until byte is transmitted and acknowledged
+    if(!WaitFlag(I2C_SR1_BTF | I2C_SR1_AF) ||
+       (I2C_READ_REG(SR1) & I2C_SR1_AF)) {
+      error = ACK_ERROR;
+    }
+  }
+
+  if(error != NO_ERROR) {
+    I2C_CLEAR_BITS(SR1, I2C_SR1_AF); // clear acknowledge failure flag
+    INSTR_COUNT(nacks);
+  }
+  INSTR_COUNT(bytesWritten);
+
+  return error;
+}
+
+//------------------------------------------------------------------------------
+uint8_t I2c_ReadByte(etI2cAck ack)
+{
+  // the ACK bit has to be set up before the byte is completely received
+  if(ack == ACK) {
+    I2C_SET_BITS(CR1, I2C_CR1_ACK);
+  } else {
+    I2C_CLEAR_BITS(CR1, I2C_CR1_ACK);
+  }
+
+  if(addrPending) {
+    addrPending = false;
+    ClearAddr();
+  }
+
+  // a not acknowledged byte is the last one, program the stop condition
+  // before reading the data register, otherwise a further byte is received
+  if(ack == NO_ACK) {
+    I2C_SET_BITS(CR1, I2C_CR1_STOP);
+    stopPending = true;
+  }
+
+  WaitFlag(I2C_SR1_RXNE);
+  INSTR_COUNT(bytesRead);
+
+  return (uint8_t)I2C_READ_REG(DR);
+}
+
+//------------------------------------------------------------------------------
+void I2c_ReadBytes(uint8_t rxBytes[], uint8_t nbrOfBytes, etI2cAck lastAck)
+{
+  uint32_t timeout = I2C_HW_TIMEOUT;
+
+  // DMA needs at least two bytes to generate the NACK of the last byte
+  if(nbrOfBytes < 2) {
+    if(nbrOfBytes == 1) {
+      rxBytes[0] = I2c_ReadByte(lastAck);
+    }
+    return;
+  }
+
+  DMA1->IFCR = DMA_IFCR_CGIF7;
+  DMA1_Channel7->CMAR  = DMA_ADDRESS(rxBytes);
+  DMA1_Channel7->CNDTR = nbrOfBytes;
+  DMA1_Channel7->CCR   = DMA_CCR7_MINC | DMA_CCR7_EN;
+
+  I2C_SET_BITS(CR1, I2C_CR1_ACK);
+  if(lastAck == NO_ACK) {
+    I2C_SET_BITS(CR2, I2C_CR2_DMAEN | I2C_CR2_LAST);
+  } else {
+    I2C_SET_BITS(CR2, I2C_CR2_DMAEN);
+  }
+
+  // clearing ADDR starts the reception
+  if(addrPending) {
+    addrPending = false;
+    ClearAddr();
+  }
+
+  // wait for DMA transfer complete
+  while(!(DMA1->ISR & DMA_ISR_TCIF7) && timeout--);
+
+  if(lastAck == NO_ACK) {
+    I2C_SET_BITS(CR1, I2C_CR1_STOP);
+    stopPending = true;
+  }
+
+  I2C_CLEAR_BITS(CR2, I2C_CR2_DMAEN | I2C_CR2_LAST);
+  DMA1_Channel7->CCR = 0;
+  DMA1->IFCR = DMA_IFCR_CGIF7;
+  INSTR_ADD(bytesRead, nbrOfBytes);
+}
+
+//------------------------------------------------------------------------------
+etError I2c_GeneralCallReset(void)
+{
+  etError error;
+
+  I2c_StartCondition();
+
+  error = I2c_WriteByte(0x00);
+
+  if(error == NO_ERROR) {
+    error = I2c_WriteByte(0x06);
+  }
+
+  I2c_StopCondition();
+
+  return error;
+}
+
+//------------------------------------------------------------------------------
+/* -- adapt this code for your platform -- */
+etError I2c_BusClear(void)
+{
+  etError error = NO_ERROR; // error code
+  uint8_t clocks;           // SCL clocks
+
+  // the peripheral does not clock SCL without a start condition, which it
+  // cannot generate while SDA is low: switch the pins to general purpose
+  // open-drain outputs
+  I2C_CLEAR_BITS(CR1, I2C_CR1_PE);
+  GPIO_WRITE_BSRR(GPIOB, 0x0300);
+  GPIOB->CRH &= 0xFFFFFF00;
+  GPIOB->CRH |= 0x00000055;
+
+  // a slave holding SDA low transmits a byte, it releases SDA for the
+  // acknowledge after at most 9 clocks
+  for(clocks = 0; clocks < 9 && !(GPIO_READ_IDR(GPIOB) & 0x0200); clocks++) {
+    GPIO_WRITE_BSRR(GPIOB, 0x0100 << 16); // SCL low
+    System_DelayUs(5);
+    GPIO_WRITE_BSRR(GPIOB, 0x0100);       // SCL released
+    System_DelayUs(5);
+  }
+
+  // stop condition
+  GPIO_WRITE_BSRR(GPIOB, 0x0100 << 16);   // SCL low
+  System_DelayUs(5);
+  GPIO_WRITE_BSRR(GPIOB, 0x0200 << 16);   // SDA low
+  System_DelayUs(5);
+  GPIO_WRITE_BSRR(GPIOB, 0x0100);         // SCL released
+  System_DelayUs(5);
+  GPIO_WRITE_BSRR(GPIOB, 0x0200);         // SDA released
+  System_DelayUs(5);
+
+  if((GPIO_READ_IDR(GPIOB) & 0x0300) != 0x0300) {
+    error = TIMEOUT_ERROR;
+  }
+
+  // back to the peripheral, the software reset also clears a BUSY flag
+  // latched by the glitch
+  I2c_Init();
+
+  return error;
+}
+
+//------------------------------------------------------------------------------
+static bool WaitFlag(uint16_t mask)
+{
+  uint32_t timeout = I2C_HW_TIMEOUT;
+
+  // flags of SR1
+  while(!(I2C_READ_REG(SR1) & mask)) {
+    if(timeout-- == 0) return false;
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+static bool WaitAddrOrAf(void)
+{
+  uint32_t timeout = I2C_HW_TIMEOUT;
+
+  while(!(I2C_READ_REG(SR1) & (I2C_SR1_ADDR | I2C_SR1_AF))) {
+    if(timeout-- == 0) return false;
+  }
+
+  return (I2C_READ_REG(SR1) & I2C_SR1_ADDR) != 0;
+}
+
+//------------------------------------------------------------------------------
+static void ClearAddr(void)
+{
+  // ADDR is cleared by reading SR1 followed by reading SR2
+  (void)I2C_READ_REG(SR1);
+  (void)I2C_READ_REG(SR2);
+}
+
+#endif /* I2C_HAL_HARDWARE */
@@ -0,0 +1,85 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  instrument.c
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  STM32F100RB
+// IDE       :  µVision V5.25.2.0
+// Compiler  :  Armcc
+// Brief     :  Optional instrumentation of the driver calls.
+//==============================================================================
+
+#include "instrument.h"
+
+#ifdef SHT85_INSTRUMENT
+
+tInstrStats Instr_Running; // counters of the running call
+
+static tInstrStats stats[INSTR_NBR_OF_OPS]; // counters per operation
+static uint8_t     depth;                   // nesting of the running calls
+static uint32_t    startCycles;             // start of the running call
+
+//------------------------------------------------------------------------------
+void Instr_Reset(void)
+{
+  uint8_t i; // operation index
+  
+  for(i = 0; i < INSTR_NBR_OF_OPS; i++) {
+    stats[i].calls        = 0;
+    stats[i].bytesWritten = 0;
+    stats[i].bytesRead    = 0;
+    stats[i].nacks        = 0;
+    stats[i].crcErrors    = 0;
+    stats[i].polls        = 0;
+    stats[i].cycles       = 0;
+    stats[i].maxCycles    = 0;
+  }
+}
+
+//------------------------------------------------------------------------------
+const tInstrStats* Instr_GetStats(etInstrOp op)
+{
+  return &stats[op];
+}
+
+//------------------------------------------------------------------------------
+void Instr_Begin(void)
+{
+  // nested calls add to the outermost one
+  if(depth++ > 0) {
+    return;
+  }
+  
+  Instr_Running.bytesWritten = 0;
+  Instr_Running.bytesRead    = 0;
+  Instr_Running.nacks        = 0;
+  Instr_Running.crcErrors    = 0;
+  Instr_Running.polls        = 0;
+  startCycles = System_GetCycles();
+}
+
+//------------------------------------------------------------------------------
+void Instr_End(etInstrOp op)
+{
+  tInstrStats* opStats = &stats[op];                       // op counters
+  uint32_t     cycles  = System_GetCycles() - startCycles; // call duration
+  
+  if(--depth > 0) {
+    return;
+  }
+  
+  opStats->calls++;
+  opStats->bytesWritten += Instr_Running.bytesWritten;
+  opStats->bytesRead    += Instr_Running.bytesRead;
+  opStats->nacks        += Instr_Running.nacks;
+  opStats->crcErrors    += Instr_Running.crcErrors;
+  opStats->polls        += Instr_Running.polls;
+  opStats->cycles       += cycles;
+  if(cycles > opStats->maxCycles) {
+    opStats->maxCycles = cycles;
+  }
+}
+
+#endif /* SHT85_INSTRUMENT */
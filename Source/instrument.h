@@ -0,0 +1,111 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  instrument.h
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  STM32F100RB
+// IDE       :  µVision V5.25.2.0
+// Compiler  :  Armcc
+// Brief     :  Optional instrumentation of the driver calls, enabled by
+//              defining SHT85_INSTRUMENT in the project settings. The public
+//              functions of sht85.c with bus access count per operation the
+//              calls, the bytes clocked on the bus, the NACKs, the checksum
+//              errors, the poll iterations and the duration in core cycles
+//              (DWT cycle counter). Without SHT85_INSTRUMENT the hooks are
+//              empty macros and the code is the same as without them.
+//
+//              Only the outermost call is counted: a call made by another
+//              instrumented call, also one from an interrupt (stream fetch)
+//              during a blocking call, adds to the running call.
+//==============================================================================
+
+#ifndef INSTRUMENT_H
+#define INSTRUMENT_H
+
+#include "system.h"
+#include <stdint.h>
+
+// Instrumented operations
+typedef enum {
+  INSTR_READ_SERIAL_NUMBER, // SHT85_ReadSerialNumber()
+  INSTR_READ_STATUS,        // SHT85_ReadStatus()
+  INSTR_CLEAR_ALERT_FLAGS,  // SHT85_ClearAllAlertFlags()
+  INSTR_SINGLE_MEAS,        // SHT85_SingleMeasurment(Raw)()
+  INSTR_START_ASYNC,        // SHT85_StartMeasurementAsync()
+  INSTR_PROCESS_ASYNC,      // SHT85_ProcessAsync(), readouts only
+  INSTR_WRITE_COMMAND,      // SHT85_WriteCommand()
+  INSTR_READ_RESULT,        // SHT85_ReadResultRaw()
+  INSTR_START_PERIODIC,     // SHT85_StartPeriodicMeasurment()
+  INSTR_STOP_PERIODIC,      // SHT85_StopPeriodicMeasurment()
+  INSTR_READ_BUFFER,        // SHT85_ReadMeasurementBuffer(Raw)()
+  INSTR_READ_BUFFERS,       // SHT85_ReadMeasurementBuffers()
+  INSTR_HEATER,             // SHT85_EnableHeater(), SHT85_DisableHeater()
+  INSTR_SOFT_RESET,         // SHT85_SoftReset()
+  INSTR_NBR_OF_OPS
+} etInstrOp;
+
+// Counters of one operation
+typedef struct {
+  uint32_t calls;        // calls
+  uint32_t bytesWritten; // bytes written incl. address bytes, a byte clocked
+                         // on several buses in lockstep counts once
+  uint32_t bytesRead;    // bytes read
+  uint32_t nacks;        // not acknowledged bytes, per bus in lockstep
+  uint32_t crcErrors;    // received frames with a checksum mismatch
+  uint32_t polls;        // reads of a measurement not ready yet
+  uint32_t cycles;       // duration of all calls [core cycles]
+  uint32_t maxCycles;    // duration of the longest call [core cycles]
+} tInstrStats;
+
+// Hooks of the driver
+#ifdef SHT85_INSTRUMENT
+  #define INSTR_BEGIN()         Instr_Begin()
+  #define INSTR_END(op)         Instr_End(op)
+  #define INSTR_COUNT(counter)  (Instr_Running.counter++)
+  #define INSTR_ADD(counter, n) (Instr_Running.counter += (n))
+#else
+  #define INSTR_BEGIN()         ((void)0)
+  #define INSTR_END(op)         ((void)0)
+  #define INSTR_COUNT(counter)  ((void)0)
+  #define INSTR_ADD(counter, n) ((void)0)
+#endif
+
+#ifdef SHT85_INSTRUMENT
+
+extern tInstrStats Instr_Running; // counters of the running call
+
+//==============================================================================
+// Clears the counters of all operations.
+//------------------------------------------------------------------------------
+void Instr_Reset(void);
+
+
+//==============================================================================
+// Gets the counters of an operation.
+//------------------------------------------------------------------------------
+// input: op            operation
+//
+// return: counters since the last Instr_Reset()
+//------------------------------------------------------------------------------
+const tInstrStats* Instr_GetStats(etInstrOp op);
+
+
+//==============================================================================
+// Starts counting a call, use INSTR_BEGIN().
+//------------------------------------------------------------------------------
+void Instr_Begin(void);
+
+
+//==============================================================================
+// Ends counting a call and adds its counters to the operation, use
+// INSTR_END().
+//------------------------------------------------------------------------------
+// input: op            operation
+//------------------------------------------------------------------------------
+void Instr_End(etInstrOp op);
+
+#endif
+
+#endif
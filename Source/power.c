@@ -0,0 +1,207 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  power.c
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  STM32F100RB
+// IDE       :  µVision V5.25.2.0
+// Compiler  :  Armcc
+// Brief     :  Power management for battery powered loggers.
+//==============================================================================
+
+#include "power.h"
+
+#define POWER_READ_RETRIES   3 // result read retries [ms] after conversion time
+#define POWER_FETCH_RETRIES 16 // fetch retries in periodic mode (one period)
+
+// Periodic measurement modes by period and repeatability
+static const struct {
+  uint16_t               periodMs; // measurement period [ms]
+  etPeriodicMeasureModes low;      // low repeatability
+  etPeriodicMeasureModes medium;   // medium repeatability
+  etPeriodicMeasureModes high;     // high repeatability
+} periodicModes[] = {
+  { 100, PERI_MEAS_LOW_10_HZ, PERI_MEAS_MEDIUM_10_HZ, PERI_MEAS_HIGH_10_HZ},
+  { 250, PERI_MEAS_LOW_4_HZ,  PERI_MEAS_MEDIUM_4_HZ,  PERI_MEAS_HIGH_4_HZ },
+  { 500, PERI_MEAS_LOW_2_HZ,  PERI_MEAS_MEDIUM_2_HZ,  PERI_MEAS_HIGH_2_HZ },
+  {1000, PERI_MEAS_LOW_1_HZ,  PERI_MEAS_MEDIUM_1_HZ,  PERI_MEAS_HIGH_1_HZ },
+  {2000, PERI_MEAS_LOW_05_HZ, PERI_MEAS_MEDIUM_05_HZ, PERI_MEAS_HIGH_05_HZ},
+};
+
+#define NBR_OF_PERIODIC_MODES (sizeof(periodicModes) / sizeof(periodicModes[0]))
+
+static bool GetPeriodicMode(uint32_t intervalMs,
+                            etSingleMeasureModes repeatability,
+                            etPeriodicMeasureModes* measureMode);
+static void Wait(tPowerLogger* logger, uint32_t ms);
+
+//------------------------------------------------------------------------------
+etError Power_LoggerStart(tPowerLogger* logger, tSht85* sensor,
+                          uint32_t intervalMs,
+                          etSingleMeasureModes repeatability,
+                          etPowerMode mode)
+{
+  etError                error = NO_ERROR; // error code
+  etPeriodicMeasureModes measureMode;      // periodic measurement mode
+  bool                   periodic;         // periodic mode possible
+  
+  periodic = GetPeriodicMode(intervalMs, repeatability, &measureMode);
+  
+  // single shot mode if the periodic mode is cheaper only by the estimate
+  if(mode == POWER_MODE_SINGLE) {
+    periodic = false;
+  } else if(mode == POWER_MODE_AUTO && periodic) {
+    periodic = Power_EstimateChargeNc(intervalMs, repeatability, true) <
+               Power_EstimateChargeNc(intervalMs, repeatability, false);
+  }
+  
+  logger->sensor        = sensor;
+  logger->intervalMs    = intervalMs;
+  logger->repeatability = repeatability;
+  logger->periodic      = periodic;
+  logger->nextMs        = System_GetTickMs();
+  logger->samples       = 0;
+  logger->wakeups       = 0;
+  logger->stopMs        = 0;
+  logger->sleepMs       = 0;
+  
+  if(periodic) {
+    error = SHT85_StartPeriodicMeasurment(sensor, measureMode);
+    SHT85_ScheduleInit(&logger->schedule, measureMode, System_GetTickMs());
+  }
+  
+  return error;
+}
+
+//------------------------------------------------------------------------------
+etError Power_LoggerStop(tPowerLogger* logger)
+{
+  etError error = NO_ERROR; // error code
+  
+  if(logger->periodic) {
+    error = SHT85_StopPeriodicMeasurment(logger->sensor);
+  }
+  
+  return error;
+}
+
+//------------------------------------------------------------------------------
+etError Power_LoggerSample(tPowerLogger* logger,
+                           uint16_t* rawValueTemp, uint16_t* rawValueHumi)
+{
+  etError  error;   // error code
+  uint8_t  retries; // remaining read retries
+  uint32_t nowMs;   // system time [ms]
+  
+  if(logger->periodic) {
+    // fetch when the sample is due, a fetch before the end of the conversion
+    // is not acknowledged and retried shortly after
+    retries = POWER_FETCH_RETRIES;
+    do {
+      Wait(logger, SHT85_ScheduleWaitMs(&logger->schedule,
+                                        System_GetTickMs()));
+      error = SHT85_ReadMeasurementBufferRaw(logger->sensor, rawValueTemp,
+                                             rawValueHumi);
+      SHT85_ScheduleUpdate(&logger->schedule, error, System_GetTickMs());
+    } while(error == ACK_ERROR && retries--);
+  } else {
+    // wait until the sample is due, restart the interval when behind
+    nowMs = System_GetTickMs();
+    if((int32_t)(logger->nextMs - nowMs) > 0) {
+      Wait(logger, logger->nextMs - nowMs);
+    } else {
+      logger->nextMs = nowMs;
+    }
+    logger->nextMs += logger->intervalMs;
+    
+    // start the measurement and sleep during the conversion
+    error = SHT85_WriteCommand(logger->sensor,
+                               (etCommands)logger->repeatability);
+    
+    if(error == NO_ERROR) {
+      Wait(logger, SHT85_GetMeasDurationMs(logger->repeatability));
+      
+      retries = POWER_READ_RETRIES;
+      while((error = SHT85_ReadResultRaw(logger->sensor, rawValueTemp,
+                                         rawValueHumi)) == ACK_ERROR &&
+            retries--) {
+        Wait(logger, 1);
+      }
+      
+      if(error == ACK_ERROR) {
+        error = TIMEOUT_ERROR;
+      }
+    }
+  }
+  
+  if(error == NO_ERROR) {
+    logger->samples++;
+  }
+  
+  return error;
+}
+
+//------------------------------------------------------------------------------
+uint32_t Power_EstimateChargeNc(uint32_t intervalMs,
+                                etSingleMeasureModes repeatability,
+                                bool periodic)
+{
+  uint64_t chargePc;                          // charge per sample [pC]
+  uint32_t wakeups = periodic ? 1 : 2;        // wake-ups per sample
+  uint32_t idleNa  = periodic ? POWER_SENSOR_PERIODIC_NA
+                              : POWER_SENSOR_IDLE_NA; // sensor idle current
+  
+  // controller: running per wake-up, in Stop mode otherwise
+  chargePc  = (uint64_t)POWER_RUN_NA * POWER_WAKE_US * wakeups / 1000;
+  chargePc += (uint64_t)POWER_STOP_NA * intervalMs;
+  
+  // sensor: measuring during the conversion, idle otherwise
+  chargePc += (uint64_t)POWER_SENSOR_MEASURE_NA *
+              SHT85_GetMeasDurationMs(repeatability);
+  chargePc += (uint64_t)idleNa * intervalMs;
+  
+  return (uint32_t)(chargePc / 1000);
+}
+
+//------------------------------------------------------------------------------
+static bool GetPeriodicMode(uint32_t intervalMs,
+                            etSingleMeasureModes repeatability,
+                            etPeriodicMeasureModes* measureMode)
+{
+  uint8_t i; // table index
+  
+  for(i = 0; i < NBR_OF_PERIODIC_MODES; i++) {
+    if(periodicModes[i].periodMs == intervalMs) {
+      switch(repeatability) {
+        case SINGLE_MEAS_LOW:    *measureMode = periodicModes[i].low;    break;
+        case SINGLE_MEAS_MEDIUM: *measureMode = periodicModes[i].medium; break;
+        default:                 *measureMode = periodicModes[i].high;   break;
+      }
+      return true;
+    }
+  }
+  
+  return false;
+}
+
+//------------------------------------------------------------------------------
+static void Wait(tPowerLogger* logger, uint32_t ms)
+{
+  uint32_t start; // start of a wait in Sleep mode [ms]
+  
+  if(ms >= POWER_STOP_MIN_MS) {
+    // Stop mode, woken by the RTC alarm
+    logger->stopMs += System_StopMs(ms);
+    logger->wakeups++;
+  } else if(ms > 0) {
+    // Sleep mode, woken by the SysTick every ms
+    start = System_GetTickMs();
+    while(System_GetTickMs() - start < ms) {
+      __WFI();
+      logger->wakeups++;
+    }
+    logger->sleepMs += ms;
+  }
+}
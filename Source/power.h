@@ -0,0 +1,130 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  power.h
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  STM32F100RB
+// IDE       :  µVision V5.25.2.0
+// Compiler  :  Armcc
+// Brief     :  Power management for battery powered loggers: samples the
+//              sensor at a fixed interval and keeps the controller in Stop
+//              mode in between, woken by the RTC when the next sample is due
+//              or the conversion is done. Short waits use the Sleep mode.
+//
+//              The measurement mode is chosen by an estimate of the charge
+//              per sample: the single shot mode wakes the controller twice
+//              per sample (start, read), the periodic mode once, but the
+//              sensor draws more current between the measurements.
+//==============================================================================
+
+#ifndef POWER_H
+#define POWER_H
+
+#include "sht85.h"
+#include "sht85_schedule.h"
+#include "system.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// Typical supply currents for the charge estimate [nA]
+/* -- adapt this to your hardware -- */
+#define POWER_RUN_NA               4400000 // controller running, HSI 8MHz
+#define POWER_SLEEP_NA             2000000 // controller in Sleep mode
+#define POWER_STOP_NA                14000 // controller in Stop mode, RTC on
+#define POWER_SENSOR_MEASURE_NA     600000 // SHT85 measuring
+#define POWER_SENSOR_IDLE_NA           200 // SHT85 idle, single shot mode
+#define POWER_SENSOR_PERIODIC_NA     45000 // SHT85 idle, periodic mode
+#define POWER_SUPPLY_MV               3300 // supply voltage [mV]
+
+// Controller run time per wake-up: wake-up, transfer and alarm setup [us]
+#define POWER_WAKE_US                  500
+
+// Waits shorter than this use the Sleep mode instead of the Stop mode [ms]
+#define POWER_STOP_MIN_MS                2
+
+// Measurement mode selection
+typedef enum {
+  POWER_MODE_AUTO,     // mode with the lower estimated charge per sample
+  POWER_MODE_SINGLE,   // one single shot measurement per sample
+  POWER_MODE_PERIODIC, // periodic measurement, if the interval is a rate of it
+} etPowerMode;
+
+// Low power logger of one sensor
+typedef struct {
+  tSht85*              sensor;        // sampled sensor
+  uint32_t             intervalMs;    // sample interval [ms]
+  etSingleMeasureModes repeatability; // measurement repeatability
+  bool                 periodic;      // periodic mode chosen
+  tSht85Schedule       schedule;      // fetch schedule in periodic mode
+  uint32_t             nextMs;        // next single shot measurement [ms]
+  // statistics
+  uint32_t             samples;       // successful samples
+  uint32_t             wakeups;       // wake-ups from Stop or Sleep mode
+  uint32_t             stopMs;        // time in Stop mode [ms]
+  uint32_t             sleepMs;       // time in Sleep mode [ms]
+} tPowerLogger;
+
+//==============================================================================
+// Selects the measurement mode and starts the logger. System_InitStop() has to
+// be called before.
+//------------------------------------------------------------------------------
+// input: logger        logger instance
+//        sensor        sensor instance
+//        intervalMs    sample interval [ms], the periodic mode is possible for
+//                      100, 250, 500, 1000 and 2000ms
+//        repeatability repeatability for the measurement [low, medium, high]
+//        mode          measurement mode or POWER_MODE_AUTO
+//
+// return: error:       ACK_ERROR      = no acknowledgment from sensor
+//                      NO_ERROR       = no error
+//------------------------------------------------------------------------------
+etError Power_LoggerStart(tPowerLogger* logger, tSht85* sensor,
+                          uint32_t intervalMs,
+                          etSingleMeasureModes repeatability,
+                          etPowerMode mode);
+
+
+//==============================================================================
+// Stops the logger, a periodic measurement is stopped.
+//------------------------------------------------------------------------------
+// input: logger        logger instance
+//
+// return: error:       ACK_ERROR      = no acknowledgment from sensor
+//                      NO_ERROR       = no error
+//------------------------------------------------------------------------------
+etError Power_LoggerStop(tPowerLogger* logger);
+
+
+//==============================================================================
+// Waits in Stop mode until the next sample is due and reads it.
+//------------------------------------------------------------------------------
+// input: logger        logger instance
+//        rawValueTemp  pointer to raw temperature value
+//        rawValueHumi  pointer to raw humidity value
+//
+// return: error:       ACK_ERROR      = no acknowledgment from sensor
+//                      CHECKSUM_ERROR = checksum mismatch
+//                      TIMEOUT_ERROR  = measurement not ready in time
+//                      NO_ERROR       = no error
+//------------------------------------------------------------------------------
+etError Power_LoggerSample(tPowerLogger* logger,
+                           uint16_t* rawValueTemp, uint16_t* rawValueHumi);
+
+
+//==============================================================================
+// Estimates the charge per sample of controller and sensor from the typical
+// currents above.
+//------------------------------------------------------------------------------
+// input: intervalMs    sample interval [ms]
+//        repeatability repeatability for the measurement [low, medium, high]
+//        periodic      periodic mode instead of single shot mode
+//
+// return: charge per sample [nC]
+//------------------------------------------------------------------------------
+uint32_t Power_EstimateChargeNc(uint32_t intervalMs,
+                                etSingleMeasureModes repeatability,
+                                bool periodic);
+
+#endif
@@ -1,418 +1,791 @@
-//==============================================================================
-// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
-//==============================================================================
-// Project   :  SHT85 Sample Code
-// File      :  sht85.c
-// Author    :  RFU
-// Date      :  17-Mai-2018
-// Controller:  STM32F100RB
-// IDE       :  Vision V5.25.2.0
-// Compiler  :  Armcc
-// Brief     :  Sensor Layer: Implementation of functions for sensor access.
-//==============================================================================
-
-#include "sht85.h"
-#include "i2c_hal.h"
-#include "system.h"
-
-#define CRC_POLYNOMIAL  0x131 // P(x) = x^8 + x^5 + x^4 + 1 = 100110001
-#define I2C_ADDR        0x44
-
-static etError StartWriteAccess(void);
-static etError StartReadAccess(void);
-static void StopAccess(void);
-static etError WriteCommand(etCommands command);
-static etError Read2BytesAndCrc(uint16_t* data, bool finAck, uint8_t timeout);
-static uint8_t CalcCrc(uint8_t data[], uint8_t nbrOfBytes);
-static etError CheckCrc(uint8_t data[], uint8_t nbrOfBytes, uint8_t checksum);
-static float CalcTemperature(uint16_t rawValue);
-static float CalcHumidity(uint16_t rawValue);
-
-//------------------------------------------------------------------------------
-void SHT85_Init(void)
-{
-  I2c_Init(); // init I2C
-}
-
-//------------------------------------------------------------------------------
-etError SHT85_ReadSerialNumber(uint32_t* serialNumber)
-{
-  etError error; // error code
-  uint16_t serialNumWords[2];
-  
-  error = StartWriteAccess();
-  
-  // write "read serial number" command
-  if(error == NO_ERROR) {
-    error = WriteCommand(CMD_READ_SERIALNBR);
-  }
-  
-  // if no error, start read access
-  if(error == NO_ERROR) {
-    error = StartReadAccess();
-  }
-  
-  // if no error, read first serial number word
-  if(error == NO_ERROR) {
-    error = Read2BytesAndCrc(&serialNumWords[0], true, 100);
-  }
-  
-  // if no error, read second serial number word
-  if(error == NO_ERROR) {
-    error = Read2BytesAndCrc(&serialNumWords[1], false, 0);
-  }
-  
-  StopAccess();
-  
-  // if no error, calc serial number as 32-bit integer
-  if(error == NO_ERROR) {
-    *serialNumber = (serialNumWords[0] << 16) | serialNumWords[1];
-  }
-  
-  return error;
-}
-
-//------------------------------------------------------------------------------
-etError SHT85_ReadStatus(uint16_t* status)
-{
-  etError error; // error code
-
-  error = StartWriteAccess();
-  
-  // if no error, write "read status" command
-  if(error == NO_ERROR) {
-    error = WriteCommand(CMD_READ_STATUS);
-  }
-  
-  // if no error, start read access
-  if(error == NO_ERROR) {
-    error = StartReadAccess();
-  }
-  
-  // if no error, read status
-  if(error == NO_ERROR) {
-    error = Read2BytesAndCrc(status, false, 0);
-  }
-  
-  StopAccess();
-  
-  return error;
-}
-
-//------------------------------------------------------------------------------
-etError SHT85_ClearAllAlertFlags(void)
-{
-  etError error; // error code
-  
-  error = StartWriteAccess();
-  
-  // if no error, write clear status register command
-  if(error == NO_ERROR) {
-    error = WriteCommand(CMD_CLEAR_STATUS);
-  }
-  
-  StopAccess();
-  
-  return error;
-}
-
-//------------------------------------------------------------------------------
-etError SHT85_SingleMeasurment(float* temperature, float* humidity,
-                               etSingleMeasureModes measureMode,
-                               uint8_t timeout)
-{
-  etError  error;           // error code
-  uint16_t rawValueTemp;    // temperature raw value from sensor
-  uint16_t rawValueHumi;    // humidity raw value from sensor
-  
-  error  = StartWriteAccess();
-  
-  // if no error
-  if(error == NO_ERROR) {
-    // start measurement
-    error = WriteCommand((etCommands)measureMode);
-  }
-  
-  // if no error, wait until measurement ready
-  if(error == NO_ERROR) {
-    // poll every 1ms for measurement ready until timeout
-    while(timeout--) {
-      // check if the measurement has finished
-      error = StartReadAccess();
-      
-      // if measurement has finished -> exit loop
-      if(error == NO_ERROR) break;
-      
-      // delay 1ms
-      System_DelayUs(1000);
-    }
-    
-    // check for timeout error
-    if(timeout == 0) {
-      error = TIMEOUT_ERROR;
-    }
-  }
-  
-  // if no error, read temperature and humidity raw values
-  if(error == NO_ERROR) {
-    error |= Read2BytesAndCrc(&rawValueTemp, true, 0);
-    error |= Read2BytesAndCrc(&rawValueHumi, false, 0);
-  }
-  
-  StopAccess();
-  
-  // if no error, calculate temperature in C and humidity in %RH
-  if(error == NO_ERROR) {
-    *temperature = CalcTemperature(rawValueTemp);
-    *humidity = CalcHumidity(rawValueHumi);
-  }
-  
-  return error;
-}
-
-//------------------------------------------------------------------------------
-etError SHT85_StartPeriodicMeasurment(etPeriodicMeasureModes measureMode)
-{
-  etError error; // error code
-  
-  error = StartWriteAccess();
-  
-  // if no error, start periodic measurement 
-  if(error == NO_ERROR) {
-    error = WriteCommand((etCommands)measureMode);
-  }
-  
-  StopAccess();
-  
-  return error;
-}
-
-
-//------------------------------------------------------------------------------
-etError SHT85_StopPeriodicMeasurment(void)
-{
-  etError error; // error code
-  
-  error = StartWriteAccess();
-  
-  // if no error, write breake command
-  if(error == NO_ERROR) {
-    error = WriteCommand(CMD_BREAK);
-  }
-  
-  StopAccess();
-  
-  return error;
-}
-
-
-//------------------------------------------------------------------------------
-etError SHT85_ReadMeasurementBuffer(float* temperature, float* humidity)
-{
-  etError  error;        // error code
-  uint16_t rawValueTemp; // raw temperature from sensor
-  uint16_t rawValueHumi; // raw humidity from sensor
-  
-  error = StartWriteAccess();
-  
-  // if no error, read measurements
-  if(error == NO_ERROR) {
-    error = WriteCommand(CMD_FETCH_DATA);
-  }
-  
-  if(error == NO_ERROR) {
-    error = StartReadAccess();  
-  }
-  
-  if(error == NO_ERROR) {
-    error = Read2BytesAndCrc(&rawValueTemp, true, 0);
-  }
-  
-  if(error == NO_ERROR) {
-    error = Read2BytesAndCrc(&rawValueHumi, false, 0);
-  }
-  
-  // if no error, calculate temperature in C and humidity in %RH
-  if(error == NO_ERROR) {
-    *temperature = CalcTemperature(rawValueTemp);
-    *humidity = CalcHumidity(rawValueHumi);
-  }
-  
-  StopAccess();
-  
-  return error;
-}
-
-//------------------------------------------------------------------------------
-etError SHT85_EnableHeater(void)
-{
-  etError error; // error code
-  
-  error = StartWriteAccess();
-  
-  // if no error, write heater enable command
-  if(error == NO_ERROR) {
-    error = WriteCommand(CMD_HEATER_ENABLE);
-  }
-  
-  StopAccess();
-  
-  return error;
-}
-
-//------------------------------------------------------------------------------
-etError SHT85_DisableHeater(void)
-{
-  etError error; // error code
-  
-  error = StartWriteAccess();
-  
-  // if no error, write heater disable command
-  if(error == NO_ERROR) {
-    error = WriteCommand(CMD_HEATER_DISABLE);
-  }
-  
-  StopAccess();
-  
-  return error;
-}
-
-//------------------------------------------------------------------------------
-etError SHT85_SoftReset(void)
-{
-  etError error; // error code
-  
-  error = StartWriteAccess();
-  
-  // write reset command
-  if(error == NO_ERROR) {
-    error  = WriteCommand(CMD_SOFT_RESET);
-  }
-  
-  StopAccess();
-  
-  // if no error, wait 50 ms after reset
-  if(error == NO_ERROR) {
-    System_DelayUs(50000);
-  }
-  
-  return error;
-}
-
-//------------------------------------------------------------------------------
-static etError StartWriteAccess(void)
-{
-  etError error; // error code
-  
-  // write a start condition
-  I2c_StartCondition();
-  
-  // write the sensor I2C address with the write flag
-  error = I2c_WriteByte(I2C_ADDR << 1);
-  
-  return error;
-}
-
-//------------------------------------------------------------------------------
-static etError StartReadAccess(void)
-{
-  etError error; // error code
-  
-  // write a start condition
-  I2c_StartCondition();
-  
-  // write the sensor I2C address with the read flag
-  error = I2c_WriteByte(I2C_ADDR << 1 | 0x01);
-  
-  return error;
-}
-
-//------------------------------------------------------------------------------
-static void StopAccess(void)
-{
-  // write a stop condition
-  I2c_StopCondition();
-}
-
-//------------------------------------------------------------------------------
-static etError WriteCommand(etCommands command)
-{
-  etError error; // error code
-  
-  // write the upper 8 bits of the command to the sensor
-  error = I2c_WriteByte(command >> 8);
-  
-  // write the lower 8 bits of the command to the sensor
-  error |= I2c_WriteByte(command & 0xFF);
-  
-  return error;
-}
-
-//------------------------------------------------------------------------------
-static etError Read2BytesAndCrc(uint16_t* data, bool finAck, uint8_t timeout)
-{
-  etError error;    // error code
-  uint8_t bytes[2]; // read data array
-  uint8_t checksum; // checksum byte
-  
-  // read two data bytes and one checksum byte
-  bytes[0] = I2c_ReadByte(ACK);
-  bytes[1] = I2c_ReadByte(ACK);
-  checksum = I2c_ReadByte(finAck ? ACK : NO_ACK);
-
-  // verify checksum
-  error = CheckCrc(bytes, 2, checksum);
-  
-  // combine the two bytes to a 16-bit value
-  *data = (bytes[0] << 8) | bytes[1];
-  
-  return error;
-}
-
-//------------------------------------------------------------------------------
-static uint8_t CalcCrc(uint8_t data[], uint8_t nbrOfBytes)
-{
-  uint8_t bit;        // bit mask
-  uint8_t crc = 0xFF; // calculated checksum
-  uint8_t byteCtr;    // byte counter
-  
-  // calculates 8-Bit checksum with given polynomial
-  for(byteCtr = 0; byteCtr < nbrOfBytes; byteCtr++) {
-    crc ^= (data[byteCtr]);
-    for(bit = 8; bit > 0; --bit) {
-      if(crc & 0x80) {
-        crc = (crc << 1) ^ CRC_POLYNOMIAL;
-      } else {
-        crc = (crc << 1);
-      }
-    }
-  }
-  
-  return crc;
-}
-
-//------------------------------------------------------------------------------
-static etError CheckCrc(uint8_t data[], uint8_t nbrOfBytes, uint8_t checksum)
-{
-  // calculates 8-Bit checksum
-  uint8_t crc = CalcCrc(data, nbrOfBytes);
-  
-  // verify checksum
-  return (crc != checksum) ? CHECKSUM_ERROR : NO_ERROR;
-}
-
-//------------------------------------------------------------------------------
-static float CalcTemperature(uint16_t rawValue)
-{
-  // calculate temperature [C]
-  // T = -45 + 175 * rawValue / (2^16-1)
-  return 175.0f * (float)rawValue / 65535.0f - 45.0f;
-}
-
-//------------------------------------------------------------------------------
-static float CalcHumidity(uint16_t rawValue)
-{
-  // calculate relative humidity [%RH]
-  // RH = rawValue / (2^16-1) * 100
-  return 100.0f * (float)rawValue / 65535.0f;
-}
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  sht85.c
+// Author    :  RFU
+// Date      :  17-Mai-2018
+// Controller:  STM32F100RB
+// IDE       :  µVision V5.25.2.0
+// Compiler  :  Armcc
+// Brief     :  Sensor Layer: Implementation of functions for sensor access.
+//==============================================================================
+
+#include "sht85.h"
+#include "i2c_hal.h"
+#include "i2c_group.h"
+#include "system.h"
+#include "instrument.h"
+
+#define CRC_POLYNOMIAL  0x131 // P(x) = x^8 + x^5 + x^4 + 1 = 100110001
+
+// CRC calculation method, may be overridden in the project settings:
+//     0 = bit by bit, no table
+//    16 = nibble table, 16 bytes flash, 2 table lookups per byte
+//   256 = byte table, 256 bytes flash, 1 table lookup per byte
+#ifndef CRC_TABLE_SIZE
+  #define CRC_TABLE_SIZE  256
+#endif
+
+// max. measurement duration [ms] incl. one tick for SysTick granularity
+#define MEAS_DURATION_HIGH_MS    16 // high repeatability:   15.0ms
+#define MEAS_DURATION_MEDIUM_MS   7 // medium repeatability:  6.0ms
+#define MEAS_DURATION_LOW_MS      5 // low repeatability:     4.0ms
+#define MEAS_ASYNC_RETRIES        3 // read retries [ms] after conversion time
+
+static etError WriteCommand(tSht85* sensor, etCommands command);
+static etError ReadCommand(tSht85* sensor, etCommands command,
+                           uint16_t data[], uint8_t nbrOfWords);
+static etError ReadResult(tSht85* sensor, uint16_t data[], uint8_t nbrOfWords);
+static etError DecodeFrame(uint8_t frame[], uint16_t data[],
+                           uint8_t nbrOfWords);
+static etError CheckFrameCrc(uint8_t frame[], uint8_t nbrOfWords);
+static float CalcTemperature(uint16_t rawValue);
+static float CalcHumidity(uint16_t rawValue);
+static void ReadMeasurementBuffersLockstep(tSht85* sensors[],
+                                           uint8_t sensorIdx[],
+                                           uint8_t nbrOfSensors,
+                                           float temperature[],
+                                           float humidity[], etError error[]);
+
+//------------------------------------------------------------------------------
+void SHT85_Init(tSht85* sensor, const tI2cBus* bus, uint8_t address)
+{
+  sensor->bus       = bus;
+  sensor->address   = address;
+  sensor->asyncBusy = false;
+  
+  I2c_InitBus(bus); // init I2C
+}
+
+//------------------------------------------------------------------------------
+etError SHT85_ReadSerialNumber(tSht85* sensor, uint32_t* serialNumber)
+{
+  etError  error;             // error code
+  uint16_t serialNumWords[2]; // serial number words
+  
+  INSTR_BEGIN();
+  
+  // write "read serial number" command and read both serial number words
+  error = ReadCommand(sensor, CMD_READ_SERIALNBR, serialNumWords, 2);
+  
+  // if no error, calc serial number as 32-bit integer
+  if(error == NO_ERROR) {
+    *serialNumber = ((uint32_t)serialNumWords[0] << 16) | serialNumWords[1];
+  }
+  
+  INSTR_END(INSTR_READ_SERIAL_NUMBER);
+  return error;
+}
+
+//------------------------------------------------------------------------------
+etError SHT85_ReadStatus(tSht85* sensor, uint16_t* status)
+{
+  etError error; // error code
+  
+  INSTR_BEGIN();
+  
+  // write "read status" command and read status
+  error = ReadCommand(sensor, CMD_READ_STATUS, status, 1);
+  
+  INSTR_END(INSTR_READ_STATUS);
+  return error;
+}
+
+//------------------------------------------------------------------------------
+void SHT85_DecodeStatus(uint16_t status, tSht85Status* decoded)
+{
+  decoded->alertPending     = (status & SHT85_STATUS_ALERT_PENDING) != 0;
+  decoded->heaterOn         = (status & SHT85_STATUS_HEATER) != 0;
+  decoded->humidityAlert    = (status & SHT85_STATUS_RH_ALERT) != 0;
+  decoded->temperatureAlert = (status & SHT85_STATUS_T_ALERT) != 0;
+  decoded->resetDetected    = (status & SHT85_STATUS_RESET) != 0;
+  decoded->commandFailed    = (status & SHT85_STATUS_COMMAND) != 0;
+  decoded->writeCrcFailed   = (status & SHT85_STATUS_WRITE_CRC) != 0;
+}
+
+//------------------------------------------------------------------------------
+etError SHT85_ClearAllAlertFlags(tSht85* sensor)
+{
+  etError error; // error code
+  
+  INSTR_BEGIN();
+  
+  // write clear status register command
+  error = WriteCommand(sensor, CMD_CLEAR_STATUS);
+  
+  INSTR_END(INSTR_CLEAR_ALERT_FLAGS);
+  return error;
+}
+
+//------------------------------------------------------------------------------
+etError SHT85_SingleMeasurment(tSht85* sensor,
+                               float* temperature, float* humidity,
+                               etSingleMeasureModes measureMode,
+                               uint8_t timeout)
+{
+  etError  error;        // error code
+  uint16_t rawValueTemp; // temperature raw value from sensor
+  uint16_t rawValueHumi; // humidity raw value from sensor
+  
+  INSTR_BEGIN();
+  
+  error = SHT85_SingleMeasurmentRaw(sensor, &rawValueTemp, &rawValueHumi,
+                                    measureMode, timeout);
+  
+  // if no error, calculate temperature in °C and humidity in %RH
+  if(error == NO_ERROR) {
+    *temperature = CalcTemperature(rawValueTemp);
+    *humidity = CalcHumidity(rawValueHumi);
+  }
+  
+  INSTR_END(INSTR_SINGLE_MEAS);
+  return error;
+}
+
+//------------------------------------------------------------------------------
+etError SHT85_SingleMeasurmentRaw(tSht85* sensor,
+                                  uint16_t* rawValueTemp,
+                                  uint16_t* rawValueHumi,
+                                  etSingleMeasureModes measureMode,
+                                  uint8_t timeout)
+{
+  etError  error;           // error code
+  uint16_t rawValues[2];    // temperature and humidity raw values from sensor
+  
+  INSTR_BEGIN();
+  
+  // start measurement
+  error = WriteCommand(sensor, (etCommands)measureMode);
+  
+  // if no error, wait until measurement ready
+  if(error == NO_ERROR) {
+    // poll every 1ms for measurement ready until timeout, the sensor does not
+    // acknowledge the read header while it is measuring
+    error = ACK_ERROR;
+    while(error == ACK_ERROR && timeout--) {
+      // read temperature and humidity raw values if the measurement has
+      // finished
+      error = ReadResult(sensor, rawValues, 2);
+      
+      // delay 1ms
+      if(error == ACK_ERROR) {
+        INSTR_COUNT(polls);
+        System_DelayUs(1000);
+      }
+    }
+    
+    // check for timeout error
+    if(error == ACK_ERROR) {
+      error = TIMEOUT_ERROR;
+    }
+  }
+  
+  // if no error, pass the raw values
+  if(error == NO_ERROR) {
+    *rawValueTemp = rawValues[0];
+    *rawValueHumi = rawValues[1];
+  }
+  
+  INSTR_END(INSTR_SINGLE_MEAS);
+  return error;
+}
+
+//------------------------------------------------------------------------------
+etError SHT85_StartMeasurementAsync(tSht85* sensor,
+                                    etSingleMeasureModes measureMode,
+                                    tSht85MeasureCallback callback)
+{
+  etError error; // error code
+  
+  if(sensor->asyncBusy) return BUSY_ERROR;
+  
+  INSTR_BEGIN();
+  
+  // start measurement
+  error = WriteCommand(sensor, (etCommands)measureMode);
+  
+  // if no error, schedule the readout after the measurement duration
+  if(error == NO_ERROR) {
+    sensor->asyncDeadline = System_GetTickMs() +
+                            SHT85_GetMeasDurationMs(measureMode);
+    sensor->asyncRetries  = MEAS_ASYNC_RETRIES;
+    sensor->asyncCallback = callback;
+    sensor->asyncBusy     = true;
+  }
+  
+  INSTR_END(INSTR_START_ASYNC);
+  return error;
+}
+
+//------------------------------------------------------------------------------
+bool SHT85_ProcessAsync(tSht85* sensor)
+{
+  etError  error;        // error code
+  uint16_t rawValues[2]; // temperature and humidity raw values from sensor
+  
+  if(!sensor->asyncBusy) return false;
+  
+  // wait until the measurement duration has elapsed
+  if((int32_t)(System_GetTickMs() - sensor->asyncDeadline) < 0) return true;
+  
+  // read temperature and humidity raw values
+  INSTR_BEGIN();
+  error = ReadResult(sensor, rawValues, 2);
+  if(error == ACK_ERROR) {
+    INSTR_COUNT(polls);
+  }
+  INSTR_END(INSTR_PROCESS_ASYNC);
+  
+  // measurement not ready yet (NACK) -> retry with the next tick
+  if(error == ACK_ERROR && sensor->asyncRetries > 0) {
+    sensor->asyncRetries--;
+    sensor->asyncDeadline++;
+    return true;
+  }
+  
+  if(error == ACK_ERROR) {
+    error = TIMEOUT_ERROR;
+  }
+  
+  sensor->asyncBusy = false;
+  
+  // report the result
+  if(sensor->asyncCallback) {
+    if(error == NO_ERROR) {
+      sensor->asyncCallback(sensor, error, CalcTemperature(rawValues[0]),
+                            CalcHumidity(rawValues[1]));
+    } else {
+      sensor->asyncCallback(sensor, error, 0.0f, 0.0f);
+    }
+  }
+  
+  return false;
+}
+
+//------------------------------------------------------------------------------
+etError SHT85_WriteCommand(tSht85* sensor, etCommands command)
+{
+  etError error; // error code
+  
+  INSTR_BEGIN();
+  
+  error = WriteCommand(sensor, command);
+  
+  INSTR_END(INSTR_WRITE_COMMAND);
+  return error;
+}
+
+//------------------------------------------------------------------------------
+etError SHT85_ReadResultRaw(tSht85* sensor,
+                            uint16_t* rawValueTemp, uint16_t* rawValueHumi)
+{
+  etError  error;        // error code
+  uint16_t rawValues[2]; // temperature and humidity raw values from sensor
+  
+  INSTR_BEGIN();
+  
+  // read temperature and humidity raw values
+  error = ReadResult(sensor, rawValues, 2);
+  
+  // if no error, pass the raw values
+  if(error == NO_ERROR) {
+    *rawValueTemp = rawValues[0];
+    *rawValueHumi = rawValues[1];
+  }
+  
+  INSTR_END(INSTR_READ_RESULT);
+  return error;
+}
+
+//------------------------------------------------------------------------------
+etError SHT85_StartPeriodicMeasurment(tSht85* sensor,
+                                      etPeriodicMeasureModes measureMode)
+{
+  etError error; // error code
+  
+  INSTR_BEGIN();
+  
+  // start periodic measurement
+  error = WriteCommand(sensor, (etCommands)measureMode);
+  
+  INSTR_END(INSTR_START_PERIODIC);
+  return error;
+}
+
+
+//------------------------------------------------------------------------------
+etError SHT85_StopPeriodicMeasurment(tSht85* sensor)
+{
+  etError error; // error code
+  
+  INSTR_BEGIN();
+  
+  // write break command
+  error = WriteCommand(sensor, CMD_BREAK);
+  
+  INSTR_END(INSTR_STOP_PERIODIC);
+  return error;
+}
+
+
+//------------------------------------------------------------------------------
+uint16_t SHT85_GetPeriodMs(etPeriodicMeasureModes measureMode)
+{
+  uint16_t periodMs; // measurement period [ms]
+  
+  // the MSB of the command encodes the measurement rate
+  switch(measureMode >> 8) {
+    case 0x20: periodMs = 2000; break; // 0.5 mps
+    case 0x21: periodMs = 1000; break; // 1 mps
+    case 0x22: periodMs =  500; break; // 2 mps
+    case 0x23: periodMs =  250; break; // 4 mps
+    case 0x27: periodMs =  100; break; // 10 mps
+    default:   periodMs =    0; break;
+  }
+  
+  return periodMs;
+}
+
+
+//------------------------------------------------------------------------------
+uint8_t SHT85_GetMeasDurationMs(etSingleMeasureModes measureMode)
+{
+  switch(measureMode) {
+    case SINGLE_MEAS_LOW:    return MEAS_DURATION_LOW_MS;
+    case SINGLE_MEAS_MEDIUM: return MEAS_DURATION_MEDIUM_MS;
+    default:                 return MEAS_DURATION_HIGH_MS;
+  }
+}
+
+//------------------------------------------------------------------------------
+etError SHT85_ReadMeasurementBuffer(tSht85* sensor,
+                                    float* temperature, float* humidity)
+{
+  etError  error;        // error code
+  uint16_t rawValueTemp; // raw temperature from sensor
+  uint16_t rawValueHumi; // raw humidity from sensor
+  
+  INSTR_BEGIN();
+  
+  error = SHT85_ReadMeasurementBufferRaw(sensor, &rawValueTemp, &rawValueHumi);
+  
+  // if no error, calculate temperature in °C and humidity in %RH
+  if(error == NO_ERROR) {
+    *temperature = CalcTemperature(rawValueTemp);
+    *humidity = CalcHumidity(rawValueHumi);
+  }
+  
+  INSTR_END(INSTR_READ_BUFFER);
+  return error;
+}
+
+//------------------------------------------------------------------------------
+etError SHT85_ReadMeasurementBufferRaw(tSht85* sensor,
+                                       uint16_t* rawValueTemp,
+                                       uint16_t* rawValueHumi)
+{
+  etError  error;        // error code
+  uint16_t rawValues[2]; // raw temperature and humidity from sensor
+  
+  INSTR_BEGIN();
+  
+  // write fetch command and read measurements
+  error = ReadCommand(sensor, CMD_FETCH_DATA, rawValues, 2);
+  
+  // if no error, pass the raw values
+  if(error == NO_ERROR) {
+    *rawValueTemp = rawValues[0];
+    *rawValueHumi = rawValues[1];
+  }
+  
+  INSTR_END(INSTR_READ_BUFFER);
+  return error;
+}
+
+//------------------------------------------------------------------------------
+void SHT85_ReadMeasurementBuffers(tSht85* sensors[], uint8_t nbrOfSensors,
+                                  float temperature[], float humidity[],
+                                  etError error[])
+{
+  uint8_t done[SHT85_MAX_SENSORS];      // sensor already read
+  uint8_t groupIdx[SHT85_MAX_SENSORS];  // sensors of the current group
+  uint8_t groupSize;                    // number of sensors in the group
+  uint8_t first;                        // first sensor of the group
+  uint8_t i;                            // sensor index
+  
+  // the sensors beyond the limit are reported, not read
+  for(i = SHT85_MAX_SENSORS; i < nbrOfSensors; i++) {
+    error[i] = PARM_ERROR;
+  }
+  if(nbrOfSensors > SHT85_MAX_SENSORS) {
+    nbrOfSensors = SHT85_MAX_SENSORS;
+  }
+  
+  INSTR_BEGIN();
+  
+  for(i = 0; i < nbrOfSensors; i++) {
+    done[i] = false;
+  }
+  
+  for(first = 0; first < nbrOfSensors; first++) {
+    if(done[first]) continue;
+    
+    // collect all sensors with the same address on other buses of the port
+    groupIdx[0] = first;
+    groupSize   = 1;
+    done[first] = true;
+    for(i = first + 1; i < nbrOfSensors; i++) {
+      if(!done[i] &&
+         sensors[i]->address   == sensors[first]->address &&
+         sensors[i]->bus->port == sensors[first]->bus->port) {
+        groupIdx[groupSize++] = i;
+        done[i] = true;
+      }
+    }
+    
+    if(groupSize == 1) {
+      error[first] = SHT85_ReadMeasurementBuffer(sensors[first],
+                                                 &temperature[first],
+                                                 &humidity[first]);
+    } else {
+      ReadMeasurementBuffersLockstep(sensors, groupIdx, groupSize,
+                                     temperature, humidity, error);
+    }
+  }
+  
+  INSTR_END(INSTR_READ_BUFFERS);
+}
+
+//------------------------------------------------------------------------------
+etError SHT85_EnableHeater(tSht85* sensor)
+{
+  etError error; // error code
+  
+  INSTR_BEGIN();
+  
+  // write heater enable command
+  error = WriteCommand(sensor, CMD_HEATER_ENABLE);
+  
+  INSTR_END(INSTR_HEATER);
+  return error;
+}
+
+//------------------------------------------------------------------------------
+etError SHT85_DisableHeater(tSht85* sensor)
+{
+  etError error; // error code
+  
+  INSTR_BEGIN();
+  
+  // write heater disable command
+  error = WriteCommand(sensor, CMD_HEATER_DISABLE);
+  
+  INSTR_END(INSTR_HEATER);
+  return error;
+}
+
+//------------------------------------------------------------------------------
+etError SHT85_SoftReset(tSht85* sensor)
+{
+  etError error; // error code
+  
+  INSTR_BEGIN();
+  
+  // write reset command
+  error = WriteCommand(sensor, CMD_SOFT_RESET);
+  
+  // if no error, wait 50 ms after reset
+  if(error == NO_ERROR) {
+    System_DelayUs(SHT85_SOFT_RESET_MS * 1000);
+  }
+  
+  INSTR_END(INSTR_SOFT_RESET);
+  return error;
+}
+
+//------------------------------------------------------------------------------
+static etError WriteCommand(tSht85* sensor, etCommands command)
+{
+  uint8_t txBytes[2]; // command, MSB first
+  
+  txBytes[0] = command >> 8;
+  txBytes[1] = command & 0xFF;
+  
+  I2c_SelectBus(sensor->bus);
+  return I2c_Transfer(sensor->address, txBytes, 2, 0, 0, 0);
+}
+
+//------------------------------------------------------------------------------
+static etError ReadCommand(tSht85* sensor, etCommands command,
+                           uint16_t data[], uint8_t nbrOfWords)
+{
+  etError error;      // error code
+  uint8_t txBytes[2]; // command, MSB first
+  uint8_t frame[6];   // up to two times two data bytes and one checksum byte
+  
+  txBytes[0] = command >> 8;
+  txBytes[1] = command & 0xFF;
+  
+  // command and read with a repeated start condition in between
+  I2c_SelectBus(sensor->bus);
+  error = I2c_Transfer(sensor->address, txBytes, 2, frame, nbrOfWords * 3, 0);
+  
+  if(error == NO_ERROR) {
+    error = DecodeFrame(frame, data, nbrOfWords);
+  }
+  
+  return error;
+}
+
+//------------------------------------------------------------------------------
+static etError ReadResult(tSht85* sensor, uint16_t data[], uint8_t nbrOfWords)
+{
+  etError error;    // error code
+  uint8_t frame[6]; // up to two times two data bytes and one checksum byte
+  
+  // read header only, the command was sent before
+  I2c_SelectBus(sensor->bus);
+  error = I2c_Transfer(sensor->address, 0, 0, frame, nbrOfWords * 3, 0);
+  
+  if(error == NO_ERROR) {
+    error = DecodeFrame(frame, data, nbrOfWords);
+  }
+  
+  return error;
+}
+
+//------------------------------------------------------------------------------
+static etError DecodeFrame(uint8_t frame[], uint16_t data[],
+                           uint8_t nbrOfWords)
+{
+  uint8_t wordCtr; // word counter
+  
+  // combine the bytes to 16-bit values
+  for(wordCtr = 0; wordCtr < nbrOfWords; wordCtr++) {
+    data[wordCtr] = (frame[3 * wordCtr] << 8) | frame[3 * wordCtr + 1];
+  }
+  
+  // verify all checksums
+  return CheckFrameCrc(frame, nbrOfWords);
+}
+
+#if CRC_TABLE_SIZE == 256
+//------------------------------------------------------------------------------
+// CRC of every byte value: crcTable[i] = CRC(i) with initial value 0
+static const uint8_t crcTable[256] = {
+  0x00, 0x31, 0x62, 0x53, 0xC4, 0xF5, 0xA6, 0x97,
+  0xB9, 0x88, 0xDB, 0xEA, 0x7D, 0x4C, 0x1F, 0x2E,
+  0x43, 0x72, 0x21, 0x10, 0x87, 0xB6, 0xE5, 0xD4,
+  0xFA, 0xCB, 0x98, 0xA9, 0x3E, 0x0F, 0x5C, 0x6D,
+  0x86, 0xB7, 0xE4, 0xD5, 0x42, 0x73, 0x20, 0x11,
+  0x3F, 0x0E, 0x5D, 0x6C, 0xFB, 0xCA, 0x99, 0xA8,
+  0xC5, 0xF4, 0xA7, 0x96, 0x01, 0x30, 0x63, 0x52,
+  0x7C, 0x4D, 0x1E, 0x2F, 0xB8, 0x89, 0xDA, 0xEB,
+  0x3D, 0x0C, 0x5F, 0x6E, 0xF9, 0xC8, 0x9B, 0xAA,
+  0x84, 0xB5, 0xE6, 0xD7, 0x40, 0x71, 0x22, 0x13,
+  0x7E, 0x4F, 0x1C, 0x2D, 0xBA, 0x8B, 0xD8, 0xE9,
+  0xC7, 0xF6, 0xA5, 0x94, 0x03, 0x32, 0x61, 0x50,
+  0xBB, 0x8A, 0xD9, 0xE8, 0x7F, 0x4E, 0x1D, 0x2C,
+  0x02, 0x33, 0x60, 0x51, 0xC6, 0xF7, 0xA4, 0x95,
+  0xF8, 0xC9, 0x9A, 0xAB, 0x3C, 0x0D, 0x5E, 0x6F,
+  0x41, 0x70, 0x23, 0x12, 0x85, 0xB4, 0xE7, 0xD6,
+  0x7A, 0x4B, 0x18, 0x29, 0xBE, 0x8F, 0xDC, 0xED,
+  0xC3, 0xF2, 0xA1, 0x90, 0x07, 0x36, 0x65, 0x54,
+  0x39, 0x08, 0x5B, 0x6A, 0xFD, 0xCC, 0x9F, 0xAE,
+  0x80, 0xB1, 0xE2, 0xD3, 0x44, 0x75, 0x26, 0x17,
+  0xFC, 0xCD, 0x9E, 0xAF, 0x38, 0x09, 0x5A, 0x6B,
+  0x45, 0x74, 0x27, 0x16, 0x81, 0xB0, 0xE3, 0xD2,
+  0xBF, 0x8E, 0xDD, 0xEC, 0x7B, 0x4A, 0x19, 0x28,
+  0x06, 0x37, 0x64, 0x55, 0xC2, 0xF3, 0xA0, 0x91,
+  0x47, 0x76, 0x25, 0x14, 0x83, 0xB2, 0xE1, 0xD0,
+  0xFE, 0xCF, 0x9C, 0xAD, 0x3A, 0x0B, 0x58, 0x69,
+  0x04, 0x35, 0x66, 0x57, 0xC0, 0xF1, 0xA2, 0x93,
+  0xBD, 0x8C, 0xDF, 0xEE, 0x79, 0x48, 0x1B, 0x2A,
+  0xC1, 0xF0, 0xA3, 0x92, 0x05, 0x34, 0x67, 0x56,
+  0x78, 0x49, 0x1A, 0x2B, 0xBC, 0x8D, 0xDE, 0xEF,
+  0x82, 0xB3, 0xE0, 0xD1, 0x46, 0x77, 0x24, 0x15,
+  0x3B, 0x0A, 0x59, 0x68, 0xFF, 0xCE, 0x9D, 0xAC
+};
+
+//------------------------------------------------------------------------------
+uint8_t SHT85_CalcCrc(const uint8_t data[], uint8_t nbrOfBytes)
+{
+  uint8_t crc = 0xFF; // calculated checksum
+  uint8_t byteCtr;    // byte counter
+  
+  // calculates 8-Bit checksum, one table lookup per byte
+  for(byteCtr = 0; byteCtr < nbrOfBytes; byteCtr++) {
+    crc = crcTable[crc ^ data[byteCtr]];
+  }
+  
+  return crc;
+}
+
+#elif CRC_TABLE_SIZE == 16
+//------------------------------------------------------------------------------
+// CRC of every upper nibble value: crcTable[i] = CRC(i << 4) with initial
+// value 0
+static const uint8_t crcTable[16] = {
+  0x00, 0x31, 0x62, 0x53, 0xC4, 0xF5, 0xA6, 0x97,
+  0xB9, 0x88, 0xDB, 0xEA, 0x7D, 0x4C, 0x1F, 0x2E
+};
+
+//------------------------------------------------------------------------------
+uint8_t SHT85_CalcCrc(const uint8_t data[], uint8_t nbrOfBytes)
+{
+  uint8_t crc = 0xFF; // calculated checksum
+  uint8_t byteCtr;    // byte counter
+  
+  // calculates 8-Bit checksum, one table lookup per nibble
+  for(byteCtr = 0; byteCtr < nbrOfBytes; byteCtr++) {
+    crc ^= data[byteCtr];
+    crc = (uint8_t)(crc << 4) ^ crcTable[crc >> 4];
+    crc = (uint8_t)(crc << 4) ^ crcTable[crc >> 4];
+  }
+  
+  return crc;
+}
+
+#else
+//------------------------------------------------------------------------------
+uint8_t SHT85_CalcCrc(const uint8_t data[], uint8_t nbrOfBytes)
+{
+  uint8_t bit;        // bit mask
+  uint8_t crc = 0xFF; // calculated checksum
+  uint8_t byteCtr;    // byte counter
+  
+  // calculates 8-Bit checksum with given polynomial
+  for(byteCtr = 0; byteCtr < nbrOfBytes; byteCtr++) {
+    crc ^= (data[byteCtr]);
+    for(bit = 8; bit > 0; --bit) {
+      if(crc & 0x80) {
+        crc = (crc << 1) ^ CRC_POLYNOMIAL;
+      } else {
+        crc = (crc << 1);
+      }
+    }
+  }
+  
+  return crc;
+}
+#endif
+
+//------------------------------------------------------------------------------
+static etError CheckFrameCrc(uint8_t frame[], uint8_t nbrOfWords)
+{
+  uint8_t mismatch = 0; // accumulated checksum differences
+  uint8_t wordCtr;      // word counter
+  
+  // verify all words of the frame (2 data bytes + 1 checksum byte each)
+  for(wordCtr = 0; wordCtr < nbrOfWords; wordCtr++, frame += 3) {
+    mismatch |= SHT85_CalcCrc(frame, 2) ^ frame[2];
+  }
+  
+  if(mismatch != 0) {
+    INSTR_COUNT(crcErrors);
+  }
+  
+  return (mismatch != 0) ? CHECKSUM_ERROR : NO_ERROR;
+}
+
+//------------------------------------------------------------------------------
+int16_t SHT85_CalcTemperatureCenti(uint16_t rawValue)
+{
+  uint32_t product = (uint32_t)rawValue * 17500; // 175.00 * rawValue
+  
+  // calculate temperature [0.01°C]
+  // T = -4500 + 17500 * rawValue / (2^16-1)
+  // x / (2^16-1) = (x + x / 2^16) / 2^16 for x < 2^32, rounded to nearest
+  return (int16_t)((product + (product >> 16) + 0x8000) >> 16) - 4500;
+}
+
+//------------------------------------------------------------------------------
+uint16_t SHT85_CalcHumidityCenti(uint16_t rawValue)
+{
+  uint32_t product = (uint32_t)rawValue * 10000; // 100.00 * rawValue
+  
+  // calculate relative humidity [0.01%RH]
+  // RH = 10000 * rawValue / (2^16-1)
+  return (uint16_t)((product + (product >> 16) + 0x8000) >> 16);
+}
+
+//------------------------------------------------------------------------------
+static float CalcTemperature(uint16_t rawValue)
+{
+  // calculate temperature [°C]
+  // T = -45 + 175 * rawValue / (2^16-1)
+  return 175.0f * (float)rawValue / 65535.0f - 45.0f;
+}
+
+//------------------------------------------------------------------------------
+static float CalcHumidity(uint16_t rawValue)
+{
+  // calculate relative humidity [%RH]
+  // RH = rawValue / (2^16-1) * 100
+  return 100.0f * (float)rawValue / 65535.0f;
+}
+
+
+//------------------------------------------------------------------------------
+static void ReadMeasurementBuffersLockstep(tSht85* sensors[],
+                                           uint8_t sensorIdx[],
+                                           uint8_t nbrOfSensors,
+                                           float temperature[],
+                                           float humidity[], etError error[])
+{
+  tI2cGroup group;                         // buses clocked in lockstep
+  uint8_t   rxBytes[6][I2C_GROUP_MAX_BUSES]; // received bytes per bus
+  uint16_t  nack;                          // buses without acknowledge
+  uint8_t   address = sensors[sensorIdx[0]]->address; // common address
+  uint8_t   byteCtr;                       // byte counter
+  uint8_t   busIdx;                        // bus index in the group
+  uint8_t   frame[6];                      // received frame of one sensor
+  
+  // sensors sharing an SDA line are read in a later group
+  I2cGroup_Init(&group);
+  for(busIdx = 0; busIdx < nbrOfSensors; busIdx++) {
+    if(!I2cGroup_AddBus(&group, sensors[sensorIdx[busIdx]]->bus)) {
+      error[sensorIdx[busIdx]] =
+        SHT85_ReadMeasurementBuffer(sensors[sensorIdx[busIdx]],
+                                    &temperature[sensorIdx[busIdx]],
+                                    &humidity[sensorIdx[busIdx]]);
+      sensorIdx[busIdx] = 0xFF;
+    }
+  }
+  
+  // fetch command on all buses
+  I2cGroup_StartCondition(&group);
+  nack  = I2cGroup_WriteByte(&group, address << 1);
+  nack |= I2cGroup_WriteByte(&group, CMD_FETCH_DATA >> 8);
+  nack |= I2cGroup_WriteByte(&group, CMD_FETCH_DATA & 0xFF);
+  
+  // read temperature and humidity of all buses
+  I2cGroup_StartCondition(&group);
+  group.active &= ~nack;
+  nack |= I2cGroup_WriteByte(&group, address << 1 | 0x01);
+  for(byteCtr = 0; byteCtr < 6; byteCtr++) {
+    I2cGroup_ReadByte(&group, rxBytes[byteCtr], (byteCtr < 5) ? ACK : NO_ACK);
+  }
+  I2cGroup_StopCondition(&group);
+  
+  // verify checksums and calculate temperature and humidity of each sensor
+  busIdx = 0;
+  for(uint8_t i = 0; i < nbrOfSensors; i++) {
+    if(sensorIdx[i] == 0xFF) continue;
+    
+    if(nack & (1U << busIdx)) {
+      error[sensorIdx[i]] = ACK_ERROR;
+    } else {
+      for(byteCtr = 0; byteCtr < 6; byteCtr++) {
+        frame[byteCtr] = rxBytes[byteCtr][busIdx];
+      }
+      error[sensorIdx[i]] = CheckFrameCrc(frame, 2);
+      if(error[sensorIdx[i]] == NO_ERROR) {
+        temperature[sensorIdx[i]] = CalcTemperature((frame[0] << 8) | frame[1]);
+        humidity[sensorIdx[i]] = CalcHumidity((frame[3] << 8) | frame[4]);
+      }
+    }
+    busIdx++;
+  }
+}
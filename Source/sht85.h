@@ -1,199 +1,472 @@
-//==============================================================================
-// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
-//==============================================================================
-// Project   :  SHT85 Sample Code
-// File      :  sht85.h
-// Author    :  RFU
-// Date      :  17-Mai-2018
-// Controller:  STM32F100RB
-// IDE       :  Vision V5.25.2.0
-// Compiler  :  Armcc
-// Brief     :  Sensor Layer: Definitions of commands and functions for sensor
-//                            access.
-//==============================================================================
-
-#ifndef SHT85_H
-#define SHT85_H
-
-#include "i2c_hal.h"
-#include "system.h"
-#include <stdint.h>
-#include <stdbool.h>
-
-// Sensor Commands
-typedef enum {
-  CMD_READ_SERIALNBR = 0x3780, // read serial number
-  CMD_READ_STATUS    = 0xF32D, // read status register
-  CMD_CLEAR_STATUS   = 0x3041, // clear status register
-  CMD_HEATER_ENABLE  = 0x306D, // enabled heater
-  CMD_HEATER_DISABLE = 0x3066, // disable heater
-  CMD_SOFT_RESET     = 0x30A2, // soft reset
-  CMD_MEAS_SINGLE_H  = 0x2400, // single meas., high repeatability
-  CMD_MEAS_SINGLE_M  = 0x240B, // single meas., medium repeatability
-  CMD_MEAS_SINGLE_L  = 0x2416, // single meas., low repeatability
-  CMD_MEAS_PERI_05_H = 0x2032, // periodic meas. 0.5 mps, high repeatability
-  CMD_MEAS_PERI_05_M = 0x2024, // periodic meas. 0.5 mps, medium repeatability
-  CMD_MEAS_PERI_05_L = 0x202F, // periodic meas. 0.5 mps, low repeatability
-  CMD_MEAS_PERI_1_H  = 0x2130, // periodic meas. 1 mps, high repeatability
-  CMD_MEAS_PERI_1_M  = 0x2126, // periodic meas. 1 mps, medium repeatability
-  CMD_MEAS_PERI_1_L  = 0x212D, // periodic meas. 1 mps, low repeatability
-  CMD_MEAS_PERI_2_H  = 0x2236, // periodic meas. 2 mps, high repeatability
-  CMD_MEAS_PERI_2_M  = 0x2220, // periodic meas. 2 mps, medium repeatability
-  CMD_MEAS_PERI_2_L  = 0x222B, // periodic meas. 2 mps, low repeatability
-  CMD_MEAS_PERI_4_H  = 0x2334, // periodic meas. 4 mps, high repeatability
-  CMD_MEAS_PERI_4_M  = 0x2322, // periodic meas. 4 mps, medium repeatability
-  CMD_MEAS_PERI_4_L  = 0x2329, // periodic meas. 4 mps, low repeatability
-  CMD_MEAS_PERI_10_H = 0x2737, // periodic meas. 10 mps, high repeatability
-  CMD_MEAS_PERI_10_M = 0x2721, // periodic meas. 10 mps, medium repeatability
-  CMD_MEAS_PERI_10_L = 0x272A, // periodic meas. 10 mps, low repeatability
-  CMD_FETCH_DATA     = 0xE000, // readout measurements for periodic mode
-  CMD_BREAK          = 0x3093, // stop periodic measurement
-} etCommands;
-
-// Single Shot Measurement Repeatability
-typedef enum {
-  SINGLE_MEAS_LOW        = CMD_MEAS_SINGLE_L, // low repeatability
-  SINGLE_MEAS_MEDIUM     = CMD_MEAS_SINGLE_M, // medium repeatability
-  SINGLE_MEAS_HIGH       = CMD_MEAS_SINGLE_H  // high repeatability
-} etSingleMeasureModes;
-
-// Periodic Measurement Configurations
-typedef enum {
-  PERI_MEAS_LOW_05_HZ    = CMD_MEAS_PERI_05_L,
-  PERI_MEAS_LOW_1_HZ     = CMD_MEAS_PERI_1_L,
-  PERI_MEAS_LOW_2_HZ     = CMD_MEAS_PERI_2_L,
-  PERI_MEAS_LOW_4_HZ     = CMD_MEAS_PERI_4_L,
-  PERI_MEAS_LOW_10_HZ    = CMD_MEAS_PERI_10_L,
-  PERI_MEAS_MEDIUM_05_HZ = CMD_MEAS_PERI_05_M,
-  PERI_MEAS_MEDIUM_1_HZ  = CMD_MEAS_PERI_1_M,
-  PERI_MEAS_MEDIUM_2_HZ  = CMD_MEAS_PERI_2_M,
-  PERI_MEAS_MEDIUM_4_HZ  = CMD_MEAS_PERI_4_M,
-  PERI_MEAS_MEDIUM_10_HZ = CMD_MEAS_PERI_10_M,
-  PERI_MEAS_HIGH_05_HZ   = CMD_MEAS_PERI_05_H,
-  PERI_MEAS_HIGH_1_HZ    = CMD_MEAS_PERI_1_H,
-  PERI_MEAS_HIGH_2_HZ    = CMD_MEAS_PERI_2_H,
-  PERI_MEAS_HIGH_4_HZ    = CMD_MEAS_PERI_4_H,
-  PERI_MEAS_HIGH_10_HZ   = CMD_MEAS_PERI_10_H,
-} etPeriodicMeasureModes;
-
-//==============================================================================
-// Initializes the I2C bus for communication with the sensor.
-//------------------------------------------------------------------------------
-void SHT85_Init(void);
-
-
-//==============================================================================
-// Reads the serial number from sensor.
-//------------------------------------------------------------------------------
-// input: serialNumber  pointer to serialNumber
-//
-// return: error:       ACK_ERROR      = no acknowledgment from sensor
-//                      CHECKSUM_ERROR = checksum mismatch
-//                      NO_ERROR       = no error
-//------------------------------------------------------------------------------
-etError SHT85_ReadSerialNumber(uint32_t* serialNumber);
-
-
-//==============================================================================
-// Reads the status register from the sensor.
-//------------------------------------------------------------------------------
-// input: status        pointer to status
-//
-// return: error:       ACK_ERROR      = no acknowledgment from sensor
-//                      CHECKSUM_ERROR = checksum mismatch
-//                      NO_ERROR       = no error
-//------------------------------------------------------------------------------
-etError SHT85_ReadStatus(uint16_t* status);
-
-
-//==============================================================================
-// Clears all alert flags in status register from sensor.
-//------------------------------------------------------------------------------
-// return: error:       ACK_ERROR      = no acknowledgment from sensor
-//                      NO_ERROR       = no error
-//------------------------------------------------------------------------------
-etError SHT85_ClearAllAlertFlags(void);
-
-
-//==============================================================================
-// Gets the temperature [C] and the relative humidity [%RH] from the sensor.
-// This function polls every 1ms until measurement is ready.
-//------------------------------------------------------------------------------
-// input: temperature   pointer to temperature
-//        humiditiy     pointer to humidity
-//        measureMode   repeatability for the measurement [low, medium, high]
-//        timeout       polling timeout in milliseconds
-//
-// return: error:       ACK_ERROR      = no acknowledgment from sensor
-//                      CHECKSUM_ERROR = checksum mismatch
-//                      TIMEOUT_ERROR  = timeout
-//                      NO_ERROR       = no error
-//------------------------------------------------------------------------------
-etError SHT85_SingleMeasurment(float* temperature, float* humidity,
-                               etSingleMeasureModes measureMode,
-                               uint8_t timeout);
-
-
-//==============================================================================
-// Starts periodic measurement.
-//------------------------------------------------------------------------------
-// input: measureMode   defines the repeatability for the measurement and the
-//                      measurement frequency [0.5, 1, 2, 4, 10] Hz
-//
-// return: error:       ACK_ERROR      = no acknowledgment from sensor
-//                      NO_ERROR       = no error
-//------------------------------------------------------------------------------
-etError SHT85_StartPeriodicMeasurment(etPeriodicMeasureModes measureMode);
-
-
-//==============================================================================
-// Stops periodic measurement.
-//------------------------------------------------------------------------------
-// return: error:       ACK_ERROR      = no acknowledgment from sensor
-//                      NO_ERROR       = no error
-//------------------------------------------------------------------------------
-etError SHT85_StopPeriodicMeasurment(void);
-
-
-//==============================================================================
-// Reads last measurement from the sensor buffer
-//------------------------------------------------------------------------------
-// input: temperature   pointer to temperature
-//        humidity      pointer to humidity
-//
-// return: error:       ACK_ERROR      = no acknowledgment from sensor
-//                      CHECKSUM_ERROR = checksum mismatch
-//                      NO_ERROR       = no error
-//------------------------------------------------------------------------------
-etError SHT85_ReadMeasurementBuffer(float* temperature, float* humidity);
-
-
-//==============================================================================
-// Enables the heater on sensor
-//------------------------------------------------------------------------------
-// return: error:       ACK_ERROR      = no acknowledgment from sensor
-//                      NO_ERROR       = no error
-//------------------------------------------------------------------------------
-etError SHT85_EnableHeater(void);
-
-
-//==============================================================================
-// Disables the heater on sensor
-//------------------------------------------------------------------------------
-// return: error:       ACK_ERROR      = no acknowledgment from sensor
-//                      NO_ERROR       = no error
-//------------------------------------------------------------------------------
-etError SHT85_DisableHeater(void);
-
-
-//==============================================================================
-// Calls the soft reset mechanism that forces the sensor into a well-defined
-// state without removing the power supply.
-//------------------------------------------------------------------------------
-// return: error:       ACK_ERROR      = no acknowledgment from sensor
-//                      NO_ERROR       = no error
-//------------------------------------------------------------------------------
-etError SHT85_SoftReset(void);
-
-
-#endif
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  sht85.h
+// Author    :  RFU
+// Date      :  17-Mai-2018
+// Controller:  STM32F100RB
+// IDE       :  µVision V5.25.2.0
+// Compiler  :  Armcc
+// Brief     :  Sensor Layer: Definitions of commands and functions for sensor
+//                            access.
+//==============================================================================
+
+#ifndef SHT85_H
+#define SHT85_H
+
+#include "i2c_hal.h"
+#include "system.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// Sensor Commands
+typedef enum {
+  CMD_READ_SERIALNBR = 0x3780, // read serial number
+  CMD_READ_STATUS    = 0xF32D, // read status register
+  CMD_CLEAR_STATUS   = 0x3041, // clear status register
+  CMD_HEATER_ENABLE  = 0x306D, // enabled heater
+  CMD_HEATER_DISABLE = 0x3066, // disable heater
+  CMD_SOFT_RESET     = 0x30A2, // soft reset
+  CMD_MEAS_SINGLE_H  = 0x2400, // single meas., high repeatability
+  CMD_MEAS_SINGLE_M  = 0x240B, // single meas., medium repeatability
+  CMD_MEAS_SINGLE_L  = 0x2416, // single meas., low repeatability
+  CMD_MEAS_PERI_05_H = 0x2032, // periodic meas. 0.5 mps, high repeatability
+  CMD_MEAS_PERI_05_M = 0x2024, // periodic meas. 0.5 mps, medium repeatability
+  CMD_MEAS_PERI_05_L = 0x202F, // periodic meas. 0.5 mps, low repeatability
+  CMD_MEAS_PERI_1_H  = 0x2130, // periodic meas. 1 mps, high repeatability
+  CMD_MEAS_PERI_1_M  = 0x2126, // periodic meas. 1 mps, medium repeatability
+  CMD_MEAS_PERI_1_L  = 0x212D, // periodic meas. 1 mps, low repeatability
+  CMD_MEAS_PERI_2_H  = 0x2236, // periodic meas. 2 mps, high repeatability
+  CMD_MEAS_PERI_2_M  = 0x2220, // periodic meas. 2 mps, medium repeatability
+  CMD_MEAS_PERI_2_L  = 0x222B, // periodic meas. 2 mps, low repeatability
+  CMD_MEAS_PERI_4_H  = 0x2334, // periodic meas. 4 mps, high repeatability
+  CMD_MEAS_PERI_4_M  = 0x2322, // periodic meas. 4 mps, medium repeatability
+  CMD_MEAS_PERI_4_L  = 0x2329, // periodic meas. 4 mps, low repeatability
+  CMD_MEAS_PERI_10_H = 0x2737, // periodic meas. 10 mps, high repeatability
+  CMD_MEAS_PERI_10_M = 0x2721, // periodic meas. 10 mps, medium repeatability
+  CMD_MEAS_PERI_10_L = 0x272A, // periodic meas. 10 mps, low repeatability
+  CMD_FETCH_DATA     = 0xE000, // readout measurements for periodic mode
+  CMD_BREAK          = 0x3093, // stop periodic measurement
+} etCommands;
+
+// Single Shot Measurement Repeatability
+typedef enum {
+  SINGLE_MEAS_LOW        = CMD_MEAS_SINGLE_L, // low repeatability
+  SINGLE_MEAS_MEDIUM     = CMD_MEAS_SINGLE_M, // medium repeatability
+  SINGLE_MEAS_HIGH       = CMD_MEAS_SINGLE_H  // high repeatability
+} etSingleMeasureModes;
+
+// Periodic Measurement Configurations
+typedef enum {
+  PERI_MEAS_LOW_05_HZ    = CMD_MEAS_PERI_05_L,
+  PERI_MEAS_LOW_1_HZ     = CMD_MEAS_PERI_1_L,
+  PERI_MEAS_LOW_2_HZ     = CMD_MEAS_PERI_2_L,
+  PERI_MEAS_LOW_4_HZ     = CMD_MEAS_PERI_4_L,
+  PERI_MEAS_LOW_10_HZ    = CMD_MEAS_PERI_10_L,
+  PERI_MEAS_MEDIUM_05_HZ = CMD_MEAS_PERI_05_M,
+  PERI_MEAS_MEDIUM_1_HZ  = CMD_MEAS_PERI_1_M,
+  PERI_MEAS_MEDIUM_2_HZ  = CMD_MEAS_PERI_2_M,
+  PERI_MEAS_MEDIUM_4_HZ  = CMD_MEAS_PERI_4_M,
+  PERI_MEAS_MEDIUM_10_HZ = CMD_MEAS_PERI_10_M,
+  PERI_MEAS_HIGH_05_HZ   = CMD_MEAS_PERI_05_H,
+  PERI_MEAS_HIGH_1_HZ    = CMD_MEAS_PERI_1_H,
+  PERI_MEAS_HIGH_2_HZ    = CMD_MEAS_PERI_2_H,
+  PERI_MEAS_HIGH_4_HZ    = CMD_MEAS_PERI_4_H,
+  PERI_MEAS_HIGH_10_HZ   = CMD_MEAS_PERI_10_H,
+} etPeriodicMeasureModes;
+
+// Sensor I2C address
+#define SHT85_I2C_ADDR          0x44
+
+// Time the sensor needs after a soft reset before it accepts commands [ms]
+#define SHT85_SOFT_RESET_MS     50
+
+// Time the sensor needs after a break before it accepts commands [ms]
+#define SHT85_BREAK_MS          1
+
+// Conversion of constant limits [°C, %RH] to raw values, so measurements can
+// be compared against thresholds without conversion. Use with constants only,
+// the calculation is done by the compiler.
+#define SHT85_TEMPERATURE_TO_RAW(t) \
+  ((uint16_t)(((t) + 45.0) * 65535.0 / 175.0 + 0.5))
+#define SHT85_HUMIDITY_TO_RAW(rh) \
+  ((uint16_t)((rh) * 65535.0 / 100.0 + 0.5))
+// temperature difference [°C], e.g. a noise or rate limit; a humidity
+// difference converts with SHT85_HUMIDITY_TO_RAW()
+#define SHT85_TEMPERATURE_DIFF_TO_RAW(dt) \
+  ((uint16_t)((dt) * 65535.0 / 175.0 + 0.5))
+
+// Maximum number of sensors read in lockstep
+#define SHT85_MAX_SENSORS       16
+
+// Status register bits
+#define SHT85_STATUS_ALERT_PENDING  0x8000 // at least one pending alert
+#define SHT85_STATUS_HEATER         0x2000 // heater on
+#define SHT85_STATUS_RH_ALERT       0x0800 // humidity tracking alert
+#define SHT85_STATUS_T_ALERT        0x0400 // temperature tracking alert
+#define SHT85_STATUS_RESET          0x0010 // reset since the last clear
+#define SHT85_STATUS_COMMAND        0x0002 // last command not processed
+#define SHT85_STATUS_WRITE_CRC      0x0001 // checksum of last write wrong
+
+// Decoded status register
+typedef struct {
+  bool alertPending;     // at least one pending alert
+  bool heaterOn;         // heater on
+  bool humidityAlert;    // humidity tracking alert
+  bool temperatureAlert; // temperature tracking alert
+  bool resetDetected;    // reset (power-up, soft, general call, nRESET)
+                         // since the last SHT85_ClearAllAlertFlags()
+  bool commandFailed;    // last command not processed (invalid, wrong
+                         // checksum)
+  bool writeCrcFailed;   // checksum of the last write transfer wrong
+} tSht85Status;
+
+typedef struct sSht85 tSht85;
+
+// Completion callback of an asynchronous single shot measurement
+typedef void (*tSht85MeasureCallback)(tSht85* sensor, etError error,
+                                      float temperature, float humidity);
+
+// Sensor instance
+struct sSht85 {
+  const tI2cBus*        bus;           // I2C bus the sensor is connected to
+  uint8_t               address;       // I2C address
+  // asynchronous single shot measurement
+  bool                  asyncBusy;     // measurement in progress
+  uint32_t              asyncDeadline; // system time when result is ready [ms]
+  uint8_t               asyncRetries;  // remaining read retries
+  tSht85MeasureCallback asyncCallback; // completion callback
+};
+
+//==============================================================================
+// Initializes the sensor instance and the I2C bus for communication with the
+// sensor.
+//------------------------------------------------------------------------------
+// input: sensor        sensor instance
+//        bus           I2C bus the sensor is connected to
+//        address       I2C address of the sensor, normally SHT85_I2C_ADDR
+//------------------------------------------------------------------------------
+void SHT85_Init(tSht85* sensor, const tI2cBus* bus, uint8_t address);
+
+
+//==============================================================================
+// Reads the serial number from sensor.
+//------------------------------------------------------------------------------
+// input: sensor        sensor instance
+//        serialNumber  pointer to serialNumber
+//
+// return: error:       ACK_ERROR      = no acknowledgment from sensor
+//                      CHECKSUM_ERROR = checksum mismatch
+//                      NO_ERROR       = no error
+//------------------------------------------------------------------------------
+etError SHT85_ReadSerialNumber(tSht85* sensor, uint32_t* serialNumber);
+
+
+//==============================================================================
+// Reads the status register from the sensor.
+//------------------------------------------------------------------------------
+// input: sensor        sensor instance
+//        status        pointer to status
+//
+// return: error:       ACK_ERROR      = no acknowledgment from sensor
+//                      CHECKSUM_ERROR = checksum mismatch
+//                      NO_ERROR       = no error
+//------------------------------------------------------------------------------
+etError SHT85_ReadStatus(tSht85* sensor, uint16_t* status);
+
+
+//==============================================================================
+// Decodes the status register.
+//------------------------------------------------------------------------------
+// input: status        status register, from SHT85_ReadStatus()
+//        decoded       pointer to decoded status
+//------------------------------------------------------------------------------
+void SHT85_DecodeStatus(uint16_t status, tSht85Status* decoded);
+
+
+//==============================================================================
+// Clears all alert flags in status register from sensor.
+//------------------------------------------------------------------------------
+// input: sensor        sensor instance
+//
+// return: error:       ACK_ERROR      = no acknowledgment from sensor
+//                      NO_ERROR       = no error
+//------------------------------------------------------------------------------
+etError SHT85_ClearAllAlertFlags(tSht85* sensor);
+
+
+//==============================================================================
+// Gets the temperature [°C] and the relative humidity [%RH] from the sensor.
+// This function polls every 1ms until measurement is ready.
+//------------------------------------------------------------------------------
+// input: sensor        sensor instance
+//        temperature   pointer to temperature
+//        humiditiy     pointer to humidity
+//        measureMode   repeatability for the measurement [low, medium, high]
+//        timeout       polling timeout in milliseconds
+//
+// return: error:       ACK_ERROR      = no acknowledgment from sensor
+//                      CHECKSUM_ERROR = checksum mismatch
+//                      TIMEOUT_ERROR  = timeout
+//                      NO_ERROR       = no error
+//------------------------------------------------------------------------------
+etError SHT85_SingleMeasurment(tSht85* sensor,
+                               float* temperature, float* humidity,
+                               etSingleMeasureModes measureMode,
+                               uint8_t timeout);
+
+
+//==============================================================================
+// Gets the raw temperature and humidity values from the sensor, without
+// conversion. This function polls every 1ms until measurement is ready.
+//------------------------------------------------------------------------------
+// input: sensor        sensor instance
+//        rawValueTemp  pointer to raw temperature value
+//        rawValueHumi  pointer to raw humidity value
+//        measureMode   repeatability for the measurement [low, medium, high]
+//        timeout       polling timeout in milliseconds
+//
+// return: error:       ACK_ERROR      = no acknowledgment from sensor
+//                      CHECKSUM_ERROR = checksum mismatch
+//                      TIMEOUT_ERROR  = timeout
+//                      NO_ERROR       = no error
+//------------------------------------------------------------------------------
+etError SHT85_SingleMeasurmentRaw(tSht85* sensor,
+                                  uint16_t* rawValueTemp,
+                                  uint16_t* rawValueHumi,
+                                  etSingleMeasureModes measureMode,
+                                  uint8_t timeout);
+
+
+//==============================================================================
+// Starts a single shot measurement without waiting for the result. The result
+// is read by SHT85_ProcessAsync() once the conversion time of the chosen
+// repeatability has elapsed and is passed to the callback.
+//------------------------------------------------------------------------------
+// input: sensor        sensor instance
+//        measureMode   repeatability for the measurement [low, medium, high]
+//        callback      function called when the measurement is done
+//
+// return: error:       ACK_ERROR      = no acknowledgment from sensor
+//                      BUSY_ERROR     = a measurement is already in progress
+//                      NO_ERROR       = no error
+//------------------------------------------------------------------------------
+etError SHT85_StartMeasurementAsync(tSht85* sensor,
+                                    etSingleMeasureModes measureMode,
+                                    tSht85MeasureCallback callback);
+
+
+//==============================================================================
+// Advances the asynchronous measurement. Call this function from the main loop
+// or from a periodic timer interrupt (not while another bus access is ongoing).
+// The sensor is only addressed when the conversion time is over, the callback
+// is called from within this function.
+//------------------------------------------------------------------------------
+// input: sensor        sensor instance
+//
+// return: true  = measurement still in progress
+//         false = no measurement in progress
+//------------------------------------------------------------------------------
+bool SHT85_ProcessAsync(tSht85* sensor);
+
+
+//==============================================================================
+// Writes a command without response and returns without waiting for the
+// sensor, e.g. a single shot measurement or a soft reset whose waiting time
+// is handled by the caller.
+//------------------------------------------------------------------------------
+// input: sensor        sensor instance
+//        command       command to write
+//
+// return: error:       ACK_ERROR      = no acknowledgment from sensor
+//                      NO_ERROR       = no error
+//------------------------------------------------------------------------------
+etError SHT85_WriteCommand(tSht85* sensor, etCommands command);
+
+
+//==============================================================================
+// Reads the result of a single shot measurement started before with
+// SHT85_WriteCommand(), as raw values, without conversion.
+//------------------------------------------------------------------------------
+// input: sensor        sensor instance
+//        rawValueTemp  pointer to raw temperature value
+//        rawValueHumi  pointer to raw humidity value
+//
+// return: error:       ACK_ERROR      = measurement not ready yet or no
+//                                       acknowledgment from sensor
+//                      CHECKSUM_ERROR = checksum mismatch
+//                      NO_ERROR       = no error
+//------------------------------------------------------------------------------
+etError SHT85_ReadResultRaw(tSht85* sensor,
+                            uint16_t* rawValueTemp, uint16_t* rawValueHumi);
+
+
+//==============================================================================
+// Gets the maximum conversion time of a single shot measurement.
+//------------------------------------------------------------------------------
+// input: measureMode   repeatability for the measurement [low, medium, high]
+//
+// return: conversion time [ms], incl. one tick for the SysTick granularity
+//------------------------------------------------------------------------------
+uint8_t SHT85_GetMeasDurationMs(etSingleMeasureModes measureMode);
+
+
+//==============================================================================
+// Starts periodic measurement.
+//------------------------------------------------------------------------------
+// input: sensor        sensor instance
+//        measureMode   defines the repeatability for the measurement and the
+//                      measurement frequency [0.5, 1, 2, 4, 10] Hz
+//
+// return: error:       ACK_ERROR      = no acknowledgment from sensor
+//                      NO_ERROR       = no error
+//------------------------------------------------------------------------------
+etError SHT85_StartPeriodicMeasurment(tSht85* sensor,
+                                      etPeriodicMeasureModes measureMode);
+
+
+//==============================================================================
+// Stops periodic measurement.
+//------------------------------------------------------------------------------
+// input: sensor        sensor instance
+//
+// return: error:       ACK_ERROR      = no acknowledgment from sensor
+//                      NO_ERROR       = no error
+//------------------------------------------------------------------------------
+etError SHT85_StopPeriodicMeasurment(tSht85* sensor);
+
+
+//==============================================================================
+// Gets the measurement period of a periodic measurement mode.
+//------------------------------------------------------------------------------
+// input: measureMode   periodic measurement mode
+//
+// return: period [ms], 0 for an unknown mode
+//------------------------------------------------------------------------------
+uint16_t SHT85_GetPeriodMs(etPeriodicMeasureModes measureMode);
+
+
+//==============================================================================
+// Reads last measurement from the sensor buffer
+//------------------------------------------------------------------------------
+// input: sensor        sensor instance
+//        temperature   pointer to temperature
+//        humidity      pointer to humidity
+//
+// return: error:       ACK_ERROR      = no acknowledgment from sensor
+//                      CHECKSUM_ERROR = checksum mismatch
+//                      NO_ERROR       = no error
+//------------------------------------------------------------------------------
+etError SHT85_ReadMeasurementBuffer(tSht85* sensor,
+                                    float* temperature, float* humidity);
+
+
+//==============================================================================
+// Reads last measurement from the sensor buffer as raw values, without
+// conversion.
+//------------------------------------------------------------------------------
+// input: sensor        sensor instance
+//        rawValueTemp  pointer to raw temperature value
+//        rawValueHumi  pointer to raw humidity value
+//
+// return: error:       ACK_ERROR      = no acknowledgment from sensor
+//                      CHECKSUM_ERROR = checksum mismatch
+//                      NO_ERROR       = no error
+//------------------------------------------------------------------------------
+etError SHT85_ReadMeasurementBufferRaw(tSht85* sensor,
+                                       uint16_t* rawValueTemp,
+                                       uint16_t* rawValueHumi);
+
+
+//==============================================================================
+// Reads the last measurement from the buffers of several sensors. Sensors on
+// different buses of the same GPIO port are clocked in lockstep, so they are
+// read in the time of one. All other sensors are read one after the other.
+// Up to SHT85_MAX_SENSORS sensors are read, the sensors beyond are not.
+//------------------------------------------------------------------------------
+// input: sensors       array of sensor instances (bit-banged buses only)
+//        nbrOfSensors  number of sensors
+//        temperature   array of temperatures, one per sensor
+//        humidity      array of humidities, one per sensor
+//        error         array of error codes, one per sensor:
+//                      ACK_ERROR      = no acknowledgment from sensor
+//                      CHECKSUM_ERROR = checksum mismatch
+//                      PARM_ERROR     = beyond SHT85_MAX_SENSORS, not read
+//                      NO_ERROR       = no error
+//------------------------------------------------------------------------------
+void SHT85_ReadMeasurementBuffers(tSht85* sensors[], uint8_t nbrOfSensors,
+                                  float temperature[], float humidity[],
+                                  etError error[]);
+
+
+//==============================================================================
+// Enables the heater on sensor
+//------------------------------------------------------------------------------
+// input: sensor        sensor instance
+//
+// return: error:       ACK_ERROR      = no acknowledgment from sensor
+//                      NO_ERROR       = no error
+//------------------------------------------------------------------------------
+etError SHT85_EnableHeater(tSht85* sensor);
+
+
+//==============================================================================
+// Disables the heater on sensor
+//------------------------------------------------------------------------------
+// input: sensor        sensor instance
+//
+// return: error:       ACK_ERROR      = no acknowledgment from sensor
+//                      NO_ERROR       = no error
+//------------------------------------------------------------------------------
+etError SHT85_DisableHeater(tSht85* sensor);
+
+
+//==============================================================================
+// Calls the soft reset mechanism that forces the sensor into a well-defined
+// state without removing the power supply.
+//------------------------------------------------------------------------------
+// input: sensor        sensor instance
+//
+// return: error:       ACK_ERROR      = no acknowledgment from sensor
+//                      NO_ERROR       = no error
+//------------------------------------------------------------------------------
+etError SHT85_SoftReset(tSht85* sensor);
+
+
+//==============================================================================
+// Calculates the CRC-8 checksum of the sensor (polynomial 0x31, initialization
+// 0xFF), implementation selected by CRC_TABLE_SIZE.
+//------------------------------------------------------------------------------
+// input: data          data bytes
+//        nbrOfBytes    number of data bytes, 2 for a data word
+//
+// return: checksum
+//------------------------------------------------------------------------------
+uint8_t SHT85_CalcCrc(const uint8_t data[], uint8_t nbrOfBytes);
+
+
+//==============================================================================
+// Calculates the temperature [0.01°C] from a raw value with integer arithmetic
+// only. The result is the correctly rounded value of the float formula, the
+// maximum error is 0.5 LSB = 0.005°C.
+//------------------------------------------------------------------------------
+// input: rawValue      raw temperature value from sensor
+//
+// return: temperature in 0.01°C [-4500 .. 13000]
+//------------------------------------------------------------------------------
+int16_t SHT85_CalcTemperatureCenti(uint16_t rawValue);
+
+
+//==============================================================================
+// Calculates the relative humidity [0.01%RH] from a raw value with integer
+// arithmetic only. The maximum error is 0.5 LSB = 0.005%RH.
+//------------------------------------------------------------------------------
+// input: rawValue      raw humidity value from sensor
+//
+// return: relative humidity in 0.01%RH [0 .. 10000]
+//------------------------------------------------------------------------------
+uint16_t SHT85_CalcHumidityCenti(uint16_t rawValue);
+
+
+#endif
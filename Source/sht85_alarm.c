@@ -0,0 +1,157 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  sht85_alarm.c
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  STM32F100RB
+// IDE       :  µVision V5.25.2.0
+// Compiler  :  Armcc
+// Brief     :  Threshold alarms of one sensor.
+//==============================================================================
+
+#include "sht85_alarm.h"
+
+static void    InitLimits(tSht85AlarmLimits* limits);
+static uint8_t CheckLimits(tSht85AlarmLimits* limits, uint16_t raw,
+                           bool primed, uint8_t state, uint8_t shift);
+
+//------------------------------------------------------------------------------
+void SHT85_AlarmInit(tSht85Alarm* alarm, tSht85* sensor,
+                     tSht85AlarmCallback callback)
+{
+  uint8_t i; // flag index
+  
+  alarm->sensor   = sensor;
+  alarm->callback = callback;
+  alarm->primed   = false;
+  alarm->state    = 0;
+  alarm->timeMs   = 0;
+  alarm->rawTemp  = 0;
+  alarm->rawHumi  = 0;
+  alarm->changes  = 0;
+  InitLimits(&alarm->temp);
+  InitLimits(&alarm->humi);
+  
+  for(i = 0; i < SHT85_ALARM_NBR_OF_FLAGS; i++) {
+    alarm->port[i] = 0;
+    alarm->pin[i]  = 0;
+  }
+}
+
+//------------------------------------------------------------------------------
+void SHT85_AlarmSetLimits(tSht85Alarm* alarm, bool humidity, uint16_t lowRaw,
+                          uint16_t highRaw, uint16_t hysteresisRaw,
+                          uint16_t rateRaw)
+{
+  tSht85AlarmLimits* limits = humidity ? &alarm->humi : &alarm->temp;
+  
+  // the clear limits saturate, a disabled limit stays unreachable
+  limits->highSet   = highRaw;
+  limits->highClear = (highRaw > hysteresisRaw) ? highRaw - hysteresisRaw : 0;
+  limits->lowSet    = lowRaw;
+  limits->lowClear  = (lowRaw < 0xFFFF - hysteresisRaw) ? lowRaw + hysteresisRaw
+                                                        : 0xFFFF;
+  limits->rateSet   = rateRaw;
+  limits->rateClear = rateRaw / 2;
+}
+
+//------------------------------------------------------------------------------
+void SHT85_AlarmSetOutput(tSht85Alarm* alarm, uint8_t flag,
+                          GPIO_TypeDef* port, uint16_t pin)
+{
+  uint8_t i; // flag index
+  
+  for(i = 0; i < SHT85_ALARM_NBR_OF_FLAGS; i++) {
+    if(flag == (1 << i)) {
+      alarm->port[i] = port;
+      alarm->pin[i]  = pin;
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+uint8_t SHT85_AlarmCheck(tSht85Alarm* alarm, const tSht85Sample* sample)
+{
+  uint8_t state   = alarm->state; // new alarm state
+  uint8_t changed;                // changed alarm flags
+  uint8_t i;                      // flag index
+  
+  // temperature flags in bit 0..2, humidity in bit 3..5
+  state = CheckLimits(&alarm->temp, sample->rawTemp, alarm->primed, state, 0);
+  state = CheckLimits(&alarm->humi, sample->rawHumi, alarm->primed, state, 3);
+  alarm->primed = true;
+  
+  changed = state ^ alarm->state;
+  if(changed == 0) {
+    return state;
+  }
+  
+  alarm->state   = state;
+  alarm->timeMs  = sample->timeMs;
+  alarm->rawTemp = sample->rawTemp;
+  alarm->rawHumi = sample->rawHumi;
+  alarm->changes++;
+  
+  // set or reset the outputs of the changed flags
+  for(i = 0; i < SHT85_ALARM_NBR_OF_FLAGS; i++) {
+    if((changed & (1 << i)) && alarm->port[i]) {
+      alarm->port[i]->BSRR = (state & (1 << i)) ? alarm->pin[i]
+                                                : (uint32_t)alarm->pin[i] << 16;
+    }
+  }
+  
+  if(alarm->callback) {
+    alarm->callback(alarm, changed);
+  }
+  
+  return state;
+}
+
+//------------------------------------------------------------------------------
+static void InitLimits(tSht85AlarmLimits* limits)
+{
+  limits->highSet   = SHT85_ALARM_HIGH_OFF;
+  limits->highClear = SHT85_ALARM_HIGH_OFF;
+  limits->lowSet    = SHT85_ALARM_LOW_OFF;
+  limits->lowClear  = SHT85_ALARM_LOW_OFF;
+  limits->rateSet   = SHT85_ALARM_RATE_OFF;
+  limits->rateClear = SHT85_ALARM_RATE_OFF;
+  limits->last      = 0;
+}
+
+//------------------------------------------------------------------------------
+static uint8_t CheckLimits(tSht85AlarmLimits* limits, uint16_t raw,
+                           bool primed, uint8_t state, uint8_t shift)
+{
+  uint8_t  high = (uint8_t)(SHT85_ALARM_TEMP_HIGH << shift); // high flag
+  uint8_t  low  = (uint8_t)(SHT85_ALARM_TEMP_LOW << shift);  // low flag
+  uint8_t  rate = (uint8_t)(SHT85_ALARM_TEMP_RATE << shift); // rate flag
+  uint16_t change; // absolute change to the last sample [raw]
+  
+  // between the set and the clear limit the flag is kept
+  if(raw > limits->highSet) {
+    state |= high;
+  } else if(raw < limits->highClear) {
+    state &= (uint8_t)~high;
+  }
+  
+  if(raw < limits->lowSet) {
+    state |= low;
+  } else if(raw > limits->lowClear) {
+    state &= (uint8_t)~low;
+  }
+  
+  if(limits->rateSet != SHT85_ALARM_RATE_OFF && primed) {
+    change = (raw > limits->last) ? raw - limits->last : limits->last - raw;
+    if(change > limits->rateSet) {
+      state |= rate;
+    } else if(change <= limits->rateClear) {
+      state &= (uint8_t)~rate;
+    }
+  }
+  limits->last = raw;
+  
+  return state;
+}
@@ -0,0 +1,136 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  sht85_alarm.h
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  STM32F100RB
+// IDE       :  µVision V5.25.2.0
+// Compiler  :  Armcc
+// Brief     :  Threshold alarms of one sensor. Each quantity has a high and a
+//              low limit with a hysteresis band and a limit of the change
+//              from one sample to the next. The limits are converted to raw
+//              values when they are set, so a sample is checked with a few
+//              integer compares and no conversion:
+//
+//                high alarm: set above high, cleared below high - hysteresis
+//                low alarm:  set below low, cleared above low + hysteresis
+//                rate alarm: set at a change above rate, cleared at a change
+//                            of rate / 2 or less
+//
+//              The callback and the outputs are only called on a change of an
+//              alarm, with the sample that caused it.
+//==============================================================================
+
+#ifndef SHT85_ALARM_H
+#define SHT85_ALARM_H
+
+#include "sht85.h"
+#include "sht85_stream.h"
+#include "system.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// Alarm flags
+#define SHT85_ALARM_TEMP_HIGH  0x01 // temperature above the high limit
+#define SHT85_ALARM_TEMP_LOW   0x02 // temperature below the low limit
+#define SHT85_ALARM_TEMP_RATE  0x04 // temperature changes too fast
+#define SHT85_ALARM_HUMI_HIGH  0x08 // humidity above the high limit
+#define SHT85_ALARM_HUMI_LOW   0x10 // humidity below the low limit
+#define SHT85_ALARM_HUMI_RATE  0x20 // humidity changes too fast
+#define SHT85_ALARM_NBR_OF_FLAGS 6
+
+// Raw limits that are never reached, to disable a limit
+#define SHT85_ALARM_HIGH_OFF   0xFFFF
+#define SHT85_ALARM_LOW_OFF    0x0000
+#define SHT85_ALARM_RATE_OFF   0x0000
+
+typedef struct sSht85Alarm tSht85Alarm;
+
+// Alarm callback, called when alarms are set or cleared
+typedef void (*tSht85AlarmCallback)(const tSht85Alarm* alarm,
+                                    uint8_t changed);
+
+// Raw limits of one quantity
+typedef struct {
+  uint16_t highSet;   // high alarm above
+  uint16_t highClear; // high alarm cleared below
+  uint16_t lowSet;    // low alarm below
+  uint16_t lowClear;  // low alarm cleared above
+  uint16_t rateSet;   // rate alarm at a change above, 0 = off
+  uint16_t rateClear; // rate alarm cleared at a change of up to
+  uint16_t last;      // raw value of the last sample
+} tSht85AlarmLimits;
+
+// Alarms of one sensor
+struct sSht85Alarm {
+  tSht85*             sensor;   // checked sensor, passed to the callback
+  tSht85AlarmCallback callback; // called on a change, may be null
+  tSht85AlarmLimits   temp;     // temperature limits
+  tSht85AlarmLimits   humi;     // humidity limits
+  bool                primed;   // last sample valid for the rate
+  uint8_t             state;    // active alarms (SHT85_ALARM_...)
+  uint32_t            timeMs;   // sample of the last change [ms]
+  uint16_t            rawTemp;  // raw temperature of that sample
+  uint16_t            rawHumi;  // raw humidity of that sample
+  // outputs by flag, port null = none
+  GPIO_TypeDef*       port[SHT85_ALARM_NBR_OF_FLAGS];
+  uint16_t            pin[SHT85_ALARM_NBR_OF_FLAGS];
+  // statistics
+  uint32_t            changes;  // calls of the callback
+};
+
+//==============================================================================
+// Initializes the alarms of a sensor, all limits disabled.
+//------------------------------------------------------------------------------
+// input: alarm         alarm instance
+//        sensor        checked sensor, passed to the callback
+//        callback      called when alarms are set or cleared, may be null
+//------------------------------------------------------------------------------
+void SHT85_AlarmInit(tSht85Alarm* alarm, tSht85* sensor,
+                     tSht85AlarmCallback callback);
+
+
+//==============================================================================
+// Sets the limits of one quantity. The raw limits are precomputed with
+// SHT85_TEMPERATURE_TO_RAW(), SHT85_HUMIDITY_TO_RAW() and
+// SHT85_TEMPERATURE_DIFF_TO_RAW() for the hysteresis and the rate.
+//------------------------------------------------------------------------------
+// input: alarm         alarm instance
+//        humidity      true = humidity limits, false = temperature
+//        lowRaw        low limit, SHT85_ALARM_LOW_OFF = none
+//        highRaw       high limit, SHT85_ALARM_HIGH_OFF = none
+//        hysteresisRaw width of the hysteresis band
+//        rateRaw       change per sample, SHT85_ALARM_RATE_OFF = none
+//------------------------------------------------------------------------------
+void SHT85_AlarmSetLimits(tSht85Alarm* alarm, bool humidity, uint16_t lowRaw,
+                          uint16_t highRaw, uint16_t hysteresisRaw,
+                          uint16_t rateRaw);
+
+
+//==============================================================================
+// Sets an output that follows an alarm: the pin is set while it is active.
+// The pin has to be configured as output by the application.
+//------------------------------------------------------------------------------
+// input: alarm         alarm instance
+//        flag          one alarm flag (SHT85_ALARM_...)
+//        port          GPIO port, null = no output
+//        pin           pin mask
+//------------------------------------------------------------------------------
+void SHT85_AlarmSetOutput(tSht85Alarm* alarm, uint8_t flag,
+                          GPIO_TypeDef* port, uint16_t pin);
+
+
+//==============================================================================
+// Checks a sample against the limits, in order of the samples. On a change the
+// outputs are written and the callback is called.
+//------------------------------------------------------------------------------
+// input: alarm         alarm instance
+//        sample        sample read from the stream
+//
+// return: active alarms (SHT85_ALARM_...)
+//------------------------------------------------------------------------------
+uint8_t SHT85_AlarmCheck(tSht85Alarm* alarm, const tSht85Sample* sample);
+
+#endif
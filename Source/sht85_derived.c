@@ -0,0 +1,201 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  sht85_derived.c
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  STM32F100RB
+// IDE       :  µVision V5.25.2.0
+// Compiler  :  Armcc
+// Brief     :  Fixed-point dew point, absolute humidity and mixing ratio.
+//==============================================================================
+
+#include "sht85_derived.h"
+
+// Magnus parameters over water
+#define MAGNUS_BETA_Q12       72172 // 17.62 [1/4096]
+#define MAGNUS_LAMBDA_CENTI   24312 // 243.12°C [0.01°C]
+#define MAGNUS_E0_PA_Q8      156467 // 611.2Pa [1/256 Pa]
+
+#define LN2_Q16               45426 // ln(2) [1/65536]
+#define LOG2E_Q16             94548 // log2(e) [1/65536]
+#define LOG2_FULL_SCALE_Q16 1048575 // log2(2^16 - 1) [1/65536]
+
+#define ABS_HUMIDITY_FACTOR   21670 // 216.7 * 100 for [0.01g/m^3]
+#define MIXING_RATIO_FACTOR   62197 // 621.97 * 100 for [0.01g/kg]
+#define KELVIN_CENTI          27315 // 0°C [0.01K]
+
+// log2(1 + i/32) [1/65536]
+static const uint32_t log2Table[33] = {
+      0,  2909,  5732,  8473, 11136, 13727, 16248, 18704, 21098, 23433,
+  25711, 27936, 30109, 32234, 34312, 36346, 38336, 40286, 42196, 44068,
+  45904, 47705, 49472, 51207, 52911, 54584, 56229, 57845, 59434, 60997,
+  62534, 64047, 65536
+};
+
+// 2^(i/32) [1/65536]
+static const uint32_t pow2Table[33] = {
+   65536,  66971,  68438,  69936,  71468,  73032,  74632,  76266,  77936,
+   79642,  81386,  83169,  84990,  86851,  88752,  90696,  92682,  94711,
+   96785,  98905, 101070, 103283, 105545, 107856, 110218, 112631, 115098,
+  117618, 120194, 122825, 125515, 128263, 131072
+};
+
+static int32_t  CalcGamma(uint16_t rawValueTemp, uint16_t rawValueHumi,
+                          int16_t* temperature);
+static uint32_t CalcVaporPressure(int32_t gamma);
+static int32_t  Log2(uint16_t value);
+static uint32_t Pow2Frac(uint16_t fraction);
+
+//------------------------------------------------------------------------------
+int16_t SHT85_CalcDewPointCenti(uint16_t rawValueTemp, uint16_t rawValueHumi)
+{
+  int16_t temperature; // temperature [0.01°C]
+  int32_t gamma;       // Magnus gamma [1/4096]
+  int32_t dividend;    // lambda * gamma
+  int32_t divisor;     // beta - gamma
+  
+  gamma = CalcGamma(rawValueTemp, rawValueHumi, &temperature) / 16;
+  
+  // Td = lambda * gamma / (beta - gamma), rounded, gamma < beta always
+  dividend = MAGNUS_LAMBDA_CENTI * gamma;
+  divisor  = MAGNUS_BETA_Q12 - gamma;
+  if(dividend >= 0) {
+    return (int16_t)((dividend + divisor / 2) / divisor);
+  } else {
+    return (int16_t)((dividend - divisor / 2) / divisor);
+  }
+}
+
+//------------------------------------------------------------------------------
+uint16_t SHT85_CalcAbsHumidityCenti(uint16_t rawValueTemp,
+                                    uint16_t rawValueHumi)
+{
+  int16_t  temperature;   // temperature [0.01°C]
+  uint32_t vaporPressure; // vapor pressure [1/256 Pa]
+  uint32_t factor;        // 216.7 / T [1/65536 g/m^3 / Pa]
+  uint32_t result;        // absolute humidity [0.01g/m^3]
+  
+  vaporPressure = CalcVaporPressure(CalcGamma(rawValueTemp, rawValueHumi,
+                                              &temperature));
+  
+  // AH = 216.7 * e / T with T in 0.01K
+  factor = ((uint32_t)ABS_HUMIDITY_FACTOR << 16) /
+           (uint32_t)(temperature + KELVIN_CENTI);
+  result = (uint32_t)(((uint64_t)vaporPressure * factor + (1UL << 23)) >> 24);
+  
+  return (result > 0xFFFF) ? 0xFFFF : (uint16_t)result;
+}
+
+//------------------------------------------------------------------------------
+uint16_t SHT85_CalcMixingRatioCenti(uint16_t rawValueTemp,
+                                    uint16_t rawValueHumi,
+                                    uint32_t pressurePa)
+{
+  int16_t  temperature;   // temperature [0.01°C]
+  uint32_t vaporPressure; // vapor pressure [1/256 Pa]
+  uint32_t dryPressure;   // partial pressure of the dry air [Pa]
+  uint32_t factor;        // 62197 / (p - e) [1/65536 / Pa]
+  uint32_t result;        // mixing ratio [0.01g/kg]
+  
+  vaporPressure = CalcVaporPressure(CalcGamma(rawValueTemp, rawValueHumi,
+                                              &temperature));
+  
+  // no dry air left, above the boiling point at this pressure
+  if((vaporPressure >> 8) >= pressurePa) {
+    return 0xFFFF;
+  }
+  
+  // r = 621.97 * e / (p - e)
+  dryPressure = pressurePa - (vaporPressure >> 8);
+  factor      = ((uint32_t)MIXING_RATIO_FACTOR << 16) / dryPressure;
+  result = (uint32_t)(((uint64_t)vaporPressure * factor + (1UL << 23)) >> 24);
+  
+  return (result > 0xFFFF) ? 0xFFFF : (uint16_t)result;
+}
+
+//------------------------------------------------------------------------------
+static int32_t CalcGamma(uint16_t rawValueTemp, uint16_t rawValueHumi,
+                         int16_t* temperature)
+{
+  int32_t lnHumidity; // ln(RH / 100%) [1/65536]
+  int32_t dividend;   // beta * T
+  int32_t divisor;    // lambda + T
+  int32_t quotient;   // beta * T / (lambda + T) [1/4096]
+  int32_t remainder;  // remainder of the division
+  
+  *temperature = SHT85_CalcTemperatureCenti(rawValueTemp);
+  
+  // ln(RH / 100%) = (log2(raw) - log2(2^16 - 1)) * ln(2), 0%RH is taken as
+  // the smallest value above it
+  if(rawValueHumi == 0) {
+    rawValueHumi = 1;
+  }
+  lnHumidity = (int32_t)(((int64_t)(Log2(rawValueHumi) - LOG2_FULL_SCALE_Q16)
+                          * LN2_Q16) >> 16);
+  
+  // beta * T / (lambda + T), the remainder gives the last 4 bits
+  dividend  = MAGNUS_BETA_Q12 * *temperature;
+  divisor   = MAGNUS_LAMBDA_CENTI + *temperature;
+  quotient  = dividend / divisor;
+  remainder = dividend % divisor;
+  
+  return lnHumidity + quotient * 16 + (remainder * 16) / divisor;
+}
+
+//------------------------------------------------------------------------------
+static uint32_t CalcVaporPressure(int32_t gamma)
+{
+  int32_t  exponent; // gamma * log2(e) [1/65536]
+  int32_t  shift;    // integer part of the exponent
+  uint32_t pressure; // 611.2Pa * 2^(fraction of the exponent) [1/256 Pa]
+  
+  // e = 611.2Pa * exp(gamma) = 611.2Pa * 2^(gamma * log2(e))
+  exponent = (int32_t)(((int64_t)gamma * LOG2E_Q16) >> 16);
+  shift    = exponent >> 16;
+  pressure = (uint32_t)(((uint64_t)MAGNUS_E0_PA_Q8 *
+                         Pow2Frac((uint16_t)exponent)) >> 16);
+  
+  if(shift >= 0) {
+    return pressure << shift;
+  } else if(shift > -32) {
+    return pressure >> -shift;
+  } else {
+    return 0;
+  }
+}
+
+//------------------------------------------------------------------------------
+static int32_t Log2(uint16_t value)
+{
+  int32_t  exponent = 15; // integer part of log2
+  uint32_t mantissa;      // value normalized to [2^15, 2^16)
+  uint8_t  index;         // table index
+  uint32_t fraction;      // position between two table entries [1/1024]
+  
+  // value > 0: normalize, the leading one is at bit 15
+  mantissa = value;
+  while(!(mantissa & 0x8000)) {
+    mantissa <<= 1;
+    exponent--;
+  }
+  
+  // interpolate log2 of the 5 bits after the leading one
+  index    = (uint8_t)((mantissa >> 10) & 0x1F);
+  fraction = mantissa & 0x3FF;
+  
+  return (exponent << 16) + (int32_t)(log2Table[index] +
+         (((log2Table[index + 1] - log2Table[index]) * fraction) >> 10));
+}
+
+//------------------------------------------------------------------------------
+static uint32_t Pow2Frac(uint16_t fraction)
+{
+  uint8_t  index = (uint8_t)(fraction >> 11); // table index
+  uint32_t rest  = fraction & 0x7FF;          // position between entries
+  
+  // 2^fraction for fraction in [0, 1), interpolated [1/65536]
+  return pow2Table[index] +
+         (((pow2Table[index + 1] - pow2Table[index]) * rest) >> 11);
+}
@@ -0,0 +1,79 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  sht85_derived.h
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  STM32F100RB
+// IDE       :  µVision V5.25.2.0
+// Compiler  :  Armcc
+// Brief     :  Quantities derived from temperature and relative humidity:
+//              dew point, absolute humidity and mixing ratio, in fixed-point
+//              arithmetic without float and without logf()/expf().
+//
+//              All quantities use the Magnus formula over water with the
+//              parameters of the Sensirion application note (beta = 17.62,
+//              lambda = 243.12°C, valid for -45..60°C):
+//                gamma = ln(RH / 100%) + beta * T / (lambda + T)
+//                dew point    Td = lambda * gamma / (beta - gamma)
+//                vapor pressure e = 611.2Pa * exp(gamma)
+//                absolute humidity = 2.167 * e / (T + 273.15K) [g/m^3]
+//                mixing ratio      = 621.97 * e / (p - e)      [g/kg]
+//
+//              ln() and exp() are computed as log2() and 2^x from tables of
+//              33 entries with linear interpolation. The inputs are the raw
+//              sensor values, which resolve the low humidities much finer
+//              than 0.01%RH. Compared to the double precision formulas over
+//              -45..60°C and 1..100%RH, the errors are below 0.02°C dew point,
+//              0.04g/m^3 absolute humidity and 0.06g/kg mixing ratio, or 0.1%
+//              of the values above 10g/m^3 and 10g/kg.
+//==============================================================================
+
+#ifndef SHT85_DERIVED_H
+#define SHT85_DERIVED_H
+
+#include "sht85.h"
+#include <stdint.h>
+
+#define SHT85_PRESSURE_STANDARD_PA 101325 // standard sea level pressure [Pa]
+
+//==============================================================================
+// Calculates the dew point [0.01°C] from raw values with integer arithmetic.
+//------------------------------------------------------------------------------
+// input: rawValueTemp  raw temperature value from sensor
+//        rawValueHumi  raw humidity value from sensor
+//
+// return: dew point in 0.01°C
+//------------------------------------------------------------------------------
+int16_t SHT85_CalcDewPointCenti(uint16_t rawValueTemp, uint16_t rawValueHumi);
+
+
+//==============================================================================
+// Calculates the absolute humidity [0.01g/m^3] from raw values with integer
+// arithmetic.
+//------------------------------------------------------------------------------
+// input: rawValueTemp  raw temperature value from sensor
+//        rawValueHumi  raw humidity value from sensor
+//
+// return: absolute humidity in 0.01g/m^3, limited to 65535
+//------------------------------------------------------------------------------
+uint16_t SHT85_CalcAbsHumidityCenti(uint16_t rawValueTemp,
+                                    uint16_t rawValueHumi);
+
+
+//==============================================================================
+// Calculates the mixing ratio [0.01g/kg] (mass of water vapor per mass of dry
+// air) from raw values with integer arithmetic.
+//------------------------------------------------------------------------------
+// input: rawValueTemp  raw temperature value from sensor
+//        rawValueHumi  raw humidity value from sensor
+//        pressurePa    air pressure [Pa], e.g. SHT85_PRESSURE_STANDARD_PA
+//
+// return: mixing ratio in 0.01g/kg, limited to 65535
+//------------------------------------------------------------------------------
+uint16_t SHT85_CalcMixingRatioCenti(uint16_t rawValueTemp,
+                                    uint16_t rawValueHumi,
+                                    uint32_t pressurePa);
+
+#endif
@@ -0,0 +1,92 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  sht85_health.c
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  STM32F100RB
+// IDE       :  µVision V5.25.2.0
+// Compiler  :  Armcc
+// Brief     :  Health monitor for the periodic measurement mode.
+//==============================================================================
+
+#include "sht85_health.h"
+
+//------------------------------------------------------------------------------
+void SHT85_HealthInit(tSht85Health* health, uint16_t interval)
+{
+  health->interval       = interval;
+  health->countdown      = interval;
+  health->checks         = 0;
+  health->readErrors     = 0;
+  health->resets         = 0;
+  health->commandErrors  = 0;
+  health->writeCrcErrors = 0;
+  health->alerts         = 0;
+  
+  SHT85_DecodeStatus(0, &health->status);
+}
+
+//------------------------------------------------------------------------------
+etError SHT85_HealthStart(tSht85Health* health, tSht85* sensor)
+{
+  etError error; // error code
+  
+  if(health->interval == 0) {
+    return NO_ERROR;
+  }
+  
+  health->countdown = health->interval;
+  
+  // clears the reset flag as well
+  error = SHT85_ClearAllAlertFlags(sensor);
+  if(error == NO_ERROR) {
+    SHT85_DecodeStatus(0, &health->status);
+  }
+  
+  return error;
+}
+
+//------------------------------------------------------------------------------
+etError SHT85_HealthUpdate(tSht85Health* health, tSht85* sensor)
+{
+  etError  error;        // error code
+  uint16_t status;       // status register
+  bool     alertPending; // alert pending at the last status read
+  
+  if(health->interval == 0 || --health->countdown > 0) {
+    return NO_ERROR;
+  }
+  
+  error = SHT85_ReadStatus(sensor, &status);
+  
+  // the sensor NACKs while it is measuring, read again with the next fetch
+  if(error == ACK_ERROR) {
+    health->countdown = 1;
+    return NO_ERROR;
+  }
+  
+  health->countdown = health->interval;
+  if(error != NO_ERROR) {
+    health->readErrors++;
+    return error;
+  }
+  
+  health->checks++;
+  alertPending = health->status.alertPending;
+  SHT85_DecodeStatus(status, &health->status);
+  
+  if(health->status.commandFailed)  health->commandErrors++;
+  if(health->status.writeCrcFailed) health->writeCrcErrors++;
+  
+  // the alert flag stays set until it is cleared, an alert counts once
+  if(health->status.alertPending && !alertPending) health->alerts++;
+  
+  if(health->status.resetDetected) {
+    health->resets++;
+    return RESET_ERROR;
+  }
+  
+  return NO_ERROR;
+}
@@ -0,0 +1,86 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  sht85_health.h
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  STM32F100RB
+// IDE       :  µVision V5.25.2.0
+// Compiler  :  Armcc
+// Brief     :  Health monitor for the periodic measurement mode: reads the
+//              status register every interval fetches and counts what it
+//              finds. An unexpected reset of the sensor (brown-out, ESD)
+//              ends the periodic measurement, the following fetches are
+//              NACKed just like fetches of a sample not ready yet. The reset
+//              flag of the status register, cleared when the measurement is
+//              started, reveals it after at most interval fetches.
+//
+//              The fetches are counted including the NACKed ones, so a reset
+//              sensor is found within interval retries. One status read costs
+//              about as much bus time as a third of a fetch.
+//==============================================================================
+
+#ifndef SHT85_HEALTH_H
+#define SHT85_HEALTH_H
+
+#include "sht85.h"
+#include "system.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// Health monitor of one sensor
+typedef struct {
+  uint16_t     interval;       // fetches per status read, 0 = off
+  uint16_t     countdown;      // fetches until the next status read
+  tSht85Status status;         // last status read
+  // statistics
+  uint32_t     checks;         // status reads
+  uint32_t     readErrors;     // failed status reads
+  uint32_t     resets;         // unexpected resets
+  uint32_t     commandErrors;  // commands not processed
+  uint32_t     writeCrcErrors; // write transfers with a wrong checksum
+  uint32_t     alerts;         // alerts, counted at the first read of the
+                               // flag
+} tSht85Health;
+
+//==============================================================================
+// Initializes the health monitor.
+//------------------------------------------------------------------------------
+// input: health        health monitor instance
+//        interval      fetches per status read, 0 = monitor off
+//------------------------------------------------------------------------------
+void SHT85_HealthInit(tSht85Health* health, uint16_t interval);
+
+
+//==============================================================================
+// Clears the status flags of the sensor before the periodic measurement is
+// started, so that a later reset can be recognized.
+//------------------------------------------------------------------------------
+// input: health        health monitor instance
+//        sensor        sensor instance, not measuring
+//
+// return: error:       ACK_ERROR      = no acknowledgment from sensor
+//                      NO_ERROR       = no error, or monitor off
+//------------------------------------------------------------------------------
+etError SHT85_HealthStart(tSht85Health* health, tSht85* sensor);
+
+
+//==============================================================================
+// Counts a fetch, successful or not, and reads and checks the status register
+// every interval fetches.
+//------------------------------------------------------------------------------
+// input: health        health monitor instance
+//        sensor        sensor instance
+//
+// return: error:       RESET_ERROR    = the sensor has been reset, the
+//                                       periodic measurement has ended
+//                      CHECKSUM_ERROR = checksum mismatch of the status
+//                      NO_ERROR       = no error, no status read or the
+//                                       status read was NACKed (the sensor
+//                                       is measuring, read with the next
+//                                       fetch)
+//------------------------------------------------------------------------------
+etError SHT85_HealthUpdate(tSht85Health* health, tSht85* sensor);
+
+#endif
@@ -0,0 +1,207 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  sht85_heater.c
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  STM32F100RB
+// IDE       :  µVision V5.25.2.0
+// Compiler  :  Armcc
+// Brief     :  Heater controller for condensation recovery.
+//==============================================================================
+
+#include "sht85_heater.h"
+
+static void    PrepareResume(tSht85Heater* heater, uint32_t nowMs,
+                             uint32_t delayMs, bool settle);
+static uint8_t GetConversionMs(etPeriodicMeasureModes measureMode);
+
+//------------------------------------------------------------------------------
+void SHT85_HeaterInit(tSht85Heater* heater, tSht85Stream* stream,
+                      etPeriodicMeasureModes measureMode,
+                      uint16_t thresholdRaw, uint32_t sustainMs,
+                      uint32_t pulseMs, uint32_t settleMs)
+{
+  heater->stream       = stream;
+  heater->measureMode  = measureMode;
+  heater->thresholdRaw = thresholdRaw;
+  heater->sustainMs    = sustainMs;
+  heater->pulseMs      = pulseMs;
+  heater->settleMs     = settleMs;
+  heater->state        = SHT85_HEATER_MONITOR;
+  heater->high         = false;
+  heater->pulses       = 0;
+  heater->dropped      = 0;
+  heater->verifyErrors = 0;
+}
+
+//------------------------------------------------------------------------------
+bool SHT85_HeaterCheck(tSht85Heater* heater, const tSht85Sample* sample)
+{
+  // the samples until the sensor has cooled down are dropped, the sustain
+  // time starts again after them
+  if(heater->state == SHT85_HEATER_SETTLE) {
+    if((int32_t)(sample->timeMs - heater->settleEndMs) < 0) {
+      heater->dropped++;
+      return false;
+    }
+    heater->state = SHT85_HEATER_MONITOR;
+    heater->high  = false;
+  }
+  
+  if(heater->state != SHT85_HEATER_MONITOR) {
+    return true;
+  }
+  
+  // raw compare, the humidity has to stay above the threshold
+  if(sample->rawHumi < heater->thresholdRaw) {
+    heater->high = false;
+  } else if(!heater->high) {
+    heater->high   = true;
+    heater->highMs = sample->timeMs;
+  } else if(sample->timeMs - heater->highMs >= heater->sustainMs) {
+    heater->state = SHT85_HEATER_DUE;
+  }
+  
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool SHT85_HeaterActive(const tSht85Heater* heater)
+{
+  return heater->state == SHT85_HEATER_DUE ||
+         heater->state == SHT85_HEATER_ENABLE ||
+         heater->state == SHT85_HEATER_PULSE ||
+         heater->state == SHT85_HEATER_RESUME;
+}
+
+//------------------------------------------------------------------------------
+uint32_t SHT85_HeaterWaitMs(const tSht85Heater* heater, uint32_t nowMs)
+{
+  int32_t waitMs = (int32_t)(heater->stepMs - nowMs); // wrap-around safe
+  
+  if(heater->state != SHT85_HEATER_ENABLE &&
+     heater->state != SHT85_HEATER_PULSE &&
+     heater->state != SHT85_HEATER_RESUME) {
+    return 0;
+  }
+  
+  return (waitMs > 0) ? (uint32_t)waitMs : 0;
+}
+
+//------------------------------------------------------------------------------
+etError SHT85_HeaterStep(tSht85Heater* heater)
+{
+  tSht85*      sensor = heater->stream->sensor; // sensor of the stream
+  uint32_t     nowMs  = System_GetTickMs();     // time of the step [ms]
+  etError      error  = NO_ERROR;               // error code
+  uint16_t     status;                          // status register
+  tSht85Status decoded;                         // decoded status register
+  
+  switch(heater->state) {
+    case SHT85_HEATER_DUE:
+      // stop the stream, the sample after the last one is the reference of
+      // its phase
+      error = SHT85_StreamStop(heater->stream);
+      heater->dueMs = heater->stream->schedule.sampleMs +
+                      heater->stream->schedule.periodMs;
+      
+      // the sensor accepts no command for 1ms after the break, one tick
+      // more as the step time is in whole ticks
+      if(error == NO_ERROR) {
+        heater->state  = SHT85_HEATER_ENABLE;
+        heater->stepMs = nowMs + SHT85_BREAK_MS + 1;
+      }
+      break;
+    
+    case SHT85_HEATER_ENABLE:
+      error = SHT85_EnableHeater(sensor);
+      if(error == NO_ERROR) {
+        error = SHT85_ReadStatus(sensor, &status);
+      }
+      if(error == NO_ERROR) {
+        SHT85_DecodeStatus(status, &decoded);
+        if(decoded.heaterOn) {
+          heater->pulses++;
+          heater->state  = SHT85_HEATER_PULSE;
+          heater->stepMs = nowMs + heater->pulseMs;
+        } else {
+          // heater did not switch on: no pulse, the stream is resumed
+          heater->verifyErrors++;
+          error = SHT85_DisableHeater(sensor);
+          PrepareResume(heater, nowMs, 0, false);
+        }
+      }
+      break;
+    
+    case SHT85_HEATER_PULSE:
+      error = SHT85_DisableHeater(sensor);
+      if(error == NO_ERROR) {
+        error = SHT85_ReadStatus(sensor, &status);
+      }
+      if(error == NO_ERROR) {
+        SHT85_DecodeStatus(status, &decoded);
+        if(decoded.heaterOn) {
+          // heater did not switch off: a soft reset switches it off
+          heater->verifyErrors++;
+          error = SHT85_WriteCommand(sensor, CMD_SOFT_RESET);
+          PrepareResume(heater, nowMs, SHT85_SOFT_RESET_MS, true);
+        } else {
+          PrepareResume(heater, nowMs, 0, true);
+        }
+      }
+      break;
+    
+    case SHT85_HEATER_RESUME:
+      error = SHT85_StreamResume(heater->stream, heater->measureMode,
+                                 heater->dueMs);
+      heater->state = SHT85_HEATER_SETTLE;
+      break;
+    
+    default:
+      break;
+  }
+  
+  // the error handling of the application starts again
+  if(error != NO_ERROR) {
+    heater->state = SHT85_HEATER_MONITOR;
+    heater->high  = false;
+  }
+  
+  return error;
+}
+
+//------------------------------------------------------------------------------
+static void PrepareResume(tSht85Heater* heater, uint32_t nowMs,
+                          uint32_t delayMs, bool settle)
+{
+  uint16_t periodMs = heater->stream->schedule.periodMs;    // period [ms]
+  uint8_t  convMs   = GetConversionMs(heater->measureMode); // conversion [ms]
+  int32_t  lateMs;  // earliest possible sample after the reference [ms]
+  
+  // first sample in the phase of the stream that can be reached when the
+  // measurement is started one conversion time before
+  lateMs = (int32_t)(nowMs + delayMs + convMs - heater->dueMs);
+  if(lateMs > 0) {
+    heater->dueMs += ((uint32_t)lateMs + periodMs - 1) / periodMs * periodMs;
+  }
+  
+  heater->stepMs      = heater->dueMs - convMs;
+  heater->settleEndMs = settle ? nowMs + heater->settleMs : nowMs;
+  heater->state       = SHT85_HEATER_RESUME;
+}
+
+//------------------------------------------------------------------------------
+static uint8_t GetConversionMs(etPeriodicMeasureModes measureMode)
+{
+  // the LSB of the command encodes the repeatability: 0x30..0x37 high,
+  // 0x29..0x2F low, 0x20..0x26 medium
+  if((measureMode & 0xFF) >= 0x30) {
+    return SHT85_GetMeasDurationMs(SINGLE_MEAS_HIGH);
+  } else if((measureMode & 0xFF) >= 0x29) {
+    return SHT85_GetMeasDurationMs(SINGLE_MEAS_LOW);
+  } else {
+    return SHT85_GetMeasDurationMs(SINGLE_MEAS_MEDIUM);
+  }
+}
@@ -0,0 +1,141 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  sht85_heater.h
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  STM32F100RB
+// IDE       :  µVision V5.25.2.0
+// Compiler  :  Armcc
+// Brief     :  Heater controller for condensation recovery. In saturated air
+//              water condenses on the sensor, the humidity then reads near
+//              100%RH and creeps back only slowly after the air has dried. The
+//              controller watches the samples of a stream: when the humidity
+//              stays above a threshold for a sustain time, it stops the
+//              stream, heats the sensor for a pulse time and starts the
+//              stream again in its previous phase. The samples of a settle
+//              time after the pulse, while the sensor cools down, are dropped.
+//
+//              The heater is switched with the periodic measurement stopped,
+//              the heater bit of the status register is checked after
+//              switching it on and off. The controller does not wait itself,
+//              the application runs the steps when they are due:
+//
+//                while(SHT85_HeaterActive(&heater)) {
+//                  wait until SHT85_HeaterWaitMs(&heater, now) == 0
+//                  error = SHT85_HeaterStep(&heater);
+//                }
+//==============================================================================
+
+#ifndef SHT85_HEATER_H
+#define SHT85_HEATER_H
+
+#include "sht85.h"
+#include "sht85_stream.h"
+#include "system.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// Heater controller states
+typedef enum {
+  SHT85_HEATER_MONITOR, // stream running, humidity monitored
+  SHT85_HEATER_DUE,     // sustained high humidity, pulse to be started
+  SHT85_HEATER_ENABLE,  // stream stopped, heater on after the break time
+  SHT85_HEATER_PULSE,   // stream stopped, heater on
+  SHT85_HEATER_RESUME,  // heater off, waiting for the phase of the stream
+  SHT85_HEATER_SETTLE,  // stream running, samples dropped while cooling down
+} etSht85HeaterState;
+
+// Heater controller of one stream
+typedef struct {
+  tSht85Stream*          stream;       // controlled stream
+  etPeriodicMeasureModes measureMode;  // periodic measurement mode of it
+  uint16_t               thresholdRaw; // raw humidity threshold
+  uint32_t               sustainMs;    // time above the threshold [ms]
+  uint32_t               pulseMs;      // heater on time [ms]
+  uint32_t               settleMs;     // samples dropped after the pulse [ms]
+  etSht85HeaterState     state;        // state
+  bool                   high;         // last sample above the threshold
+  uint32_t               highMs;       // first sample above the threshold [ms]
+  uint32_t               stepMs;       // system time of the next step [ms]
+  uint32_t               settleEndMs;  // end of the settle time [ms]
+  uint32_t               dueMs;        // next sample in the stream phase [ms]
+  // statistics
+  uint32_t               pulses;       // heater pulses
+  uint32_t               dropped;      // samples dropped after a pulse
+  uint32_t               verifyErrors; // heater bit not as commanded
+} tSht85Heater;
+
+//==============================================================================
+// Initializes the heater controller of a stream.
+//------------------------------------------------------------------------------
+// input: heater        heater controller instance
+//        stream        stream instance, initialized
+//        measureMode   periodic measurement mode the stream is started with
+//        thresholdRaw  raw humidity threshold, e.g. SHT85_HUMIDITY_TO_RAW(95)
+//        sustainMs     time above the threshold before a pulse, also the
+//                      minimum time between two pulses [ms]
+//        pulseMs       heater on time [ms]
+//        settleMs      time after the pulse whose samples are dropped [ms]
+//------------------------------------------------------------------------------
+void SHT85_HeaterInit(tSht85Heater* heater, tSht85Stream* stream,
+                      etPeriodicMeasureModes measureMode,
+                      uint16_t thresholdRaw, uint32_t sustainMs,
+                      uint32_t pulseMs, uint32_t settleMs);
+
+
+//==============================================================================
+// Checks a sample read from the stream, in order of the samples.
+//------------------------------------------------------------------------------
+// input: heater        heater controller instance
+//        sample        sample read from the stream
+//
+// return: true  = valid sample
+//         false = sample within the settle time, to be dropped
+//------------------------------------------------------------------------------
+bool SHT85_HeaterCheck(tSht85Heater* heater, const tSht85Sample* sample);
+
+
+//==============================================================================
+// Checks if a heater pulse is due or running. The stream is stopped then and
+// SHT85_HeaterStep() has to be called until the pulse is done.
+//------------------------------------------------------------------------------
+// input: heater        heater controller instance
+//
+// return: true  = pulse due or running
+//         false = stream running
+//------------------------------------------------------------------------------
+bool SHT85_HeaterActive(const tSht85Heater* heater);
+
+
+//==============================================================================
+// Gets the time until the next step of a pulse is due.
+//------------------------------------------------------------------------------
+// input: heater        heater controller instance
+//        nowMs         system time [ms]
+//
+// return: time until the next step [ms], 0 if it is due
+//------------------------------------------------------------------------------
+uint32_t SHT85_HeaterWaitMs(const tSht85Heater* heater, uint32_t nowMs);
+
+
+//==============================================================================
+// Runs the next step of a pulse: stops the stream, switches the heater on
+// after the break time (SHT85_BREAK_MS), switches it off at the end of the
+// pulse and starts the stream again in its phase. If the heater bit is not
+// set after switching on, the pulse is skipped; if it is still set after
+// switching off, a soft reset switches the heater off.
+//------------------------------------------------------------------------------
+// input: heater        heater controller instance
+//
+// return: error:       ACK_ERROR      = no acknowledgment from sensor
+//                      CHECKSUM_ERROR = checksum mismatch of the status
+//                      NO_ERROR       = no error
+// remark: after an error the stream is stopped and the controller monitors
+//         again, the error handling of the application has to reset the
+//         sensor (the heater is off after a reset) and start the stream
+//------------------------------------------------------------------------------
+etError SHT85_HeaterStep(tSht85Heater* heater);
+
+#endif
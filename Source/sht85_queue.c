@@ -0,0 +1,266 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  sht85_queue.c
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  STM32F100RB
+// IDE       :  µVision V5.25.2.0
+// Compiler  :  Armcc
+// Brief     :  Command queue with priorities and non-blocking sensor waits.
+//==============================================================================
+
+#include "sht85_queue.h"
+
+#define QUEUE_MEAS_RETRIES  3 // result read retries [ms] after conversion time
+#define QUEUE_BREAK_MS      1 // sensor waiting time after a break command [ms]
+
+// Request states
+typedef enum {
+  REQ_FREE,    // slot is free
+  REQ_QUEUED,  // waiting for its first bus transaction
+  REQ_WAITING, // holds its sensor until readyMs (conversion, reset)
+} etRequestState;
+
+static bool SensorHeld(const tSht85Queue* queue, const tSht85* sensor);
+static void Execute(tSht85Queue* queue, tSht85Request* request,
+                    uint32_t nowMs);
+static void Hold(tSht85Request* request, uint32_t waitMs, uint32_t nowMs);
+static void Complete(tSht85Queue* queue, tSht85Request* request,
+                     etError error, uint32_t nowMs);
+
+//------------------------------------------------------------------------------
+void SHT85_QueueInit(tSht85Queue* queue)
+{
+  uint8_t i; // slot index
+  
+  for(i = 0; i < SHT85_QUEUE_SIZE; i++) {
+    queue->requests[i].state = REQ_FREE;
+  }
+  
+  queue->sequence = 0;
+  queue->depth    = 0;
+  queue->maxDepth = 0;
+  queue->rejected = 0;
+  
+  for(i = 0; i < SHT85_NBR_OF_PRIOS; i++) {
+    queue->stats[i].completed      = 0;
+    queue->stats[i].failed         = 0;
+    queue->stats[i].latencySumMs   = 0;
+    queue->stats[i].latencyMaxMs   = 0;
+    queue->stats[i].deadlineMisses = 0;
+  }
+}
+
+//------------------------------------------------------------------------------
+etError SHT85_QueueSubmit(tSht85Queue* queue, tSht85* sensor,
+                          etCommands command, etSht85Priority priority,
+                          uint16_t deadlineMs, tSht85RequestCallback callback,
+                          uint32_t nowMs)
+{
+  tSht85Request* request; // free request slot
+  uint8_t        i;       // slot index
+  
+  for(i = 0; i < SHT85_QUEUE_SIZE; i++) {
+    if(queue->requests[i].state == REQ_FREE) break;
+  }
+  
+  if(i == SHT85_QUEUE_SIZE) {
+    queue->rejected++;
+    return BUSY_ERROR;
+  }
+  
+  request = &queue->requests[i];
+  request->sensor     = sensor;
+  request->command    = command;
+  request->priority   = (uint8_t)priority;
+  request->state      = REQ_QUEUED;
+  request->sequence   = queue->sequence++;
+  request->submitMs   = nowMs;
+  request->readyMs    = nowMs;
+  request->deadlineMs = nowMs + deadlineMs;
+  request->timed      = (deadlineMs > 0);
+  request->error      = NO_ERROR;
+  request->data[0]    = 0;
+  request->data[1]    = 0;
+  request->callback   = callback;
+  
+  queue->depth++;
+  if(queue->depth > queue->maxDepth) {
+    queue->maxDepth = queue->depth;
+  }
+  
+  return NO_ERROR;
+}
+
+//------------------------------------------------------------------------------
+uint32_t SHT85_QueueProcess(tSht85Queue* queue, uint32_t nowMs)
+{
+  tSht85Request* next   = 0;                // request to execute
+  tSht85Request* request;                   // examined request
+  uint32_t       waitMs = SHT85_QUEUE_IDLE; // time until the next step [ms]
+  int32_t        remainingMs;               // waiting time of a request [ms]
+  uint8_t        i;                         // slot index
+  
+  for(i = 0; i < SHT85_QUEUE_SIZE; i++) {
+    request = &queue->requests[i];
+    
+    if(request->state == REQ_FREE) continue;
+    
+    // the sensor is busy with a waiting request, continue after its wait
+    if(request->state == REQ_QUEUED && SensorHeld(queue, request->sensor)) {
+      continue;
+    }
+    
+    remainingMs = (int32_t)(request->readyMs - nowMs);
+    if(remainingMs > 0) {
+      if((uint32_t)remainingMs < waitMs) {
+        waitMs = (uint32_t)remainingMs;
+      }
+      continue;
+    }
+    
+    // highest priority first, in submission order within a priority
+    if(next == 0 || request->priority < next->priority ||
+       (request->priority == next->priority &&
+        (int32_t)(request->sequence - next->sequence) < 0)) {
+      next = request;
+    }
+  }
+  
+  if(next == 0) return waitMs;
+  
+  Execute(queue, next, nowMs);
+  
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+static bool SensorHeld(const tSht85Queue* queue, const tSht85* sensor)
+{
+  uint8_t i; // slot index
+  
+  for(i = 0; i < SHT85_QUEUE_SIZE; i++) {
+    if(queue->requests[i].state == REQ_WAITING &&
+       queue->requests[i].sensor == sensor) {
+      return true;
+    }
+  }
+  
+  return false;
+}
+
+//------------------------------------------------------------------------------
+static void Execute(tSht85Queue* queue, tSht85Request* request,
+                    uint32_t nowMs)
+{
+  etError  error;        // error code
+  uint32_t serialNumber; // serial number
+  tSht85*  sensor = request->sensor;
+  
+  switch(request->command) {
+    case CMD_FETCH_DATA:
+      error = SHT85_ReadMeasurementBufferRaw(sensor, &request->data[0],
+                                             &request->data[1]);
+      break;
+    
+    case CMD_READ_STATUS:
+      error = SHT85_ReadStatus(sensor, &request->data[0]);
+      break;
+    
+    case CMD_READ_SERIALNBR:
+      error = SHT85_ReadSerialNumber(sensor, &serialNumber);
+      if(error == NO_ERROR) {
+        request->data[0] = (uint16_t)(serialNumber >> 16);
+        request->data[1] = (uint16_t)serialNumber;
+      }
+      break;
+    
+    case CMD_MEAS_SINGLE_H:
+    case CMD_MEAS_SINGLE_M:
+    case CMD_MEAS_SINGLE_L:
+      if(request->state == REQ_QUEUED) {
+        // start the measurement, read the result after the conversion time
+        error = SHT85_WriteCommand(sensor, request->command);
+        if(error == NO_ERROR) {
+          request->retries = QUEUE_MEAS_RETRIES;
+          Hold(request, SHT85_GetMeasDurationMs(
+                          (etSingleMeasureModes)request->command), nowMs);
+          return;
+        }
+      } else {
+        error = SHT85_ReadResultRaw(sensor, &request->data[0],
+                                    &request->data[1]);
+        // measurement not ready yet (NACK) -> retry with the next tick
+        if(error == ACK_ERROR && request->retries > 0) {
+          request->retries--;
+          Hold(request, 1, nowMs);
+          return;
+        }
+        if(error == ACK_ERROR) {
+          error = TIMEOUT_ERROR;
+        }
+      }
+      break;
+    
+    default:
+      // commands without response, the wait after the command is over
+      if(request->state == REQ_WAITING) {
+        error = NO_ERROR;
+        break;
+      }
+      
+      error = SHT85_WriteCommand(sensor, request->command);
+      
+      // the sensor does not accept commands during reset and break
+      if(error == NO_ERROR && request->command == CMD_SOFT_RESET) {
+        Hold(request, SHT85_SOFT_RESET_MS, nowMs);
+        return;
+      }
+      if(error == NO_ERROR && request->command == CMD_BREAK) {
+        Hold(request, QUEUE_BREAK_MS, nowMs);
+        return;
+      }
+      break;
+  }
+  
+  Complete(queue, request, error, nowMs);
+}
+
+//------------------------------------------------------------------------------
+static void Hold(tSht85Request* request, uint32_t waitMs, uint32_t nowMs)
+{
+  request->state   = REQ_WAITING;
+  request->readyMs = nowMs + waitMs;
+}
+
+//------------------------------------------------------------------------------
+static void Complete(tSht85Queue* queue, tSht85Request* request,
+                     etError error, uint32_t nowMs)
+{
+  tSht85Request     done      = *request; // copy passed to the callback
+  tSht85QueueStats* stats     = &queue->stats[request->priority];
+  uint32_t          latencyMs = nowMs - request->submitMs;
+  
+  // free the slot first, the callback may submit the next request
+  request->state = REQ_FREE;
+  queue->depth--;
+  
+  stats->completed++;
+  stats->latencySumMs += latencyMs;
+  if(latencyMs > stats->latencyMaxMs) {
+    stats->latencyMaxMs = latencyMs;
+  }
+  if(error != NO_ERROR) {
+    stats->failed++;
+  }
+  if(done.timed && (int32_t)(nowMs - done.deadlineMs) > 0) {
+    stats->deadlineMisses++;
+  }
+  
+  done.error = error;
+  if(done.callback) {
+    done.callback(&done);
+  }
+}
@@ -0,0 +1,134 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  sht85_queue.h
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  STM32F100RB
+// IDE       :  µVision V5.25.2.0
+// Compiler  :  Armcc
+// Brief     :  Command queue: sensor commands of any number of sensors are
+//              queued as requests and executed one bus transaction at a time
+//              by SHT85_QueueProcess(), highest priority first.
+//
+//              Waiting times of the sensor (conversion of a single shot
+//              measurement, soft reset, break) do not block: the request holds
+//              its sensor until the wait is over, meanwhile requests for other
+//              sensors are executed. A long housekeeping command can therefore
+//              delay a fetch by at most one bus transaction.
+//==============================================================================
+
+#ifndef SHT85_QUEUE_H
+#define SHT85_QUEUE_H
+
+#include "sht85.h"
+#include "system.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// max. number of queued requests
+#define SHT85_QUEUE_SIZE  8
+
+// SHT85_QueueProcess() return value if the queue is empty
+#define SHT85_QUEUE_IDLE  0xFFFFFFFF
+
+// Request priorities, lower value = executed first
+typedef enum {
+  SHT85_PRIO_FETCH        = 0, // measurement fetches and results
+  SHT85_PRIO_CONTROL      = 1, // start and stop of measurements
+  SHT85_PRIO_HOUSEKEEPING = 2, // status, alert flags, heater, reset
+  SHT85_NBR_OF_PRIOS      = 3
+} etSht85Priority;
+
+typedef struct sSht85Request tSht85Request;
+
+// Completion callback of a request. The request is a copy, its slot in the
+// queue is already free, so the callback may submit new requests.
+typedef void (*tSht85RequestCallback)(const tSht85Request* request);
+
+// Queued request
+struct sSht85Request {
+  tSht85*               sensor;     // addressed sensor
+  etCommands            command;    // sensor command
+  uint8_t               priority;   // etSht85Priority
+  uint8_t               state;      // free, queued or waiting for the sensor
+  uint8_t               retries;    // remaining result read retries
+  uint32_t              sequence;   // submission order within a priority
+  uint32_t              submitMs;   // system time of the submission [ms]
+  uint32_t              readyMs;    // end of the sensor waiting time [ms]
+  uint32_t              deadlineMs; // latest completion time [ms]
+  bool                  timed;      // request has a deadline
+  etError               error;      // result of the request
+  uint16_t              data[2];    // response: raw temperature, humidity /
+                                    // status / serial number MSW, LSW
+  tSht85RequestCallback callback;   // completion callback, may be null
+};
+
+// Statistics of one priority
+typedef struct {
+  uint32_t completed;      // completed requests
+  uint32_t failed;         // requests completed with an error
+  uint32_t latencySumMs;   // sum of the latencies submission->completion
+  uint32_t latencyMaxMs;   // max. latency
+  uint32_t deadlineMisses; // requests completed after their deadline
+} tSht85QueueStats;
+
+// Command queue
+typedef struct {
+  tSht85Request    requests[SHT85_QUEUE_SIZE]; // request slots
+  uint32_t         sequence;                   // next submission number
+  uint8_t          depth;                      // requests in the queue
+  // statistics
+  uint8_t          maxDepth;                   // max. requests in the queue
+  uint32_t         rejected;                   // submissions to a full queue
+  tSht85QueueStats stats[SHT85_NBR_OF_PRIOS];  // statistics per priority
+} tSht85Queue;
+
+//==============================================================================
+// Initializes an empty queue and resets the statistics.
+//------------------------------------------------------------------------------
+// input: queue         queue instance
+//------------------------------------------------------------------------------
+void SHT85_QueueInit(tSht85Queue* queue);
+
+
+//==============================================================================
+// Queues a sensor command. Supported are all commands of etCommands: the
+// single shot measurements return the raw values, CMD_FETCH_DATA the raw
+// values of the periodic mode, CMD_READ_STATUS the status and
+// CMD_READ_SERIALNBR the serial number in data[]. All other commands have no
+// response.
+//------------------------------------------------------------------------------
+// input: queue         queue instance
+//        sensor        addressed sensor
+//        command       sensor command
+//        priority      request priority
+//        deadlineMs    max. latency until completion [ms], 0 = none
+//        callback      function called when the request is done, may be null
+//        nowMs         system time [ms]
+//
+// return: error:       BUSY_ERROR     = queue is full
+//                      NO_ERROR       = no error
+//------------------------------------------------------------------------------
+etError SHT85_QueueSubmit(tSht85Queue* queue, tSht85* sensor,
+                          etCommands command, etSht85Priority priority,
+                          uint16_t deadlineMs, tSht85RequestCallback callback,
+                          uint32_t nowMs);
+
+
+//==============================================================================
+// Executes the next step of the highest priority request that can proceed:
+// at most one bus transaction, or the completion of a finished wait. Call this
+// function from the main loop (not while another bus access is ongoing). The
+// callbacks are called from within this function.
+//------------------------------------------------------------------------------
+// input: queue         queue instance
+//        nowMs         system time [ms]
+//
+// return: time until the next step [ms], 0 = call again immediately,
+//         SHT85_QUEUE_IDLE = queue is empty
+//------------------------------------------------------------------------------
+uint32_t SHT85_QueueProcess(tSht85Queue* queue, uint32_t nowMs);
+
+#endif
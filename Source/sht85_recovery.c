@@ -0,0 +1,194 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  sht85_recovery.c
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  STM32F100RB
+// IDE       :  µVision V5.25.2.0
+// Compiler  :  Armcc
+// Brief     :  Error recovery of one sensor in the periodic measurement mode.
+//==============================================================================
+
+#include "sht85_recovery.h"
+#include "i2c_hal.h"
+
+static etError ResetSensor(tSht85Recovery* recovery);
+static void    Backoff(tSht85Recovery* recovery, uint32_t nowMs);
+
+//------------------------------------------------------------------------------
+void SHT85_RecoveryInit(tSht85Recovery* recovery, tSht85* sensor,
+                        tSht85Stream* stream,
+                        etPeriodicMeasureModes measureMode,
+                        uint32_t minBackoffMs, uint32_t maxBackoffMs)
+{
+  recovery->sensor       = sensor;
+  recovery->stream       = stream;
+  recovery->measureMode  = measureMode;
+  recovery->minBackoffMs = minBackoffMs;
+  recovery->maxBackoffMs = maxBackoffMs;
+  recovery->state        = SHT85_RECOVERY_IDLE;
+  recovery->inRow        = 0;
+  recovery->resetAll     = false;
+  recovery->verify       = false;
+  recovery->recoveries   = 0;
+  recovery->attempts     = 0;
+  recovery->failures     = 0;
+  recovery->busErrors    = 0;
+  recovery->softResets   = 0;
+  recovery->generalCalls = 0;
+  recovery->maxInRow     = 0;
+}
+
+//------------------------------------------------------------------------------
+void SHT85_RecoveryStart(tSht85Recovery* recovery)
+{
+  uint32_t nowMs = System_GetTickMs(); // time of the error [ms]
+  uint32_t breakMs;                    // end of the break time [ms]
+  
+  recovery->recoveries++;
+  
+  if(recovery->stream) {
+    SHT85_StreamStop(recovery->stream);
+  }
+  
+  // a restarted stream without a sample counts as failed attempt, after a
+  // sample the sensor is considered healthy again
+  if(recovery->verify && recovery->stream->schedule.samples == 0) {
+    recovery->verify = false;
+    Backoff(recovery, nowMs);
+  } else {
+    recovery->verify   = false;
+    recovery->inRow    = 0;
+    recovery->resetAll = false;
+    recovery->state    = SHT85_RECOVERY_DUE;
+    recovery->stepMs   = nowMs;
+  }
+  
+  // the sensor accepts no command for 1ms after the break of the stream,
+  // one tick more as the step time is in whole ticks
+  breakMs = nowMs + SHT85_BREAK_MS + 1;
+  if(recovery->stream && (int32_t)(recovery->stepMs - breakMs) < 0) {
+    recovery->stepMs = breakMs;
+  }
+}
+
+//------------------------------------------------------------------------------
+bool SHT85_RecoveryActive(const tSht85Recovery* recovery)
+{
+  return recovery->state != SHT85_RECOVERY_IDLE;
+}
+
+//------------------------------------------------------------------------------
+uint32_t SHT85_RecoveryWaitMs(const tSht85Recovery* recovery, uint32_t nowMs)
+{
+  int32_t waitMs = (int32_t)(recovery->stepMs - nowMs); // wrap-around safe
+  
+  if(recovery->state == SHT85_RECOVERY_IDLE) {
+    return 0;
+  }
+  
+  return (waitMs > 0) ? (uint32_t)waitMs : 0;
+}
+
+//------------------------------------------------------------------------------
+etError SHT85_RecoveryStep(tSht85Recovery* recovery)
+{
+  uint32_t nowMs = System_GetTickMs(); // time of the step [ms]
+  etError  error = NO_ERROR;           // error code
+  
+  switch(recovery->state) {
+    case SHT85_RECOVERY_DUE:
+      recovery->attempts++;
+      
+      // a slave holding SDA low blocks every transfer on the bus
+      I2c_SelectBus(recovery->sensor->bus);
+      error = I2c_BusClear();
+      if(error != NO_ERROR) {
+        recovery->busErrors++;
+      } else {
+        error = ResetSensor(recovery);
+      }
+      
+      if(error == NO_ERROR) {
+        recovery->state  = SHT85_RECOVERY_RESET;
+        recovery->stepMs = nowMs + SHT85_RECOVERY_RESET_MS;
+      }
+      break;
+    
+    case SHT85_RECOVERY_RESET:
+      if(recovery->stream) {
+        error = SHT85_StreamStart(recovery->stream, recovery->measureMode);
+      } else {
+        error = SHT85_StartPeriodicMeasurment(recovery->sensor,
+                                              recovery->measureMode);
+      }
+      
+      // a stream is verified by its first sample, see SHT85_RecoveryStart()
+      if(error == NO_ERROR) {
+        recovery->state  = SHT85_RECOVERY_IDLE;
+        recovery->verify = (recovery->stream != 0);
+      }
+      break;
+    
+    default:
+      break;
+  }
+  
+  if(error != NO_ERROR) {
+    Backoff(recovery, nowMs);
+  }
+  
+  return error;
+}
+
+//------------------------------------------------------------------------------
+static etError ResetSensor(tSht85Recovery* recovery)
+{
+  etError error = ACK_ERROR; // error code
+  
+  // soft reset first, it resets the sensor only
+  if(recovery->inRow < SHT85_RECOVERY_ESCALATION || recovery->resetAll) {
+    error = SHT85_WriteCommand(recovery->sensor, CMD_SOFT_RESET);
+    if(error == NO_ERROR) {
+      recovery->softResets++;
+    }
+  }
+  
+  // the general call resets all sensors of the bus, once per recovery: if
+  // the sensor does not acknowledge or still fails after the soft resets
+  if(error == ACK_ERROR && !recovery->resetAll) {
+    recovery->resetAll = true;
+    recovery->generalCalls++;
+    error = I2c_GeneralCallReset();
+  }
+  
+  return error;
+}
+
+//------------------------------------------------------------------------------
+static void Backoff(tSht85Recovery* recovery, uint32_t nowMs)
+{
+  uint32_t backoffMs = recovery->minBackoffMs; // backoff time [ms]
+  uint8_t  i;                                  // doubling counter
+  
+  recovery->failures++;
+  if(recovery->inRow < 0xFF) {
+    recovery->inRow++;
+  }
+  if(recovery->inRow > recovery->maxInRow) {
+    recovery->maxInRow = recovery->inRow;
+  }
+  
+  // the backoff time doubles with each failed attempt in a row
+  for(i = 1; i < recovery->inRow && backoffMs < recovery->maxBackoffMs; i++) {
+    backoffMs *= 2;
+  }
+  if(backoffMs > recovery->maxBackoffMs) {
+    backoffMs = recovery->maxBackoffMs;
+  }
+  
+  recovery->state  = SHT85_RECOVERY_DUE;
+  recovery->stepMs = nowMs + backoffMs;
+}
@@ -0,0 +1,149 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  sht85_recovery.h
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  STM32F100RB
+// IDE       :  µVision V5.25.2.0
+// Compiler  :  Armcc
+// Brief     :  Error recovery of one sensor in the periodic measurement mode.
+//              After an error the recovery frees the bus (I2c_BusClear()),
+//              resets the sensor and starts the periodic measurement again.
+//              The first attempt is made at once and costs only the reset
+//              time of the sensor, so a glitch loses one or two samples.
+//              Each further attempt in a row waits twice as long as the one
+//              before, from a minimum up to a maximum backoff time, so a dead
+//              sensor costs only a few bus transfers per maximum backoff and
+//              does not starve the other sensors of the bus.
+//
+//              The attempts escalate: a soft reset of the sensor first, a
+//              general call reset if the sensor does not acknowledge it or
+//              still fails at the third attempt in a row. The general call
+//              resets all sensors of the bus, so it is sent once per recovery
+//              only; the health monitors (sht85_health.h) of the other
+//              sensors find their reset. A recovery counts as successful once
+//              the restarted stream has delivered a sample, an error before
+//              continues with the next backoff time.
+//
+//              The recovery does not wait itself, the application runs the
+//              steps when they are due:
+//
+//                SHT85_RecoveryStart(&recovery);
+//                while(SHT85_RecoveryActive(&recovery)) {
+//                  wait until SHT85_RecoveryWaitMs(&recovery, now) == 0
+//                  SHT85_RecoveryStep(&recovery);
+//                }
+//==============================================================================
+
+#ifndef SHT85_RECOVERY_H
+#define SHT85_RECOVERY_H
+
+#include "sht85.h"
+#include "sht85_stream.h"
+#include "system.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// Time the sensor needs after a soft or general call reset, max. 1.5ms [ms]
+#define SHT85_RECOVERY_RESET_MS     2
+
+// Failed attempts in a row after which the general call reset is used
+#define SHT85_RECOVERY_ESCALATION   2
+
+// Recovery states
+typedef enum {
+  SHT85_RECOVERY_IDLE,  // sensor measuring
+  SHT85_RECOVERY_DUE,   // next attempt due after the backoff time
+  SHT85_RECOVERY_RESET, // sensor reset, waiting for the reset time
+} etSht85RecoveryState;
+
+// Recovery of one sensor
+typedef struct {
+  tSht85*                sensor;       // recovered sensor
+  tSht85Stream*          stream;       // its stream, 0 = none
+  etPeriodicMeasureModes measureMode;  // periodic measurement mode
+  uint32_t               minBackoffMs; // backoff after the first attempt [ms]
+  uint32_t               maxBackoffMs; // max. backoff [ms]
+  etSht85RecoveryState   state;        // state
+  uint8_t                inRow;        // failed attempts in a row
+  bool                   resetAll;     // general call reset sent
+  bool                   verify;       // stream restarted, no sample yet
+  uint32_t               stepMs;       // system time of the next step [ms]
+  // statistics
+  uint32_t               recoveries;   // recoveries started
+  uint32_t               attempts;     // attempts, including the failed ones
+  uint32_t               failures;     // failed attempts
+  uint32_t               busErrors;    // bus clears with SDA or SCL still low
+  uint32_t               softResets;   // acknowledged soft resets
+  uint32_t               generalCalls; // general call resets
+  uint32_t               maxInRow;     // max. failed attempts in a row
+} tSht85Recovery;
+
+//==============================================================================
+// Initializes the recovery of a sensor.
+//------------------------------------------------------------------------------
+// input: recovery      recovery instance
+//        sensor        sensor instance
+//        stream        stream of the sensor, initialized, started again after
+//                      the reset; 0 to start the periodic measurement only,
+//                      e.g. for sensors read by SHT85_ReadMeasurementBuffers()
+//        measureMode   periodic measurement mode
+//        minBackoffMs  backoff time after the first failed attempt [ms]
+//        maxBackoffMs  max. backoff time [ms]
+//------------------------------------------------------------------------------
+void SHT85_RecoveryInit(tSht85Recovery* recovery, tSht85* sensor,
+                        tSht85Stream* stream,
+                        etPeriodicMeasureModes measureMode,
+                        uint32_t minBackoffMs, uint32_t maxBackoffMs);
+
+
+//==============================================================================
+// Starts a recovery after an error of the sensor and stops its stream. The
+// first attempt is due after the break time of the stop (SHT85_BREAK_MS),
+// unless the recovery before has not yet been successful (no sample since);
+// then the attempt waits for the backoff time.
+//------------------------------------------------------------------------------
+// input: recovery      recovery instance
+//------------------------------------------------------------------------------
+void SHT85_RecoveryStart(tSht85Recovery* recovery);
+
+
+//==============================================================================
+// Checks if a recovery is running. SHT85_RecoveryStep() has to be called until
+// the sensor measures again.
+//------------------------------------------------------------------------------
+// input: recovery      recovery instance
+//
+// return: true  = recovery running
+//         false = sensor measuring
+//------------------------------------------------------------------------------
+bool SHT85_RecoveryActive(const tSht85Recovery* recovery);
+
+
+//==============================================================================
+// Gets the time until the next step of the recovery is due.
+//------------------------------------------------------------------------------
+// input: recovery      recovery instance
+//        nowMs         system time [ms]
+//
+// return: time until the next step [ms], 0 if it is due
+//------------------------------------------------------------------------------
+uint32_t SHT85_RecoveryWaitMs(const tSht85Recovery* recovery, uint32_t nowMs);
+
+
+//==============================================================================
+// Runs the next step of the recovery: frees the bus and resets the sensor, or
+// starts the periodic measurement after the reset time. A failed step waits
+// for the next backoff time and starts over with the bus clear.
+//------------------------------------------------------------------------------
+// input: recovery      recovery instance
+//
+// return: error:       ACK_ERROR      = no acknowledgment from sensor
+//                      TIMEOUT_ERROR  = bus still stuck after the bus clear
+//                      NO_ERROR       = no error
+//------------------------------------------------------------------------------
+etError SHT85_RecoveryStep(tSht85Recovery* recovery);
+
+#endif
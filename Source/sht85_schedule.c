@@ -0,0 +1,93 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  sht85_schedule.c
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  STM32F100RB
+// IDE       :  µVision V5.25.2.0
+// Compiler  :  Armcc
+// Brief     :  Fetch scheduler for the periodic measurement mode.
+//==============================================================================
+
+#include "sht85_schedule.h"
+
+#define CREEP_DIVIDER  128 // creep = period / 128
+#define RETRY_DIVIDER   16 // retry interval = period / 16
+
+//------------------------------------------------------------------------------
+void SHT85_ScheduleInit(tSht85Schedule* schedule,
+                        etPeriodicMeasureModes measureMode, uint32_t nowMs)
+{
+  schedule->periodMs   = SHT85_GetPeriodMs(measureMode);
+  schedule->creepMs    = schedule->periodMs / CREEP_DIVIDER;
+  schedule->retryMs    = schedule->periodMs / RETRY_DIVIDER;
+  schedule->locked     = false;
+  schedule->dueMs      = nowMs + schedule->retryMs;
+  schedule->sampleMs   = nowMs;
+  schedule->fetches    = 0;
+  schedule->samples    = 0;
+  schedule->notReady   = 0;
+  schedule->missed     = 0;
+  schedule->duplicates = 0;
+  
+  // at least one system tick
+  if(schedule->creepMs == 0) schedule->creepMs = 1;
+  if(schedule->retryMs == 0) schedule->retryMs = 1;
+}
+
+//------------------------------------------------------------------------------
+void SHT85_ScheduleResume(tSht85Schedule* schedule, uint32_t dueMs)
+{
+  // the gap is not counted as missed samples, the sample before it is taken
+  // as one period earlier
+  schedule->locked   = true;
+  schedule->dueMs    = dueMs;
+  schedule->sampleMs = dueMs - schedule->periodMs;
+}
+
+//------------------------------------------------------------------------------
+uint32_t SHT85_ScheduleWaitMs(const tSht85Schedule* schedule, uint32_t nowMs)
+{
+  int32_t waitMs = (int32_t)(schedule->dueMs - nowMs); // wrap-around safe
+  
+  return (waitMs > 0) ? (uint32_t)waitMs : 0;
+}
+
+//------------------------------------------------------------------------------
+void SHT85_ScheduleUpdate(tSht85Schedule* schedule, etError error,
+                          uint32_t nowMs)
+{
+  uint32_t lateMs; // delay of the fetch after its due time [ms]
+  uint32_t slots;  // periods passed since the due time
+  
+  schedule->fetches++;
+  
+  if(error == NO_ERROR) {
+    if(!schedule->locked) {
+      // first sample: the phase of the sensor is known within a retry
+      schedule->locked = true;
+      schedule->dueMs  = nowMs;
+    } else if(nowMs - schedule->sampleMs < schedule->periodMs / 2) {
+      schedule->duplicates++;
+    }
+    
+    // the sensor keeps only the latest sample, a fetch later than one period
+    // has lost the samples in between
+    lateMs = nowMs - schedule->dueMs;
+    if((int32_t)lateMs < 0) lateMs = 0;
+    slots = lateMs / schedule->periodMs;
+    schedule->missed += slots;
+    
+    schedule->samples++;
+    schedule->sampleMs = nowMs;
+    schedule->dueMs   += (slots + 1) * schedule->periodMs - schedule->creepMs;
+  } else {
+    // no new data yet (or bus error): retry shortly after
+    if(error == ACK_ERROR) {
+      schedule->notReady++;
+    }
+    schedule->dueMs = nowMs + schedule->retryMs;
+  }
+}
@@ -0,0 +1,93 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  sht85_schedule.h
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  STM32F100RB
+// IDE       :  µVision V5.25.2.0
+// Compiler  :  Armcc
+// Brief     :  Fetch scheduler for the periodic measurement mode. It locks to
+//              the phase of the sensor with the first successful fetch and
+//              addresses the sensor only when a new sample is due.
+//
+//              The due times are derived from the previous due time, not from
+//              the time the fetch was actually done, so loop jitter does not
+//              accumulate. Each period is shortened by a small creep, which
+//              moves the fetch towards the end of the sensor's conversion. A
+//              fetch that comes too early is NACKed by the sensor and retried
+//              shortly after, which locks the phase again. So the scheduler
+//              follows a sensor clock that is slower or faster than the
+//              controller clock by up to the creep (1/128 of the period).
+//==============================================================================
+
+#ifndef SHT85_SCHEDULE_H
+#define SHT85_SCHEDULE_H
+
+#include "sht85.h"
+#include "system.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// Fetch schedule of one sensor
+typedef struct {
+  uint16_t periodMs;   // nominal measurement period [ms]
+  uint16_t creepMs;    // period shortening per sample [ms]
+  uint16_t retryMs;    // retry interval after a NACK [ms]
+  bool     locked;     // phase locked to the sensor
+  uint32_t dueMs;      // system time of the next fetch [ms]
+  uint32_t sampleMs;   // system time of the last successful fetch [ms]
+  // statistics
+  uint32_t fetches;    // fetch attempts (bus transactions)
+  uint32_t samples;    // successful fetches
+  uint32_t notReady;   // fetches without new data (NACK)
+  uint32_t missed;     // samples overwritten in the sensor before fetched
+  uint32_t duplicates; // samples within half a period (lock lost)
+} tSht85Schedule;
+
+//==============================================================================
+// Initializes the schedule after the periodic measurement has been started.
+// Until the first successful fetch the sensor is polled every retry interval.
+//------------------------------------------------------------------------------
+// input: schedule      schedule instance
+//        measureMode   periodic measurement mode
+//        nowMs         system time [ms]
+//------------------------------------------------------------------------------
+void SHT85_ScheduleInit(tSht85Schedule* schedule,
+                        etPeriodicMeasureModes measureMode, uint32_t nowMs);
+
+
+//==============================================================================
+// Resumes the schedule after the periodic measurement has been stopped and
+// started again with the same mode, timed so that its samples are due at the
+// previous phase. The schedule stays locked, the statistics are kept.
+//------------------------------------------------------------------------------
+// input: schedule      schedule instance
+//        dueMs         system time of the first sample after the restart [ms]
+//------------------------------------------------------------------------------
+void SHT85_ScheduleResume(tSht85Schedule* schedule, uint32_t dueMs);
+
+
+//==============================================================================
+// Gets the time until the next fetch is due.
+//------------------------------------------------------------------------------
+// input: schedule      schedule instance
+//        nowMs         system time [ms]
+//
+// return: time until the next fetch [ms], 0 if it is due
+//------------------------------------------------------------------------------
+uint32_t SHT85_ScheduleWaitMs(const tSht85Schedule* schedule, uint32_t nowMs);
+
+
+//==============================================================================
+// Updates the schedule with the result of a fetch done when it was due.
+//------------------------------------------------------------------------------
+// input: schedule      schedule instance
+//        error         result of the fetch, ACK_ERROR = no new data
+//        nowMs         system time of the fetch [ms]
+//------------------------------------------------------------------------------
+void SHT85_ScheduleUpdate(tSht85Schedule* schedule, etError error,
+                          uint32_t nowMs);
+
+#endif
@@ -0,0 +1,190 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  sht85_stream.c
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  STM32F100RB
+// IDE       :  µVision V5.25.2.0
+// Compiler  :  Armcc
+// Brief     :  Sample stream for the periodic measurement mode.
+//==============================================================================
+
+#include "sht85_stream.h"
+
+#define STREAM_INDEX_MASK  (SHT85_STREAM_SIZE - 1)
+
+static tSht85Stream* activeStream; // stream served by the timer interrupt
+
+static void ReportError(tSht85Stream* stream, etError error);
+static void TimerHandler(void);
+
+//------------------------------------------------------------------------------
+void SHT85_StreamInit(tSht85Stream* stream, tSht85* sensor)
+{
+  stream->sensor    = sensor;
+  stream->head      = 0;
+  stream->tail      = 0;
+  stream->overruns  = 0;
+  stream->errors    = 0;
+  stream->lastError = NO_ERROR;
+  stream->reported  = 0;
+  
+  SHT85_HealthInit(&stream->health, 0);
+}
+
+//------------------------------------------------------------------------------
+etError SHT85_StreamStart(tSht85Stream* stream,
+                          etPeriodicMeasureModes measureMode)
+{
+  etError error; // error code
+  
+  error = SHT85_HealthStart(&stream->health, stream->sensor);
+  if(error == NO_ERROR) {
+    error = SHT85_StartPeriodicMeasurment(stream->sensor, measureMode);
+  }
+  
+  // the scheduler locks to the sensor with the first fetches
+  if(error == NO_ERROR) {
+    SHT85_ScheduleInit(&stream->schedule, measureMode, System_GetTickMs());
+    activeStream = stream;
+    System_StartTimer(stream->schedule.retryMs, TimerHandler);
+  }
+  
+  return error;
+}
+
+//------------------------------------------------------------------------------
+etError SHT85_StreamResume(tSht85Stream* stream,
+                           etPeriodicMeasureModes measureMode, uint32_t dueMs)
+{
+  etError  error;  // error code
+  uint32_t waitMs; // time until the first fetch [ms]
+  
+  error = SHT85_HealthStart(&stream->health, stream->sensor);
+  if(error == NO_ERROR) {
+    error = SHT85_StartPeriodicMeasurment(stream->sensor, measureMode);
+  }
+  
+  // the scheduler stays locked, the first fetch is at the old phase
+  if(error == NO_ERROR) {
+    SHT85_ScheduleResume(&stream->schedule, dueMs);
+    waitMs = SHT85_ScheduleWaitMs(&stream->schedule, System_GetTickMs());
+    activeStream = stream;
+    System_StartTimer((waitMs > 0) ? (uint16_t)waitMs : 1, TimerHandler);
+  }
+  
+  return error;
+}
+
+//------------------------------------------------------------------------------
+etError SHT85_StreamStop(tSht85Stream* stream)
+{
+  System_StopTimer();
+  activeStream = 0;
+  
+  return SHT85_StopPeriodicMeasurment(stream->sensor);
+}
+
+//------------------------------------------------------------------------------
+void SHT85_StreamFetch(tSht85Stream* stream)
+{
+  etError      error;               // error code
+  uint8_t      head = stream->head; // local copy, only written here
+  tSht85Sample sample;              // fetched sample
+  
+  error = SHT85_ReadMeasurementBufferRaw(stream->sensor, &sample.rawTemp,
+                                         &sample.rawHumi);
+  sample.timeMs = System_GetTickMs();
+  
+  SHT85_ScheduleUpdate(&stream->schedule, error, sample.timeMs);
+  
+  if(error == NO_ERROR) {
+    if((uint8_t)(head - stream->tail) < SHT85_STREAM_SIZE) {
+      stream->samples[head & STREAM_INDEX_MASK] = sample;
+      // the sample must be complete in memory before it is published
+      __DMB();
+      stream->head = head + 1;
+    } else {
+      // ring buffer full, the sample is lost
+      stream->overruns++;
+    }
+  } else if(error != ACK_ERROR) {
+    // a NACK only means no new data yet, counted by the schedule
+    ReportError(stream, error);
+  }
+  
+  // a reset sensor NACKs every fetch, only the status reveals it
+  error = SHT85_HealthUpdate(&stream->health, stream->sensor);
+  if(error != NO_ERROR) {
+    ReportError(stream, error);
+  }
+}
+
+//------------------------------------------------------------------------------
+etError SHT85_StreamRead(tSht85Stream* stream, tSht85Sample samples[],
+                         uint8_t maxSamples, uint8_t* nbrOfSamples)
+{
+  etError  error  = NO_ERROR;       // error code
+  uint8_t  tail   = stream->tail;   // local copy, only written here
+  uint8_t  count;                   // samples in the ring buffer
+  uint8_t  i;                       // sample index
+  uint32_t errors = stream->errors; // snapshot of the fetch error counter
+  
+  count = (uint8_t)(stream->head - tail);
+  // the samples must not be read before the head index
+  __DMB();
+  
+  if(count > maxSamples) {
+    count = maxSamples;
+  }
+  
+  for(i = 0; i < count; i++) {
+    samples[i] = stream->samples[(uint8_t)(tail + i) & STREAM_INDEX_MASK];
+  }
+  
+  // release the read samples to the producer
+  __DMB();
+  stream->tail = tail + count;
+  *nbrOfSamples = count;
+  
+  if(errors != stream->reported) {
+    stream->reported = errors;
+    error = stream->lastError;
+  }
+  
+  return error;
+}
+
+//------------------------------------------------------------------------------
+bool SHT85_StreamPending(const tSht85Stream* stream)
+{
+  return stream->head != stream->tail || stream->errors != stream->reported;
+}
+
+//------------------------------------------------------------------------------
+static void ReportError(tSht85Stream* stream, etError error)
+{
+  // the error must be in memory before the counter tells the consumer
+  stream->lastError = error;
+  __DMB();
+  stream->errors++;
+}
+
+//------------------------------------------------------------------------------
+static void TimerHandler(void)
+{
+  uint32_t nowMs = System_GetTickMs(); // time of this interrupt [ms]
+  uint32_t waitMs;                     // time until the next fetch [ms]
+  
+  if(activeStream) {
+    if(SHT85_ScheduleWaitMs(&activeStream->schedule, nowMs) == 0) {
+      SHT85_StreamFetch(activeStream);
+    }
+    
+    // the next period starts with this interrupt, not after the fetch
+    waitMs = SHT85_ScheduleWaitMs(&activeStream->schedule, nowMs);
+    System_SetTimerPeriod((waitMs > 0) ? (uint16_t)waitMs : 1);
+  }
+}
@@ -0,0 +1,149 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  sht85_stream.h
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  STM32F100RB
+// IDE       :  µVision V5.25.2.0
+// Compiler  :  Armcc
+// Brief     :  Sample stream for the periodic measurement mode: a timer
+//              interrupt fetches every sample into a lock-free single-producer
+//              single-consumer ring buffer, the application drains it in
+//              batches. The fetches are timed by the fetch scheduler, the
+//              timer is reprogrammed for the next due fetch. The optional
+//              health monitor reads the status register every few fetches,
+//              an unexpected sensor reset is reported as RESET_ERROR.
+//==============================================================================
+
+#ifndef SHT85_STREAM_H
+#define SHT85_STREAM_H
+
+#include "sht85.h"
+#include "sht85_schedule.h"
+#include "sht85_health.h"
+#include "system.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// ring buffer size [samples], power of two, max. 128
+#define SHT85_STREAM_SIZE  32
+
+// Timestamped raw sample
+typedef struct {
+  uint32_t timeMs;  // system time of the fetch [ms]
+  uint16_t rawTemp; // raw temperature
+  uint16_t rawHumi; // raw relative humidity
+} tSht85Sample;
+
+// Sample stream of one sensor
+typedef struct {
+  tSht85*           sensor;     // streamed sensor
+  // written by the producer (timer interrupt) only
+  tSht85Schedule    schedule;   // fetch schedule, see its statistics
+  tSht85Health      health;     // status monitor, off after StreamInit()
+  volatile uint8_t  head;       // index of the next sample to write
+  volatile uint32_t overruns;   // samples lost, ring buffer was full
+  volatile uint32_t errors;     // failed fetches (checksum, timeout)
+  volatile etError  lastError;  // error of the last failed fetch
+  // written by the consumer only
+  volatile uint8_t  tail;       // index of the next sample to read
+  uint32_t          reported;   // errors already reported to the consumer
+  tSht85Sample      samples[SHT85_STREAM_SIZE]; // ring buffer
+} tSht85Stream;
+
+//==============================================================================
+// Initializes a sample stream. The health monitor is off, it can be switched
+// on with SHT85_HealthInit(&stream->health, interval) before the start.
+//------------------------------------------------------------------------------
+// input: stream        stream instance
+//        sensor        streamed sensor
+//------------------------------------------------------------------------------
+void SHT85_StreamInit(tSht85Stream* stream, tSht85* sensor);
+
+
+//==============================================================================
+// Starts the periodic measurement and the timer interrupt which fetches the
+// samples when they are due. Only one stream can run at a time, the bus
+// must not be used by the application while the stream is running.
+//------------------------------------------------------------------------------
+// input: stream        stream instance
+//        measureMode   periodic measurement mode, up to PERI_MEAS_HIGH_10_HZ
+//
+// return: error:       ACK_ERROR      = no acknowledgment from sensor
+//                      NO_ERROR       = no error
+//------------------------------------------------------------------------------
+etError SHT85_StreamStart(tSht85Stream* stream,
+                          etPeriodicMeasureModes measureMode);
+
+
+//==============================================================================
+// Starts the periodic measurement of a stopped stream again, in the phase it
+// had before: the first sample is due at the given time, a whole number of
+// periods after the samples before the stop. The measurement has to be
+// started one conversion time before, see SHT85_GetMeasDurationMs().
+// The buffered samples and the statistics are kept.
+//------------------------------------------------------------------------------
+// input: stream        stream instance
+//        measureMode   periodic measurement mode, as before the stop
+//        dueMs         system time of the first sample [ms]
+//
+// return: error:       ACK_ERROR      = no acknowledgment from sensor
+//                      NO_ERROR       = no error
+//------------------------------------------------------------------------------
+etError SHT85_StreamResume(tSht85Stream* stream,
+                           etPeriodicMeasureModes measureMode, uint32_t dueMs);
+
+
+//==============================================================================
+// Stops the timer interrupt and the periodic measurement. Samples in the ring
+// buffer can still be read.
+//------------------------------------------------------------------------------
+// input: stream        stream instance
+//
+// return: error:       ACK_ERROR      = no acknowledgment from sensor
+//                      NO_ERROR       = no error
+//------------------------------------------------------------------------------
+etError SHT85_StreamStop(tSht85Stream* stream);
+
+
+//==============================================================================
+// Fetches one sample into the ring buffer (producer) and updates the
+// schedule. Called by the timer interrupt of the running stream when a fetch
+// is due.
+//------------------------------------------------------------------------------
+// input: stream        stream instance
+//------------------------------------------------------------------------------
+void SHT85_StreamFetch(tSht85Stream* stream);
+
+
+//==============================================================================
+// Reads the buffered samples (consumer), oldest first.
+//------------------------------------------------------------------------------
+// input: stream        stream instance
+//        samples       buffer for the samples
+//        maxSamples    size of the buffer
+//        nbrOfSamples  pointer to number of read samples
+//
+// return: error:       error of the last failed fetch since the previous
+//                      call: CHECKSUM_ERROR, TIMEOUT_ERROR, ...
+//                      RESET_ERROR    = sensor reset, see stream->health
+//                      NO_ERROR       = no failed fetch
+// remark: fetches without new data are not an error, see schedule.notReady
+//------------------------------------------------------------------------------
+etError SHT85_StreamRead(tSht85Stream* stream, tSht85Sample samples[],
+                         uint8_t maxSamples, uint8_t* nbrOfSamples);
+
+
+//==============================================================================
+// Checks if there is something to read: buffered samples or a failed fetch.
+//------------------------------------------------------------------------------
+// input: stream        stream instance
+//
+// return: true  = SHT85_StreamRead() returns samples or an error
+//         false = nothing new since the last read
+//------------------------------------------------------------------------------
+bool SHT85_StreamPending(const tSht85Stream* stream);
+
+#endif
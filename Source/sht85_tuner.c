@@ -0,0 +1,243 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  sht85_tuner.c
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  STM32F100RB
+// IDE       :  µVision V5.25.2.0
+// Compiler  :  Armcc
+// Brief     :  Repeatability tuner.
+//==============================================================================
+
+#include "sht85_tuner.h"
+
+#define SCALE 16 // fixed point scale of the averages
+
+// lag of the slow behind the fast average on a ramp [samples]
+#define LAG ((1 << SHT85_TUNER_SLOW_SHIFT) - (1 << SHT85_TUNER_FAST_SHIFT))
+
+// Single shot modes by level
+static const etSingleMeasureModes singleModes[] = {
+  SINGLE_MEAS_LOW, SINGLE_MEAS_MEDIUM, SINGLE_MEAS_HIGH
+};
+
+// Periodic measurement modes by rate, columns by level
+static const etPeriodicMeasureModes periodicModes[][3] = {
+  {PERI_MEAS_LOW_05_HZ, PERI_MEAS_MEDIUM_05_HZ, PERI_MEAS_HIGH_05_HZ},
+  {PERI_MEAS_LOW_1_HZ,  PERI_MEAS_MEDIUM_1_HZ,  PERI_MEAS_HIGH_1_HZ },
+  {PERI_MEAS_LOW_2_HZ,  PERI_MEAS_MEDIUM_2_HZ,  PERI_MEAS_HIGH_2_HZ },
+  {PERI_MEAS_LOW_4_HZ,  PERI_MEAS_MEDIUM_4_HZ,  PERI_MEAS_HIGH_4_HZ },
+  {PERI_MEAS_LOW_10_HZ, PERI_MEAS_MEDIUM_10_HZ, PERI_MEAS_HIGH_10_HZ},
+};
+
+#define NBR_OF_PERIODIC_MODES (sizeof(periodicModes) / sizeof(periodicModes[0]))
+
+// Classification of a quantity after a sample
+typedef enum {
+  QUANTITY_QUIET,  // stable, a lower repeatability is sufficient
+  QUANTITY_NORMAL, // within the limits
+  QUANTITY_BUSY,   // moving or noisy, a higher repeatability is needed
+  QUANTITY_ALARM,  // near an alarm threshold, high repeatability is needed
+} etQuantityClass;
+
+static void            InitQuantity(tSht85TunerQuantity* quantity,
+                                    uint16_t noiseRaw, uint16_t rateRaw);
+static etQuantityClass UpdateQuantity(tSht85TunerQuantity* quantity,
+                                      uint16_t raw, bool judgeNoise);
+static int32_t         Average(int32_t average, int32_t value, uint8_t shift);
+
+//------------------------------------------------------------------------------
+void SHT85_TunerInit(tSht85Tuner* tuner, uint16_t noiseTempRaw,
+                     uint16_t noiseHumiRaw, uint16_t rateTempRaw,
+                     uint16_t rateHumiRaw, uint16_t holdSamples)
+{
+  InitQuantity(&tuner->temp, noiseTempRaw, rateTempRaw);
+  InitQuantity(&tuner->humi, noiseHumiRaw, rateHumiRaw);
+  tuner->holdSamples = holdSamples;
+  tuner->level       = SHT85_TUNER_HIGH;
+  tuner->quiet       = 0;
+  tuner->settle      = SHT85_TUNER_SETTLE_SAMPLES;
+  tuner->samples[SHT85_TUNER_LOW]    = 0;
+  tuner->samples[SHT85_TUNER_MEDIUM] = 0;
+  tuner->samples[SHT85_TUNER_HIGH]   = 0;
+  tuner->changes     = 0;
+}
+
+//------------------------------------------------------------------------------
+bool SHT85_TunerAddThreshold(tSht85Tuner* tuner, bool humidity,
+                             uint16_t thresholdRaw, uint16_t guardRaw)
+{
+  tSht85TunerQuantity* quantity = humidity ? &tuner->humi : &tuner->temp;
+  
+  if(quantity->nbrOfThresholds >= SHT85_TUNER_MAX_THRESHOLDS) {
+    return false;
+  }
+  
+  quantity->thresholdRaw[quantity->nbrOfThresholds] = thresholdRaw;
+  quantity->guardRaw[quantity->nbrOfThresholds]     = guardRaw;
+  quantity->nbrOfThresholds++;
+  
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool SHT85_TunerUpdate(tSht85Tuner* tuner, uint16_t rawTemp, uint16_t rawHumi)
+{
+  etSht85TunerLevel level = tuner->level; // new repeatability
+  bool              judgeNoise;           // noise of this level measured
+  etQuantityClass   temp;                 // class of the temperature
+  etQuantityClass   humi;                 // class of the humidity
+  etQuantityClass   worst;                // higher class of both
+  
+  tuner->samples[tuner->level]++;
+  
+  judgeNoise = (tuner->settle == 0);
+  if(tuner->settle > 0) {
+    tuner->settle--;
+  }
+  
+  temp  = UpdateQuantity(&tuner->temp, rawTemp, judgeNoise);
+  humi  = UpdateQuantity(&tuner->humi, rawHumi, judgeNoise);
+  worst = (temp > humi) ? temp : humi;
+  
+  switch(worst) {
+    case QUANTITY_ALARM:
+      // decision near a threshold on the least noisy values
+      level        = SHT85_TUNER_HIGH;
+      tuner->quiet = 0;
+      break;
+    
+    case QUANTITY_BUSY:
+      // one level up per sample
+      if(level < SHT85_TUNER_HIGH) {
+        level++;
+      }
+      tuner->quiet = 0;
+      break;
+    
+    case QUANTITY_QUIET:
+      // one level down after holdSamples quiet samples in a row
+      if(++tuner->quiet >= tuner->holdSamples && level > SHT85_TUNER_LOW) {
+        level--;
+      }
+      break;
+    
+    default:
+      tuner->quiet = 0;
+      break;
+  }
+  
+  if(level == tuner->level) {
+    return false;
+  }
+  
+  tuner->level  = level;
+  tuner->quiet  = 0;
+  tuner->settle = SHT85_TUNER_SETTLE_SAMPLES;
+  tuner->changes++;
+  
+  return true;
+}
+
+//------------------------------------------------------------------------------
+etSingleMeasureModes SHT85_TunerSingleMode(const tSht85Tuner* tuner)
+{
+  return singleModes[tuner->level];
+}
+
+//------------------------------------------------------------------------------
+etPeriodicMeasureModes SHT85_TunerPeriodicMode(const tSht85Tuner* tuner,
+                                            etPeriodicMeasureModes measureMode)
+{
+  uint8_t i; // table index
+  uint8_t j; // level
+  
+  for(i = 0; i < NBR_OF_PERIODIC_MODES; i++) {
+    for(j = 0; j < 3; j++) {
+      if(periodicModes[i][j] == measureMode) {
+        return periodicModes[i][tuner->level];
+      }
+    }
+  }
+  
+  // unknown mode (ART) is kept
+  return measureMode;
+}
+
+//------------------------------------------------------------------------------
+static void InitQuantity(tSht85TunerQuantity* quantity,
+                         uint16_t noiseRaw, uint16_t rateRaw)
+{
+  quantity->noiseRaw        = noiseRaw;
+  quantity->rateRaw         = rateRaw;
+  quantity->nbrOfThresholds = 0;
+  quantity->count           = 0;
+  quantity->fast            = 0;
+  quantity->slow            = 0;
+  quantity->noise           = 0;
+}
+
+//------------------------------------------------------------------------------
+static etQuantityClass UpdateQuantity(tSht85TunerQuantity* quantity,
+                                      uint16_t raw, bool judgeNoise)
+{
+  int32_t  noiseLimit = (int32_t)quantity->noiseRaw * SCALE; // [raw/16]
+  int32_t  rateLimit  = (int32_t)quantity->rateRaw * SCALE * LAG;
+  int32_t  value      = (int32_t)raw * SCALE; // sample [raw/16]
+  int32_t  diff2;    // absolute second difference [raw]
+  int32_t  rate;     // absolute rate times LAG [raw/16]
+  uint32_t distance; // distance to a threshold [raw]
+  uint8_t  i;        // threshold index
+  
+  // rate: difference of the averages, in the unit of rateLimit; noise:
+  // average of the absolute second difference, which is about 2 standard
+  // deviations of white noise and zero for a linear change
+  if(quantity->count == 0) {
+    quantity->fast = value;
+    quantity->slow = value;
+  }
+  quantity->fast = Average(quantity->fast, value, SHT85_TUNER_FAST_SHIFT);
+  quantity->slow = Average(quantity->slow, value, SHT85_TUNER_SLOW_SHIFT);
+  if(quantity->count >= 2) {
+    diff2 = (int32_t)raw - 2 * (int32_t)quantity->last[0] + quantity->last[1];
+    diff2 = (diff2 < 0) ? -diff2 : diff2;
+    quantity->noise = Average(quantity->noise, diff2 * SCALE,
+                              SHT85_TUNER_SLOW_SHIFT);
+  }
+  quantity->last[1] = quantity->last[0];
+  quantity->last[0] = raw;
+  if(quantity->count < 2) {
+    quantity->count++;
+    return QUANTITY_NORMAL;
+  }
+  
+  for(i = 0; i < quantity->nbrOfThresholds; i++) {
+    distance = (raw > quantity->thresholdRaw[i])
+             ? (uint32_t)(raw - quantity->thresholdRaw[i])
+             : (uint32_t)(quantity->thresholdRaw[i] - raw);
+    if(distance <= quantity->guardRaw[i]) {
+      return QUANTITY_ALARM;
+    }
+  }
+  
+  rate = quantity->fast - quantity->slow;
+  rate = (rate < 0) ? -rate : rate;
+  
+  if(rate > rateLimit || (judgeNoise && quantity->noise > 2 * noiseLimit)) {
+    return QUANTITY_BUSY;
+  }
+  if(rate <= rateLimit / 2 && (!judgeNoise || quantity->noise <= noiseLimit)) {
+    return QUANTITY_QUIET;
+  }
+  
+  return QUANTITY_NORMAL;
+}
+
+//------------------------------------------------------------------------------
+static int32_t Average(int32_t average, int32_t value, uint8_t shift)
+{
+  // exponential average, weight of the value 1/2^shift
+  return average + (value - average) / (1 << shift);
+}
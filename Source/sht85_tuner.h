@@ -0,0 +1,154 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  sht85_tuner.h
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  STM32F100RB
+// IDE       :  µVision V5.25.2.0
+// Compiler  :  Armcc
+// Brief     :  Repeatability tuner. A high repeatability measurement takes
+//              about 3x longer than a low one (12.5ms / 4.5ms / 2.5ms) and
+//              the sensor draws its measurement current during this time.
+//              The tuner watches the samples and chooses the lowest
+//              repeatability that gives the required accuracy:
+//
+//              - noise: the mean absolute second difference of the samples,
+//                which a linear change does not contribute to, is about two
+//                standard deviations of the noise. Above the allowed noise
+//                the repeatability steps up.
+//              - rate of change: a fast and a slow average of the values lag
+//                behind a ramp by 3 and 15 samples, their difference is 12
+//                times the rate with little noise. Above the rate limit the
+//                repeatability steps up.
+//              - thresholds: within the guard band of an alarm threshold the
+//                repeatability is high, the decision is made on the least
+//                noisy values.
+//
+//              The repeatability steps down one level after a number of
+//              samples with half the noise and rate limit. After a change the
+//              noise of the previous repeatability is not judged for
+//              SHT85_TUNER_SETTLE_SAMPLES samples. Call SHT85_TunerUpdate()
+//              for every sample; when it returns true, the measurement has to
+//              be started in the mode of SHT85_TunerSingleMode() or
+//              SHT85_TunerPeriodicMode().
+//==============================================================================
+
+#ifndef SHT85_TUNER_H
+#define SHT85_TUNER_H
+
+#include "sht85.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SHT85_TUNER_MAX_THRESHOLDS  4 // alarm thresholds per quantity
+#define SHT85_TUNER_SETTLE_SAMPLES 16 // samples after a change
+#define SHT85_TUNER_FAST_SHIFT      2 // weight of a sample: 1/2^n, fast average
+#define SHT85_TUNER_SLOW_SHIFT      4 // weight of a sample, slow average
+
+// Repeatability levels in ascending order
+typedef enum {
+  SHT85_TUNER_LOW,
+  SHT85_TUNER_MEDIUM,
+  SHT85_TUNER_HIGH,
+} etSht85TunerLevel;
+
+// Estimator of one quantity, raw values
+typedef struct {
+  uint16_t noiseRaw;                              // allowed noise [raw]
+  uint16_t rateRaw;                               // rate limit [raw/sample]
+  uint16_t thresholdRaw[SHT85_TUNER_MAX_THRESHOLDS]; // alarm thresholds
+  uint16_t guardRaw[SHT85_TUNER_MAX_THRESHOLDS];  // guard band of each
+  uint8_t  nbrOfThresholds;                       // number of thresholds
+  uint16_t last[2];     // last and second last sample
+  uint8_t  count;       // samples in last[], max. 2
+  int32_t  fast;        // fast average of the values [raw/16]
+  int32_t  slow;        // slow average of the values [raw/16]
+  int32_t  noise;       // average absolute second difference [raw/16]
+} tSht85TunerQuantity;
+
+// Repeatability tuner of one sensor
+typedef struct {
+  tSht85TunerQuantity temp;        // temperature
+  tSht85TunerQuantity humi;        // relative humidity
+  uint16_t            holdSamples; // quiet samples before stepping down
+  etSht85TunerLevel   level;       // repeatability
+  uint16_t            quiet;       // quiet samples in a row
+  uint8_t             settle;      // samples until the noise is judged
+  // statistics
+  uint32_t            samples[3];  // samples per level
+  uint32_t            changes;     // repeatability changes
+} tSht85Tuner;
+
+//==============================================================================
+// Initializes the tuner with high repeatability.
+//------------------------------------------------------------------------------
+// input: tuner         tuner instance
+//        noiseTempRaw  allowed temperature noise (standard deviation) [raw],
+//                      e.g. SHT85_TEMPERATURE_DIFF_TO_RAW(0.1)
+//        noiseHumiRaw  allowed humidity noise [raw], e.g.
+//                      SHT85_HUMIDITY_TO_RAW(0.1)
+//        rateTempRaw   temperature change per sample that needs a higher
+//                      repeatability [raw]
+//        rateHumiRaw   humidity change per sample that needs a higher
+//                      repeatability [raw]
+//        holdSamples   quiet samples before stepping down one level
+//------------------------------------------------------------------------------
+void SHT85_TunerInit(tSht85Tuner* tuner, uint16_t noiseTempRaw,
+                     uint16_t noiseHumiRaw, uint16_t rateTempRaw,
+                     uint16_t rateHumiRaw, uint16_t holdSamples);
+
+
+//==============================================================================
+// Adds an alarm threshold, the repeatability is high within its guard band.
+//------------------------------------------------------------------------------
+// input: tuner         tuner instance
+//        humidity      true = humidity threshold, false = temperature
+//        thresholdRaw  raw threshold, e.g. SHT85_HUMIDITY_TO_RAW(70)
+//        guardRaw      half width of the guard band [raw]
+//
+// return: true  = threshold added
+//         false = SHT85_TUNER_MAX_THRESHOLDS reached
+//------------------------------------------------------------------------------
+bool SHT85_TunerAddThreshold(tSht85Tuner* tuner, bool humidity,
+                             uint16_t thresholdRaw, uint16_t guardRaw);
+
+
+//==============================================================================
+// Updates the estimates with a sample and chooses the repeatability.
+//------------------------------------------------------------------------------
+// input: tuner         tuner instance
+//        rawTemp       raw temperature of the sample
+//        rawHumi       raw humidity of the sample
+//
+// return: true  = repeatability changed, the measurement has to be started
+//                 in the new mode
+//         false = no change
+//------------------------------------------------------------------------------
+bool SHT85_TunerUpdate(tSht85Tuner* tuner, uint16_t rawTemp, uint16_t rawHumi);
+
+
+//==============================================================================
+// Gets the single shot mode of the chosen repeatability.
+//------------------------------------------------------------------------------
+// input: tuner         tuner instance
+//
+// return: single shot measurement mode
+//------------------------------------------------------------------------------
+etSingleMeasureModes SHT85_TunerSingleMode(const tSht85Tuner* tuner);
+
+
+//==============================================================================
+// Gets the periodic mode of the chosen repeatability.
+//------------------------------------------------------------------------------
+// input: tuner         tuner instance
+//        measureMode   periodic mode with the measurement rate, any
+//                      repeatability
+//
+// return: periodic measurement mode with the same rate
+//------------------------------------------------------------------------------
+etPeriodicMeasureModes SHT85_TunerPeriodicMode(const tSht85Tuner* tuner,
+                                            etPeriodicMeasureModes measureMode);
+
+#endif
@@ -1,32 +1,262 @@
-//==============================================================================
-// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
-//==============================================================================
-// Project   :  SHT85 Sample Code
-// File      :  system.c
-// Author    :  RFU
-// Date      :  17-Mai-2018
-// Controller:  STM32F100RB
-// IDE       :  Vision V5.25.2.0
-// Compiler  :  Armcc
-// Brief     :  System functions
-//==============================================================================
-
-#include "system.h"
-
-//------------------------------------------------------------------------------
-void System_Init(void) 
-{
-  // no initialization required
-}
-
-//------------------------------------------------------------------------------
-void System_DelayUs(uint32_t nbrOfUs)   /* -- adapt this delay for your uC -- */
-{
-  uint32_t i;
-  for(i = 0; i < nbrOfUs; i++) {  
-    __nop();  // nop's may be added or removed for timing adjustment
-    __nop();
-    __nop();
-    __nop();
-  }
-}
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  system.c
+// Author    :  RFU
+// Date      :  17-Mai-2018
+// Controller:  STM32F100RB
+// IDE       :  µVision V5.25.2.0
+// Compiler  :  Armcc
+// Brief     :  System functions
+//==============================================================================
+
+#include "system.h"
+
+#define SYSTICK_LOAD_1MS  (SYSTEM_CORE_CLOCK_HZ / 1000 - 1) // cycles per ms
+
+// TIM2 tick: 0.5ms
+#define TIMER_PRESCALER   (SYSTEM_CYCLES_PER_US * SYSTEM_TIMER_TICK_US - 1)
+
+#define LSE_HZ            32768 // low-speed external crystal
+#define RTC_TICK_HZ       1024  // RTC counter frequency, wake-up resolution
+
+static volatile uint32_t   tickMs;       // system time [ms]
+static tSystemTimerHandler timerHandler; // periodic timer handler
+static tSystemUartHandler  uartHandler;  // UART transmission handler
+
+static uint32_t RtcCounter(void);
+static void     RtcSetAlarm(uint32_t alarm);
+
+//------------------------------------------------------------------------------
+void System_Init(void) 
+{
+  // SysTick: 1ms interrupt from core clock
+  SysTick->LOAD = SYSTICK_LOAD_1MS;
+  SysTick->VAL  = 0;
+  SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk |
+                  SysTick_CTRL_ENABLE_Msk;
+  
+  // DWT cycle counter for the delay functions
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT       = 0;
+  DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+//------------------------------------------------------------------------------
+void SysTick_Handler(void)
+{
+  tickMs++;
+}
+
+//------------------------------------------------------------------------------
+uint32_t System_GetTickMs(void)
+{
+  return tickMs;
+}
+
+//------------------------------------------------------------------------------
+/* -- adapt this code for your platform -- */
+void System_StartTimer(uint16_t periodMs, tSystemTimerHandler handler)
+{
+  timerHandler = handler;
+  
+  // TIM2 on APB1 (8MHz): 0.5ms tick, update interrupt every period
+  RCC->APB1ENR |= RCC_APB1ENR_TIM2EN;
+  TIM2->CR1     = 0;
+  TIM2->PSC     = TIMER_PRESCALER;
+  TIM2->ARR     = SYSTEM_TIMER_RELOAD(periodMs);
+  TIM2->EGR     = TIM_EGR_UG;   // load prescaler, restart counter
+  TIM2->SR      = 0;            // clear update flag set by UG
+  TIM2->DIER    = TIM_DIER_UIE;
+  NVIC_EnableIRQ(TIM2_IRQn);
+  TIM2->CR1     = TIM_CR1_CEN;
+}
+
+//------------------------------------------------------------------------------
+void System_SetTimerPeriod(uint16_t periodMs)
+{
+  uint16_t reload = SYSTEM_TIMER_RELOAD(periodMs); // auto-reload value
+  
+  // no auto-reload preload: the new period applies to the running cycle, which
+  // started with the last update event
+  TIM2->ARR = reload;
+  
+  // a counter already beyond the new period would count up to 65535 first,
+  // the update event restarts the cycle and the interrupt follows at once
+  if(TIM2->CNT > reload) {
+    TIM2->EGR = TIM_EGR_UG;
+  }
+}
+
+//------------------------------------------------------------------------------
+void System_StopTimer(void)
+{
+  TIM2->CR1  = 0;
+  TIM2->DIER = 0;
+  NVIC_DisableIRQ(TIM2_IRQn);
+  timerHandler = 0;
+}
+
+//------------------------------------------------------------------------------
+void TIM2_IRQHandler(void)
+{
+  if(TIM2->SR & TIM_SR_UIF) {
+    TIM2->SR = ~TIM_SR_UIF;
+    if(timerHandler) {
+      timerHandler();
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+/* -- adapt this code for your platform -- */
+void System_InitStop(void)
+{
+  // access to the backup domain, which holds the LSE and the RTC
+  RCC->APB1ENR |= RCC_APB1ENR_PWREN | RCC_APB1ENR_BKPEN;
+  PWR->CR      |= PWR_CR_DBP;
+  
+  // start the LSE and clock the RTC with it
+  RCC->BDCR    |= RCC_BDCR_LSEON;
+  while(!(RCC->BDCR & RCC_BDCR_LSERDY));
+  RCC->BDCR    |= RCC_BDCR_RTCSEL_LSE | RCC_BDCR_RTCEN;
+  
+  // wait for the register synchronization after the RTC clock start
+  RTC->CRL &= ~RTC_CRL_RSF;
+  while(!(RTC->CRL & RTC_CRL_RSF));
+  
+  // RTC counter at 1024Hz
+  while(!(RTC->CRL & RTC_CRL_RTOFF));
+  RTC->CRL |= RTC_CRL_CNF;
+  RTC->PRLH = 0;
+  RTC->PRLL = LSE_HZ / RTC_TICK_HZ - 1;
+  RTC->CRL &= ~RTC_CRL_CNF;
+  while(!(RTC->CRL & RTC_CRL_RTOFF));
+  
+  // the RTC alarm wakes the controller from Stop mode by EXTI line 17
+  EXTI->IMR  |= EXTI_IMR_MR17;
+  EXTI->RTSR |= EXTI_RTSR_TR17;
+  NVIC_EnableIRQ(RTCAlarm_IRQn);
+}
+
+//------------------------------------------------------------------------------
+/* -- adapt this code for your platform -- */
+uint32_t System_StopMs(uint32_t ms)
+{
+  uint32_t start = RtcCounter(); // RTC counter before the Stop mode
+  uint32_t stopMs;               // time in Stop mode [ms]
+  
+  RtcSetAlarm(start + (ms * RTC_TICK_HZ + 999) / 1000);
+  
+  // Stop mode with the voltage regulator in low-power mode
+  PWR->CR   |= PWR_CR_LPDS;
+  PWR->CR   &= ~PWR_CR_PDDS;
+  SCB->SCR  |= SCB_SCR_SLEEPDEEP_Msk;
+  __WFI();
+  SCB->SCR  &= ~SCB_SCR_SLEEPDEEP_Msk;
+  
+  // the core runs from HSI after the wake-up, as configured by this sample,
+  // so no clock has to be restored. The RTC registers are valid again after
+  // a synchronization.
+  RTC->CRL &= ~RTC_CRL_RSF;
+  while(!(RTC->CRL & RTC_CRL_RSF));
+  
+  // SysTick was stopped, advance the system time by the stop time
+  stopMs  = ((RtcCounter() - start) * 1000) / RTC_TICK_HZ;
+  tickMs += stopMs;
+  
+  return stopMs;
+}
+
+//------------------------------------------------------------------------------
+void RTCAlarm_IRQHandler(void)
+{
+  EXTI->PR  = EXTI_PR_PR17;
+  RTC->CRL &= ~RTC_CRL_ALRF;
+}
+
+//------------------------------------------------------------------------------
+/* -- adapt this code for your platform -- */
+void System_InitUart(uint32_t baudrate)
+{
+  RCC->APB2ENR |= RCC_APB2ENR_IOPAEN | RCC_APB2ENR_USART1EN;
+  RCC->AHBENR  |= RCC_AHBENR_DMA1EN;
+  
+  // PA9 (TX): alternate function push-pull, 2MHz
+  GPIOA->CRH = (GPIOA->CRH & ~0x000000F0) | 0x000000A0;
+  
+  // USART1 on APB2 (8MHz): transmitter only, requests data by DMA
+  USART1->BRR = (uint16_t)((SYSTEM_CORE_CLOCK_HZ + baudrate / 2) / baudrate);
+  USART1->CR3 = USART_CR3_DMAT;
+  USART1->CR1 = USART_CR1_UE | USART_CR1_TE;
+  
+  // DMA1 channel 4 is the USART1_TX request
+  DMA1_Channel4->CCR  = 0;
+  DMA1_Channel4->CPAR = DMA_ADDRESS(&USART1->DR);
+  NVIC_EnableIRQ(DMA1_Channel4_IRQn);
+}
+
+//------------------------------------------------------------------------------
+void System_UartSend(const uint8_t data[], uint16_t size,
+                     tSystemUartHandler handler)
+{
+  uartHandler = handler;
+  
+  DMA1_Channel4->CCR   = 0;
+  DMA1->IFCR           = DMA_IFCR_CGIF4;
+  DMA1_Channel4->CMAR  = DMA_ADDRESS(data);
+  DMA1_Channel4->CNDTR = size;
+  DMA1_Channel4->CCR   = DMA_CCR4_MINC | DMA_CCR4_DIR | DMA_CCR4_TCIE |
+                         DMA_CCR4_EN;
+}
+
+//------------------------------------------------------------------------------
+void DMA1_Channel4_IRQHandler(void)
+{
+  if(DMA1->ISR & DMA_ISR_TCIF4) {
+    DMA1->IFCR         = DMA_IFCR_CTCIF4;
+    DMA1_Channel4->CCR = 0;
+    if(uartHandler) {
+      uartHandler();
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+void System_DelayUs(uint32_t nbrOfUs)
+{
+  uint32_t start  = DWT->CYCCNT;                   // cycle counter at start
+  uint32_t cycles = nbrOfUs * SYSTEM_CYCLES_PER_US; // delay in core cycles
+  
+  // unsigned difference is correct across a counter overflow
+  while((DWT->CYCCNT - start) < cycles);
+}
+
+//------------------------------------------------------------------------------
+static uint32_t RtcCounter(void)
+{
+  uint16_t high; // upper half of the counter
+  uint16_t low;  // lower half of the counter
+  
+  // read again if the lower half overflowed between the two reads
+  do {
+    high = RTC->CNTH;
+    low  = RTC->CNTL;
+  } while(high != RTC->CNTH);
+  
+  return ((uint32_t)high << 16) | low;
+}
+
+//------------------------------------------------------------------------------
+static void RtcSetAlarm(uint32_t alarm)
+{
+  while(!(RTC->CRL & RTC_CRL_RTOFF));
+  RTC->CRL |= RTC_CRL_CNF;
+  RTC->ALRH = (uint16_t)(alarm >> 16);
+  RTC->ALRL = (uint16_t)alarm;
+  RTC->CRL &= ~(RTC_CRL_CNF | RTC_CRL_ALRF);
+  while(!(RTC->CRL & RTC_CRL_RTOFF));
+  
+  EXTI->PR = EXTI_PR_PR17;
+}
@@ -1,43 +1,193 @@
-//==============================================================================
-// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
-//==============================================================================
-// Project   :  SHT85 Sample Code
-// File      :  system.h
-// Author    :  RFU
-// Date      :  17-Mai-2018
-// Controller:  STM32F100RB
-// IDE       :  Vision V5.25.2.0
-// Compiler  :  Armcc
-// Brief     :  System functions, global definitions
-//==============================================================================
-
-#ifndef SYSTEM_H
-#define SYSTEM_H
-
-#include <stdint.h>
-#include "stm32f10x.h" // controller register definitions
-
-// Error codes
-typedef enum{
-  NO_ERROR       = 0x00, // no error
-  ACK_ERROR      = 0x01, // no acknowledgment error
-  CHECKSUM_ERROR = 0x02, // checksum mismatch error
-  TIMEOUT_ERROR  = 0x04, // timeout error
-} etError;
-
-//==============================================================================
-void SystemInit(void);
-//==============================================================================
-// Initializes the system
-//------------------------------------------------------------------------------
-
-//==============================================================================
-void System_DelayUs(uint32_t nbrOfUs);
-//==============================================================================
-// Wait function for small delays.
-//------------------------------------------------------------------------------
-// input:  nbrOfUs   wait x times approx. one micro second (fcpu = 8MHz)
-// return: -
-// remark: smallest delay is approx. 15us due to function call
-
-#endif
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  system.h
+// Author    :  RFU
+// Date      :  17-Mai-2018
+// Controller:  STM32F100RB
+// IDE       :  µVision V5.25.2.0
+// Compiler  :  Armcc
+// Brief     :  System functions, global definitions
+//==============================================================================
+
+#ifndef SYSTEM_H
+#define SYSTEM_H
+
+#include <stdint.h>
+#include "stm32f10x.h" // controller register definitions
+
+// core clock, used for the SysTick tick and the delay functions
+/* -- adapt this to your clock configuration -- */
+#define SYSTEM_CORE_CLOCK_HZ  8000000 // HSI 8MHz, no PLL
+#define SYSTEM_CYCLES_PER_US  (SYSTEM_CORE_CLOCK_HZ / 1000000)
+
+// periodic timer (TIM2) tick: a period of 1ms is two ticks, the counter stops
+// at an auto-reload value of 0
+#define SYSTEM_TIMER_TICK_US  500
+#define SYSTEM_TIMER_RELOAD(periodMs) \
+  ((uint16_t)((uint32_t)(periodMs) * 1000 / SYSTEM_TIMER_TICK_US - 1))
+
+// GPIO port access, the host simulator replaces these with its bus model
+#ifndef GPIO_WRITE_BSRR
+  #define GPIO_WRITE_BSRR(port, value) ((port)->BSRR = (value))
+#endif
+#ifndef GPIO_READ_IDR
+  #define GPIO_READ_IDR(port)          ((port)->IDR)
+#endif
+
+// I2C1 register access of the peripheral backend and the address of a DMA
+// buffer, the host simulator replaces these with its I2C1 and DMA model
+#ifndef I2C_READ_REG
+  #define I2C_READ_REG(reg)         (I2C1->reg)
+#endif
+#ifndef I2C_WRITE_REG
+  #define I2C_WRITE_REG(reg, value) (I2C1->reg = (value))
+#endif
+#ifndef DMA_ADDRESS
+  #define DMA_ADDRESS(pointer)      ((uint32_t)(pointer))
+#endif
+
+// Error codes
+typedef enum{
+  NO_ERROR       = 0x00, // no error
+  ACK_ERROR      = 0x01, // no acknowledgment error
+  CHECKSUM_ERROR = 0x02, // checksum mismatch error
+  TIMEOUT_ERROR  = 0x04, // timeout error
+  BUSY_ERROR     = 0x08, // previous operation still in progress
+  RESET_ERROR    = 0x10, // unexpected reset of the sensor detected
+  PARM_ERROR     = 0x20, // parameter out of range
+} etError;
+
+// periodic timer interrupt handler
+typedef void (*tSystemTimerHandler)(void);
+
+// UART transmission complete handler
+typedef void (*tSystemUartHandler)(void);
+
+//==============================================================================
+void SystemInit(void);
+//==============================================================================
+// Initializes the system
+//------------------------------------------------------------------------------
+
+//==============================================================================
+uint32_t System_GetTickMs(void);
+//==============================================================================
+// Gets the system time, incremented every millisecond by the SysTick timer.
+//------------------------------------------------------------------------------
+// return: milliseconds since system start (wraps around after ~49 days)
+
+//==============================================================================
+void System_StartTimer(uint16_t periodMs, tSystemTimerHandler handler);
+//==============================================================================
+// Starts the periodic timer (TIM2), the handler is called from its interrupt.
+//------------------------------------------------------------------------------
+// input:  periodMs  interrupt period [ms], 1..32767
+//         handler   function called every period in interrupt context
+
+//==============================================================================
+void System_SetTimerPeriod(uint16_t periodMs);
+//==============================================================================
+// Changes the period of the running timer. Called from the handler, the next
+// interrupt follows periodMs after the current one, at once if this time has
+// already passed.
+//------------------------------------------------------------------------------
+// input:  periodMs  interrupt period [ms], 1..32767
+
+//==============================================================================
+void System_StopTimer(void);
+//==============================================================================
+// Stops the periodic timer.
+//------------------------------------------------------------------------------
+
+//==============================================================================
+void System_InitStop(void);
+//==============================================================================
+// Prepares the Stop mode: starts the LSE oscillator and the RTC, whose alarm
+// wakes the controller from Stop mode. Waits until the LSE runs.
+//------------------------------------------------------------------------------
+// remark: the LSE needs up to a few seconds to start after power on
+
+//==============================================================================
+uint32_t System_StopMs(uint32_t ms);
+//==============================================================================
+// Enters the Stop mode until the RTC alarm after the given time, or until an
+// other EXTI wake-up. All clocks except the LSE are stopped: SysTick, TIM2 and
+// the peripherals do not run. The system time is advanced by the stop time.
+//------------------------------------------------------------------------------
+// input:  ms        time in Stop mode [ms], resolution ~1ms (RTC 1024Hz)
+// return: time spent in Stop mode [ms]
+// remark: System_InitStop() has to be called before
+
+//==============================================================================
+void System_InitUart(uint32_t baudrate);
+//==============================================================================
+// Initializes USART1 for transmission (TX on PA9, 8N1), fed by DMA1 channel 4.
+//------------------------------------------------------------------------------
+// input:  baudrate  baud rate [bit/s]
+
+//==============================================================================
+void System_UartSend(const uint8_t data[], uint16_t size,
+                     tSystemUartHandler handler);
+//==============================================================================
+// Sends a block by DMA without waiting. The handler is called from the DMA
+// interrupt when all bytes have been passed to the UART; the block must not
+// be changed until then.
+//------------------------------------------------------------------------------
+// input:  data      bytes to send
+//         size      number of bytes, 1..65535
+//         handler   function called in interrupt context, may start the next
+//                   transmission
+// remark: System_InitUart() has to be called before
+
+//==============================================================================
+void System_DelayUs(uint32_t nbrOfUs);
+//==============================================================================
+// Wait function for small delays, timed by the DWT cycle counter.
+//------------------------------------------------------------------------------
+// input:  nbrOfUs   delay [us], max. 2^32 / SYSTEM_CYCLES_PER_US
+// return: -
+// remark: the delay is independent of compiler and optimization level, the
+//         function call adds approx. 1us at 8MHz
+
+//==============================================================================
+// void System_DelayNs(uint32_t nbrOfNs);
+//==============================================================================
+// Wait function for sub-microsecond delays, e.g. the I2C bit timing. Inline,
+// with a constant argument the cycle count is computed at compile time.
+//------------------------------------------------------------------------------
+// input:  nbrOfNs   delay [ns], rounded up to full core cycles, max. 1ms
+// return: -
+// remark: resolution is one core cycle (125ns at 8MHz), the loop adds a few
+//         cycles on top
+#ifdef DWT
+static __inline void System_DelayNs(uint32_t nbrOfNs)
+{
+  uint32_t start  = DWT->CYCCNT; // cycle counter at start
+  uint32_t cycles = (nbrOfNs * SYSTEM_CYCLES_PER_US + 999) / 1000;
+  
+  while((DWT->CYCCNT - start) < cycles);
+}
+#else
+// platform without cycle counter (host simulator) implements it as function
+void System_DelayNs(uint32_t nbrOfNs);
+#endif
+
+//==============================================================================
+// uint32_t System_GetCycles(void);
+//==============================================================================
+// Gets the DWT cycle counter, e.g. to measure the duration of a call.
+//------------------------------------------------------------------------------
+// return: core cycles since system start (wraps around after ~9min at 8MHz)
+#ifdef DWT
+static __inline uint32_t System_GetCycles(void)
+{
+  return DWT->CYCCNT;
+}
+#else
+// the host simulator counts the cycles of the simulated time
+uint32_t System_GetCycles(void);
+#endif
+
+#endif
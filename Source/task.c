@@ -0,0 +1,74 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  task.c
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  STM32F100RB
+// IDE       :  µVision V5.25.2.0
+// Compiler  :  Armcc
+// Brief     :  Cooperative task scheduler.
+//==============================================================================
+
+#include "task.h"
+
+static tTask* taskList; // started tasks, in start order
+
+//------------------------------------------------------------------------------
+void Task_Start(tTask* task, tTaskFunction function)
+{
+  tTask** link = &taskList; // link to the examined task
+  
+  task->function = function;
+  task->resume   = 0;
+  
+  // append the task, unless it is already running (restart)
+  while(*link && *link != task) {
+    link = &(*link)->next;
+  }
+  
+  if(*link == 0) {
+    task->next = 0;
+    *link = task;
+  }
+}
+
+//------------------------------------------------------------------------------
+void Task_Step(void)
+{
+  tTask**     link  = &taskList; // link to the running task
+  tTask*      task;              // running task
+  etTaskState state;             // state returned by the task
+  bool        ready = false;     // a task yielded and wants to run again
+  
+  while(*link) {
+    task  = *link;
+    state = task->function(task);
+    
+    if(state == TASK_ENDED) {
+      *link = task->next;
+      continue;
+    }
+    
+    if(state == TASK_YIELDED) {
+      ready = true;
+    }
+    
+    link = &task->next;
+  }
+  
+  // all tasks wait for a condition that only an interrupt can change (tick,
+  // sample, ...): sleep until the next interrupt
+  if(!ready) {
+    __WFI();
+  }
+}
+
+//------------------------------------------------------------------------------
+void Task_Run(void)
+{
+  while(1) {
+    Task_Step();
+  }
+}
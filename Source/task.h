@@ -0,0 +1,105 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  task.h
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  STM32F100RB
+// IDE       :  µVision V5.25.2.0
+// Compiler  :  Armcc
+// Brief     :  Cooperative tasks (protothreads): stackless tasks that wait
+//              for conditions and delays without blocking the controller.
+//              When all tasks wait, the controller sleeps until the next
+//              interrupt (SysTick, timer, ...).
+//
+//              A task is a function that is called again and again by the
+//              scheduler. The TASK_ macros store the line of a wait in the
+//              task and return; the next call jumps back to this line with a
+//              switch statement. Therefore:
+//                - local variables are lost at a wait, use static variables
+//                  or the task structure for values needed after a wait
+//                - no switch statement may enclose a TASK_ macro
+//                - only the task function itself can wait, not the functions
+//                  it calls
+//==============================================================================
+
+#ifndef TASK_H
+#define TASK_H
+
+#include "system.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// Task states returned by a task function
+typedef enum {
+  TASK_WAITING, // waits for a condition or the end of a delay
+  TASK_YIELDED, // ready, gives the other tasks a turn
+  TASK_ENDED,   // finished, removed from the scheduler
+} etTaskState;
+
+typedef struct sTask tTask;
+
+// Task function, has to be written with the TASK_ macros
+typedef etTaskState (*tTaskFunction)(tTask* task);
+
+// Task instance
+struct sTask {
+  tTaskFunction function; // task function
+  uint16_t      resume;   // line to resume at, 0 = beginning
+  uint32_t      wakeMs;   // end of a delay [ms]
+  tTask*        next;     // next task of the scheduler
+};
+
+// Begins the body of a task function.
+#define TASK_BEGIN(task)  switch((task)->resume) { case 0:
+
+// Ends the body of a task function, the task is removed from the scheduler.
+#define TASK_END(task)    } (task)->resume = 0; return TASK_ENDED
+
+// Waits until the condition is true. The condition is evaluated each time the
+// scheduler runs the task.
+#define TASK_WAIT_UNTIL(task, condition)                                       \
+  do {                                                                         \
+    (task)->resume = __LINE__; case __LINE__:                                  \
+    if(!(condition)) return TASK_WAITING;                                      \
+  } while(0)
+
+// Waits for a time [ms] without blocking the other tasks.
+#define TASK_DELAY_MS(task, ms)                                                \
+  do {                                                                         \
+    (task)->wakeMs = System_GetTickMs() + (ms);                                \
+    TASK_WAIT_UNTIL(task, (int32_t)(System_GetTickMs() - (task)->wakeMs) >= 0);\
+  } while(0)
+
+// Gives the other tasks a turn, the task continues in the next round.
+#define TASK_YIELD(task)                                                       \
+  do {                                                                         \
+    (task)->resume = __LINE__; return TASK_YIELDED; case __LINE__:;            \
+  } while(0)
+
+//==============================================================================
+// Starts a task, it runs from the beginning of its function with the next
+// round of the scheduler.
+//------------------------------------------------------------------------------
+// input: task          task instance
+//        function      task function
+//------------------------------------------------------------------------------
+void Task_Start(tTask* task, tTaskFunction function);
+
+
+//==============================================================================
+// Runs every task once, in start order. If no task yielded, the controller
+// sleeps until the next interrupt. A condition set by an interrupt after its
+// task has run, or by a task later in the order, is therefore seen at the
+// latest after the next SysTick (1ms).
+//------------------------------------------------------------------------------
+void Task_Step(void);
+
+
+//==============================================================================
+// Runs the scheduler forever.
+//------------------------------------------------------------------------------
+void Task_Run(void);
+
+#endif
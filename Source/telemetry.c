@@ -0,0 +1,193 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  telemetry.c
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  STM32F100RB
+// IDE       :  µVision V5.25.2.0
+// Compiler  :  Armcc
+// Brief     :  Binary telemetry over USART1 with a DMA double buffer.
+//==============================================================================
+
+#include "telemetry.h"
+#include <string.h>
+
+#define BUFFER_SIZE (TELEMETRY_RECORD_SIZE * TELEMETRY_BUFFER_RECORDS)
+
+#define CRC16_POLYNOMIAL 0x1021 // P(x) = x^16 + x^12 + x^5 + 1
+#define CRC16_INIT       0xFFFF
+
+static uint8_t           buffers[2][BUFFER_SIZE]; // DMA double buffer
+static volatile uint8_t  fill;      // index of the buffer being filled
+static volatile uint16_t fillCount; // bytes in the buffer being filled
+static volatile bool     sending;   // DMA transfer running
+static bool              lost;      // records dropped since the last write
+static tTelemetryStats   stats;     // statistics
+
+static bool     Queue(const uint8_t frame[], uint8_t size);
+static void     StartTransfer(void);
+static void     TransferDone(void);
+static void     PutUint16(uint8_t data[], uint16_t value);
+static void     PutUint32(uint8_t data[], uint32_t value);
+static void     PutCrc(uint8_t frame[], uint8_t size);
+static uint16_t CalcCrc16(const uint8_t data[], uint8_t nbrOfBytes);
+
+//------------------------------------------------------------------------------
+void Telemetry_Init(uint32_t baudrate)
+{
+  fill      = 0;
+  fillCount = 0;
+  sending   = false;
+  lost      = false;
+  
+  stats.records   = 0;
+  stats.dropped   = 0;
+  stats.transfers = 0;
+  
+  System_InitUart(baudrate);
+}
+
+//------------------------------------------------------------------------------
+bool Telemetry_Write(const tTelemetryRecord* record)
+{
+  uint8_t frame[TELEMETRY_RECORD_SIZE]; // encoded record
+  
+  frame[0] = TELEMETRY_SYNC_0;
+  frame[1] = TELEMETRY_SYNC_1;
+  PutUint32(&frame[2], record->timeMs);
+  frame[6] = record->sensorId;
+  frame[7] = (uint8_t)record->error | (lost ? TELEMETRY_STATUS_LOST : 0);
+  PutUint16(&frame[8], record->rawTemp);
+  PutUint16(&frame[10], record->rawHumi);
+  PutCrc(frame, TELEMETRY_RECORD_SIZE);
+  
+  return Queue(frame, TELEMETRY_RECORD_SIZE);
+}
+
+//------------------------------------------------------------------------------
+bool Telemetry_WriteSummary(uint8_t sensorId,
+                            const tAggregateSummary* summary)
+{
+  uint8_t frame[TELEMETRY_SUMMARY_SIZE]; // encoded summary
+  
+  frame[0]  = TELEMETRY_SYNC_0;
+  frame[1]  = TELEMETRY_SYNC_SUMMARY;
+  PutUint32(&frame[2], summary->startMs);
+  PutUint32(&frame[6], summary->endMs);
+  frame[10] = sensorId;
+  frame[11] = lost ? TELEMETRY_STATUS_LOST : 0;
+  PutUint16(&frame[12], summary->count);
+  PutUint16(&frame[14], (uint16_t)summary->temperature.min);
+  PutUint16(&frame[16], (uint16_t)summary->temperature.max);
+  PutUint16(&frame[18], (uint16_t)summary->temperature.mean);
+  PutUint32(&frame[20], summary->temperature.variance);
+  PutUint16(&frame[24], (uint16_t)summary->humidity.min);
+  PutUint16(&frame[26], (uint16_t)summary->humidity.max);
+  PutUint16(&frame[28], (uint16_t)summary->humidity.mean);
+  PutUint32(&frame[30], summary->humidity.variance);
+  PutCrc(frame, TELEMETRY_SUMMARY_SIZE);
+  
+  return Queue(frame, TELEMETRY_SUMMARY_SIZE);
+}
+
+//------------------------------------------------------------------------------
+const tTelemetryStats* Telemetry_GetStats(void)
+{
+  return &stats;
+}
+
+//------------------------------------------------------------------------------
+static bool Queue(const uint8_t frame[], uint8_t size)
+{
+  bool queued; // frame fits into the buffer
+  
+  // the DMA interrupt swaps the buffers: append and start under lock
+  __disable_irq();
+  queued = (fillCount + size <= BUFFER_SIZE);
+  if(queued) {
+    memcpy(&buffers[fill][fillCount], frame, size);
+    fillCount += size;
+    if(!sending) {
+      StartTransfer();
+    }
+  }
+  __enable_irq();
+  
+  if(queued) {
+    stats.records++;
+    lost = false;
+  } else {
+    stats.dropped++;
+    lost = true;
+  }
+  
+  return queued;
+}
+
+//------------------------------------------------------------------------------
+static void StartTransfer(void)
+{
+  // send the filled buffer, fill the other one meanwhile
+  sending = true;
+  stats.transfers++;
+  System_UartSend(buffers[fill], fillCount, TransferDone);
+  fill     ^= 1;
+  fillCount = 0;
+}
+
+//------------------------------------------------------------------------------
+static void TransferDone(void)
+{
+  // DMA interrupt: continue with the records written meanwhile
+  if(fillCount > 0) {
+    StartTransfer();
+  } else {
+    sending = false;
+  }
+}
+
+//------------------------------------------------------------------------------
+static void PutUint16(uint8_t data[], uint16_t value)
+{
+  // little endian
+  data[0] = (uint8_t)value;
+  data[1] = (uint8_t)(value >> 8);
+}
+
+//------------------------------------------------------------------------------
+static void PutUint32(uint8_t data[], uint32_t value)
+{
+  PutUint16(&data[0], (uint16_t)value);
+  PutUint16(&data[2], (uint16_t)(value >> 16));
+}
+
+//------------------------------------------------------------------------------
+static void PutCrc(uint8_t frame[], uint8_t size)
+{
+  // checksum of everything between the sync bytes and the checksum
+  PutUint16(&frame[size - 2], CalcCrc16(&frame[2], size - 4));
+}
+
+//------------------------------------------------------------------------------
+static uint16_t CalcCrc16(const uint8_t data[], uint8_t nbrOfBytes)
+{
+  uint8_t  bit;                 // bit mask
+  uint16_t crc = CRC16_INIT;    // calculated checksum
+  uint8_t  byteCtr;             // byte counter
+  
+  // calculates 16-Bit checksum with given polynomial
+  for(byteCtr = 0; byteCtr < nbrOfBytes; byteCtr++) {
+    crc ^= (uint16_t)data[byteCtr] << 8;
+    for(bit = 8; bit > 0; --bit) {
+      if(crc & 0x8000) {
+        crc = (uint16_t)((crc << 1) ^ CRC16_POLYNOMIAL);
+      } else {
+        crc = (uint16_t)(crc << 1);
+      }
+    }
+  }
+  
+  return crc;
+}
@@ -0,0 +1,118 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  telemetry.h
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  STM32F100RB
+// IDE       :  µVision V5.25.2.0
+// Compiler  :  Armcc
+// Brief     :  Binary telemetry: streams the samples or window summaries as
+//              framed records over USART1. The records are collected in one
+//              buffer while the DMA sends the other one (double buffer), so
+//              writing a record never waits for the UART. If both buffers are
+//              full, the record is dropped and the next written record is
+//              marked.
+//
+//              Record frame, 14 bytes, multi-byte values little endian:
+//                 0  sync 0xA5
+//                 1  sync 0x5A
+//                 2  timestamp [ms], uint32
+//                 6  sensor id
+//                 7  status: error code of the sample (etError),
+//                    bit 7: records were lost before this one
+//                 8  raw temperature, uint16
+//                10  raw humidity, uint16
+//                12  CRC-16/CCITT (0x1021, init 0xFFFF) of the bytes 2..11
+//
+//              Summary frame (aggregate.h), 36 bytes:
+//                 0  sync 0xA5
+//                 1  sync 0x5B
+//                 2  time of the first sample [ms], uint32
+//                 6  time of the last sample [ms], uint32
+//                10  sensor id
+//                11  status: bit 7: records were lost before this one
+//                12  number of samples, uint16
+//                14  temperature min, max, mean [0.01°C], int16 each
+//                20  temperature variance [0.0001°C^2], uint32
+//                24  humidity min, max, mean [0.01%RH], int16 each
+//                30  humidity variance [0.0001%RH^2], uint32
+//                34  CRC-16/CCITT of the bytes 2..33
+//
+//              Tools/sht85_decode converts the stream to CSV.
+//==============================================================================
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include "aggregate.h"
+#include "system.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#define TELEMETRY_BAUDRATE       115200 // default baud rate [bit/s]
+#define TELEMETRY_RECORD_SIZE        14 // bytes per record frame
+#define TELEMETRY_SUMMARY_SIZE       36 // bytes per summary frame
+#define TELEMETRY_BUFFER_RECORDS     16 // records per DMA buffer
+
+#define TELEMETRY_SYNC_0           0xA5 // first sync byte of a frame
+#define TELEMETRY_SYNC_1           0x5A // second sync byte of a record
+#define TELEMETRY_SYNC_SUMMARY     0x5B // second sync byte of a summary
+#define TELEMETRY_STATUS_LOST      0x80 // status: records lost before
+
+// Telemetry record
+typedef struct {
+  uint32_t timeMs;   // timestamp [ms]
+  uint8_t  sensorId; // sensor id, defined by the application
+  etError  error;    // error code of the sample, NO_ERROR = valid values
+  uint16_t rawTemp;  // raw temperature
+  uint16_t rawHumi;  // raw relative humidity
+} tTelemetryRecord;
+
+// Telemetry statistics
+typedef struct {
+  uint32_t records;   // records and summaries passed to the DMA
+  uint32_t dropped;   // records lost, both buffers were full
+  uint32_t transfers; // started DMA transfers
+} tTelemetryStats;
+
+//==============================================================================
+// Initializes the UART and the buffers.
+//------------------------------------------------------------------------------
+// input: baudrate      baud rate [bit/s], e.g. TELEMETRY_BAUDRATE
+//------------------------------------------------------------------------------
+void Telemetry_Init(uint32_t baudrate);
+
+
+//==============================================================================
+// Writes a record without waiting. The record is sent with the next DMA
+// transfer, which starts at once if the UART is idle.
+//------------------------------------------------------------------------------
+// input: record        record to send
+//
+// return: true = record queued, false = dropped (buffers full)
+//------------------------------------------------------------------------------
+bool Telemetry_Write(const tTelemetryRecord* record);
+
+
+//==============================================================================
+// Writes a window summary without waiting, as Telemetry_Write().
+//------------------------------------------------------------------------------
+// input: sensorId      sensor id, defined by the application
+//        summary       window summary to send
+//
+// return: true = summary queued, false = dropped (buffers full)
+//------------------------------------------------------------------------------
+bool Telemetry_WriteSummary(uint8_t sensorId,
+                            const tAggregateSummary* summary);
+
+
+//==============================================================================
+// Gets the telemetry statistics.
+//------------------------------------------------------------------------------
+// return: statistics since Telemetry_Init()
+//------------------------------------------------------------------------------
+const tTelemetryStats* Telemetry_GetStats(void);
+
+#endif
@@ -0,0 +1,311 @@
+//==============================================================================
+// S E N S I R I O N   AG,  Laubisruetistr. 50, CH-8712 Staefa, Switzerland
+//==============================================================================
+// Project   :  SHT85 Sample Code
+// File      :  sht85_decode.c
+// Author    :  RFU
+// Date      :  17-Okt-2026
+// Controller:  Host (Linux)
+// Compiler  :  GCC
+// Brief     :  Decodes the binary telemetry stream (Source/telemetry.h) from a
+//              file, a pipe or a serial port / pty and writes it as CSV to
+//              stdout:
+//                time_ms,sensor,status,temperature_c,humidity_rh
+//              Window summaries are written to the file given with -w:
+//                start_ms,end_ms,sensor,status,count,t_min,t_max,t_mean,
+//                t_var,rh_min,rh_max,rh_mean,rh_var
+//              Frames with a wrong checksum are skipped, the decoder
+//              resynchronizes on the next sync bytes. The decoder statistics
+//              go to stderr.
+//
+//              sht85_decode [-b baudrate] [-w summaries.csv] [input]
+//==============================================================================
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+
+// record and summary frame, see Source/telemetry.h
+#define RECORD_SIZE      14
+#define SUMMARY_SIZE     36
+#define SYNC_0           0xA5
+#define SYNC_1           0x5A
+#define SYNC_SUMMARY     0x5B
+#define STATUS_LOST      0x80
+#define STATUS_ERROR     0x7F
+
+#define CRC16_POLYNOMIAL 0x1021
+#define CRC16_INIT       0xFFFF
+
+#define READ_SIZE        65536 // bytes per read from the input
+#define MAX_FRAME_SIZE   SUMMARY_SIZE
+
+// decoder statistics
+typedef struct {
+  unsigned long records;    // valid records
+  unsigned long summaries;  // valid summaries
+  unsigned long errors;     // records with an error code
+  unsigned long lost;       // records marked with lost records before
+  unsigned long crcErrors;  // frames with a checksum mismatch
+  unsigned long skipped;    // bytes skipped while searching the sync
+} tDecodeStats;
+
+static uint16_t crcTable[256]; // CRC-16/CCITT, one entry per byte value
+
+static void     InitCrcTable(void);
+static uint16_t CalcCrc16(const uint8_t data[], size_t nbrOfBytes);
+static size_t   Decode(const uint8_t data[], size_t size, FILE* summaries,
+                       tDecodeStats* stats);
+static void     WriteRecord(const uint8_t frame[RECORD_SIZE]);
+static void     WriteSummary(const uint8_t frame[SUMMARY_SIZE], FILE* file);
+static int16_t  GetInt16(const uint8_t data[]);
+static uint32_t GetUint32(const uint8_t data[]);
+static void     PrintCenti(FILE* file, int32_t value);
+static speed_t  BaudrateToSpeed(long baudrate);
+
+//------------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  static uint8_t data[MAX_FRAME_SIZE + READ_SIZE]; // undecoded rest and data
+  static char    output[1 << 16];                  // stdout buffer
+  tDecodeStats   stats = {0};                      // decoder statistics
+  struct termios tty;                              // serial port settings
+  long           baudrate = 115200;                // baud rate of a serial port
+  size_t         size = 0;                         // bytes in the data buffer
+  size_t         used;                             // decoded bytes
+  ssize_t        nbrOfRead;                        // bytes read
+  int            fd = STDIN_FILENO;                // input
+  FILE*          summaries = 0;                    // summary output, optional
+  int            interactive;                      // input is a terminal
+  int            opt;                              // option character
+
+  while((opt = getopt(argc, argv, "b:w:h")) != -1) {
+    if(opt == 'b') {
+      baudrate = strtol(optarg, 0, 10);
+    } else if(opt == 'w') {
+      summaries = fopen(optarg, "w");
+      if(summaries == 0) {
+        perror(optarg);
+        return 1;
+      }
+      fprintf(summaries, "start_ms,end_ms,sensor,status,count,t_min,t_max,"
+              "t_mean,t_var,rh_min,rh_max,rh_mean,rh_var\n");
+    } else {
+      fprintf(stderr, "usage: %s [-b baudrate] [-w summaries.csv] [input]\n",
+              argv[0]);
+      return opt == 'h' ? 0 : 2;
+    }
+  }
+
+  if(optind < argc) {
+    fd = open(argv[optind], O_RDONLY | O_NOCTTY);
+    if(fd < 0) {
+      perror(argv[optind]);
+      return 1;
+    }
+  }
+
+  // serial port or pty: raw bytes at the given baud rate, lines flushed as
+  // they arrive
+  interactive = isatty(fd);
+  if(interactive && tcgetattr(fd, &tty) == 0) {
+    cfmakeraw(&tty);
+    cfsetispeed(&tty, BaudrateToSpeed(baudrate));
+    tcsetattr(fd, TCSANOW, &tty);
+  }
+
+  setvbuf(stdout, output, _IOFBF, sizeof(output));
+  InitCrcTable();
+  printf("time_ms,sensor,status,temperature_c,humidity_rh\n");
+
+  while((nbrOfRead = read(fd, &data[size], READ_SIZE)) > 0) {
+    size += (size_t)nbrOfRead;
+    used  = Decode(data, size, summaries, &stats);
+
+    // keep an incomplete frame for the next read
+    memmove(data, &data[used], size - used);
+    size -= used;
+
+    if(interactive) {
+      fflush(stdout);
+      if(summaries) fflush(summaries);
+    }
+  }
+
+  fflush(stdout);
+  if(summaries) fclose(summaries);
+  fprintf(stderr, "%lu records, %lu summaries, %lu with error, "
+          "%lu after lost records, %lu checksum errors, %lu bytes skipped\n",
+          stats.records, stats.summaries, stats.errors, stats.lost,
+          stats.crcErrors, stats.skipped);
+
+  return nbrOfRead < 0 ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+static void InitCrcTable(void)
+{
+  uint16_t crc; // checksum of one byte
+  int      i;   // byte value
+  int      bit; // bit counter
+
+  for(i = 0; i < 256; i++) {
+    crc = (uint16_t)(i << 8);
+    for(bit = 0; bit < 8; bit++) {
+      crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ CRC16_POLYNOMIAL)
+                           : (uint16_t)(crc << 1);
+    }
+    crcTable[i] = crc;
+  }
+}
+
+//------------------------------------------------------------------------------
+static uint16_t CalcCrc16(const uint8_t data[], size_t nbrOfBytes)
+{
+  uint16_t crc = CRC16_INIT; // calculated checksum
+  size_t   i;                // byte index
+
+  for(i = 0; i < nbrOfBytes; i++) {
+    crc = (uint16_t)((crc << 8) ^ crcTable[(crc >> 8) ^ data[i]]);
+  }
+
+  return crc;
+}
+
+//------------------------------------------------------------------------------
+static size_t Decode(const uint8_t data[], size_t size, FILE* summaries,
+                     tDecodeStats* stats)
+{
+  size_t   pos = 0;   // position in the data
+  size_t   frameSize; // size of the frame at the position
+  uint16_t crc;       // received checksum
+  uint8_t  status;    // status byte of the frame
+
+  while(size - pos >= 2) {
+    // search the sync, a checksum mismatch resynchronizes one byte later
+    if(data[pos] != SYNC_0 ||
+       (data[pos + 1] != SYNC_1 && data[pos + 1] != SYNC_SUMMARY)) {
+      pos++;
+      stats->skipped++;
+      continue;
+    }
+
+    frameSize = (data[pos + 1] == SYNC_1) ? RECORD_SIZE : SUMMARY_SIZE;
+    if(size - pos < frameSize) {
+      break;
+    }
+
+    crc = (uint16_t)(data[pos + frameSize - 2] |
+                     (data[pos + frameSize - 1] << 8));
+    if(CalcCrc16(&data[pos + 2], frameSize - 4) != crc) {
+      pos++;
+      stats->crcErrors++;
+      continue;
+    }
+
+    if(frameSize == RECORD_SIZE) {
+      status = data[pos + 7];
+      stats->records++;
+      if(status & STATUS_ERROR) stats->errors++;
+      WriteRecord(&data[pos]);
+    } else {
+      status = data[pos + 11];
+      stats->summaries++;
+      if(summaries) WriteSummary(&data[pos], summaries);
+    }
+    if(status & STATUS_LOST) stats->lost++;
+    pos += frameSize;
+  }
+
+  return pos;
+}
+
+//------------------------------------------------------------------------------
+static void WriteRecord(const uint8_t frame[RECORD_SIZE])
+{
+  uint32_t timeMs  = GetUint32(&frame[2]);
+  uint16_t rawTemp = (uint16_t)(frame[8] | (frame[9] << 8));
+  uint16_t rawHumi = (uint16_t)(frame[10] | (frame[11] << 8));
+  uint32_t product;     // raw value times full scale
+  int32_t  temperature; // temperature [0.01°C]
+  uint32_t humidity;    // relative humidity [0.01%RH]
+
+  // no values with an error code
+  if(frame[7] & STATUS_ERROR) {
+    printf("%u,%u,0x%02X,,\n", timeMs, frame[6], frame[7]);
+    return;
+  }
+
+  // integer conversion as SHT85_CalcTemperatureCenti/HumidityCenti()
+  product     = (uint32_t)rawTemp * 17500;
+  temperature = (int32_t)((product + (product >> 16) + 0x8000) >> 16) - 4500;
+  product     = (uint32_t)rawHumi * 10000;
+  humidity    = (product + (product >> 16) + 0x8000) >> 16;
+
+  printf("%u,%u,0x%02X,", timeMs, frame[6], frame[7]);
+  PrintCenti(stdout, temperature);
+  printf(",%u.%02u\n", humidity / 100, humidity % 100);
+}
+
+//------------------------------------------------------------------------------
+static void WriteSummary(const uint8_t frame[SUMMARY_SIZE], FILE* file)
+{
+  uint8_t i; // quantity: temperature, humidity
+
+  fprintf(file, "%u,%u,%u,0x%02X,%u", GetUint32(&frame[2]),
+          GetUint32(&frame[6]), frame[10], frame[11],
+          (unsigned)(frame[12] | (frame[13] << 8)));
+
+  // min, max, mean [0.01 unit] and variance [0.0001 unit^2]
+  for(i = 0; i < 2; i++) {
+    fputc(',', file);
+    PrintCenti(file, GetInt16(&frame[14 + i * 10]));
+    fputc(',', file);
+    PrintCenti(file, GetInt16(&frame[16 + i * 10]));
+    fputc(',', file);
+    PrintCenti(file, GetInt16(&frame[18 + i * 10]));
+    fprintf(file, ",%u.%04u", GetUint32(&frame[20 + i * 10]) / 10000,
+            GetUint32(&frame[20 + i * 10]) % 10000);
+  }
+  fputc('\n', file);
+}
+
+//------------------------------------------------------------------------------
+static int16_t GetInt16(const uint8_t data[])
+{
+  return (int16_t)(data[0] | (data[1] << 8));
+}
+
+//------------------------------------------------------------------------------
+static uint32_t GetUint32(const uint8_t data[])
+{
+  return (uint32_t)data[0] | ((uint32_t)data[1] << 8) |
+         ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+//------------------------------------------------------------------------------
+static void PrintCenti(FILE* file, int32_t value)
+{
+  // fixed point with two decimals, also for -0.99..-0.01
+  fprintf(file, "%s%d.%02d", value < 0 ? "-" : "", abs(value) / 100,
+          abs(value) % 100);
+}
+
+//------------------------------------------------------------------------------
+static speed_t BaudrateToSpeed(long baudrate)
+{
+  switch(baudrate) {
+    case 9600:   return B9600;
+    case 19200:  return B19200;
+    case 38400:  return B38400;
+    case 57600:  return B57600;
+    case 230400: return B230400;
+    case 460800: return B460800;
+    case 921600: return B921600;
+    default:     return B115200;
+  }
+}
@@ -0,0 +1,98 @@
+# Size and stack usage per function of an executable, run after the link:
+#   cmake -DELF=<executable> -DNM=<nm> -DSTACK_DIRS=<dir>[,<dir>...]
+#         -DREPORT=<output file> -P size_report.cmake
+# sizes from nm, stack usage from the .su files of -fstack-usage found in
+# STACK_DIRS and next to the executable (link time optimization)
+
+cmake_minimum_required(VERSION 3.10)
+
+execute_process(COMMAND ${NM} --print-size --size-sort --radix=d ${ELF}
+                OUTPUT_VARIABLE symbols RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "${NM} failed on ${ELF}")
+endif()
+
+# stack usage [bytes] and qualifiers per function
+string(REPLACE "," ";" STACK_DIRS "${STACK_DIRS}")
+get_filename_component(elfDir ${ELF} DIRECTORY)
+get_filename_component(elfName ${ELF} NAME)
+set(suFiles)
+foreach(dir ${STACK_DIRS})
+  file(GLOB_RECURSE files ${dir}/*.su)
+  list(APPEND suFiles ${files})
+endforeach()
+file(GLOB files ${elfDir}/${elfName}.ltrans*.su)
+list(APPEND suFiles ${files})
+
+foreach(suFile ${suFiles})
+  file(STRINGS ${suFile} lines)
+  foreach(line ${lines})
+    if(line MATCHES "^.*:([^:\t]+)\t([0-9]+)\t(.*)$")
+      set(stack_${CMAKE_MATCH_1} "${CMAKE_MATCH_2} ${CMAKE_MATCH_3}")
+    endif()
+  endforeach()
+endforeach()
+
+# one line per symbol, largest first; t = code, r = constant data (flash),
+# d = initialized data (flash and RAM), b = uninitialized data (RAM)
+string(REPLACE "\n" ";" symbols "${symbols}")
+list(REVERSE symbols)
+set(codeBytes 0)
+set(constBytes 0)
+set(dataBytes 0)
+set(bssBytes 0)
+set(maxStack 0)
+set(maxStackName "-")
+set(report "")
+set(spaces "                                        ")
+foreach(symbol ${symbols})
+  if(NOT symbol MATCHES "^[0-9]+ ([0-9]+) ([A-Za-z]) (.+)$")
+    continue()
+  endif()
+  set(size ${CMAKE_MATCH_1})
+  string(TOLOWER ${CMAKE_MATCH_2} type)
+  set(name ${CMAKE_MATCH_3})
+  string(REGEX MATCH "[1-9][0-9]*$|0$" size ${size})
+
+  if(type STREQUAL "t")
+    math(EXPR codeBytes "${codeBytes} + ${size}")
+  elseif(type STREQUAL "r")
+    math(EXPR constBytes "${constBytes} + ${size}")
+  elseif(type STREQUAL "d")
+    math(EXPR dataBytes "${dataBytes} + ${size}")
+  elseif(type STREQUAL "b")
+    math(EXPR bssBytes "${bssBytes} + ${size}")
+  else()
+    continue()
+  endif()
+
+  set(stack "")
+  if(DEFINED stack_${name})
+    set(stack "${stack_${name}}")
+    string(REGEX MATCH "^[0-9]+" stackBytes "${stack}")
+    if(stackBytes GREATER maxStack)
+      set(maxStack ${stackBytes})
+      set(maxStackName ${name})
+    endif()
+  endif()
+
+  string(LENGTH "${size}" length)
+  math(EXPR pad "8 - ${length}")
+  string(SUBSTRING "${spaces}" 0 ${pad} padding)
+  string(LENGTH "${name}" length)
+  math(EXPR namePad "40 - ${length}")
+  if(namePad LESS 1)
+    set(namePad 1)
+  endif()
+  string(SUBSTRING "${spaces}" 0 ${namePad} namePadding)
+  string(APPEND report "${padding}${size} ${type} ${name}${namePadding}${stack}\n")
+endforeach()
+
+file(WRITE ${REPORT}
+  "${elfName}: code ${codeBytes}, constants ${constBytes}, "
+  "data ${dataBytes}, bss ${bssBytes} bytes\n"
+  "largest stack frame: ${maxStackName} ${maxStack} bytes\n\n"
+  "    size t symbol                                  stack [bytes]\n"
+  "${report}")
+message(STATUS "${elfName}: code ${codeBytes}, constants ${constBytes}, "
+        "data ${dataBytes}, bss ${bssBytes} bytes, size report ${REPORT}")